@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: BSD-3-Clause
+#include <cmath>
+#include <cstdint>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <array>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "numeric.hxx"
+
+/*!
+ * @file
+ * @author Rachel Mant
+ * @date 2026
+ * @brief Microbenchmark comparing the numeric decoding layer against the conversions it replaced
+ */
+
+using tmplORM::numeric::parseUint;
+using tmplORM::numeric::parseFloat;
+using tmplORM::numeric::parseDouble;
+using clock_t_ = std::chrono::steady_clock;
+
+// A copy of the per-digit, divide to check for overflow conversion mySQLValue_t used to use
+bool referenceParseUint(const char *const data, const size_t len, uint64_t &value) noexcept
+{
+	uint64_t preNum = 0;
+	uint64_t num = 0;
+	for (size_t i = 0; i < len; ++i)
+	{
+		if (data[i] < '0' || data[i] > '9')
+			return false;
+		num *= 10U;
+		if ((num / 10U) < preNum)
+			return false;
+		preNum = num;
+		num += static_cast<uint64_t>(data[i] - '0');
+	}
+	value = num;
+	return num >= preNum;
+}
+
+bool referenceParseFloat(const char *const data, const size_t, float &value) noexcept
+{
+	value = strtof(data, nullptr);
+	return true;
+}
+
+bool referenceParseDouble(const char *const data, const size_t, double &value) noexcept
+{
+	value = strtod(data, nullptr);
+	return true;
+}
+
+template<typename T, typename function_t> double benchmark(const std::vector<std::string> &inputs,
+	const size_t rounds, function_t parse, T &checksum)
+{
+	const auto start = clock_t_::now();
+	for (size_t round = 0; round < rounds; ++round)
+	{
+		for (const auto &input : inputs)
+		{
+			T value{};
+			if (parse(input.data(), input.size(), value))
+				checksum += value;
+		}
+	}
+	const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t_::now() - start);
+	return double(duration.count()) / double(inputs.size() * rounds);
+}
+
+template<typename T, typename reference_t, typename function_t> void compare(const char *const name,
+	const std::vector<std::string> &inputs, const size_t rounds, reference_t reference, function_t function)
+{
+	T referenceSum{};
+	T functionSum{};
+	const double referenceTime = benchmark(inputs, rounds, reference, referenceSum);
+	const double functionTime = benchmark(inputs, rounds, function, functionSum);
+	printf("%-8s reference: %7.2fns/value, numeric: %7.2fns/value, speedup: %5.2fx%s\n", name, referenceTime,
+		functionTime, referenceTime / functionTime, referenceSum == functionSum ? "" : " (results differ!)");
+}
+
+int main(int argc, char **argv)
+{
+	const size_t count = 100000;
+	const size_t rounds = argc > 1 ? size_t(strtoul(argv[1], nullptr, 10)) : 20U;
+	std::mt19937_64 rng{0x746D706C4F524DU};
+	std::vector<std::string> integers{};
+	std::vector<std::string> floats{};
+	std::vector<std::string> doubles{};
+	integers.reserve(count);
+	floats.reserve(count);
+	doubles.reserve(count);
+
+	std::array<char, 64> buffer{};
+	for (size_t i = 0; i < count; ++i)
+	{
+		// Pick a random number of digits so short values are as common as long ones
+		const uint64_t integer = rng() >> (rng() % 64U);
+		snprintf(buffer.data(), buffer.size(), "%" PRIu64, integer);
+		integers.emplace_back(buffer.data());
+
+		const auto bits = uint32_t(rng());
+		float floatValue{};
+		memcpy(&floatValue, &bits, sizeof(float));
+		if (!std::isfinite(floatValue))
+			floatValue = 0.0F;
+		// Matches how MySQL formats FLOAT columns in the text protocol
+		snprintf(buffer.data(), buffer.size(), "%.6g", double(floatValue));
+		floats.emplace_back(buffer.data());
+
+		const double doubleValue = double(int64_t(rng() % 2000000000U) - 1000000000) / double(rng() % 10000U + 1U);
+		snprintf(buffer.data(), buffer.size(), "%.17g", doubleValue);
+		doubles.emplace_back(buffer.data());
+	}
+
+	compare<uint64_t>("integer", integers, rounds, referenceParseUint, parseUint);
+	compare<float>("float", floats, rounds, referenceParseFloat, parseFloat);
+	compare<double>("double", doubles, rounds, referenceParseDouble, parseDouble);
+	return 0;
+}
@@ -3,6 +3,10 @@
 #else
 #include <io.h>
 #endif
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 #define UNICODE
 #include <sql.h>
 #include <sqlext.h>
@@ -26,6 +30,15 @@
 using substrate::vectorStateException_t;
 using namespace tmplORM::mssql::driver;
 
+static_assert(std::is_same<sql_len_t, SQLLEN>::value, "sql_len_t is not the same type as SQLLEN");
+static_assert(std::is_same<sql_ulen_t, SQLULEN>::value, "sql_ulen_t is not the same type as SQLULEN");
+
+// The most rows a result fetches per SQLFetch(), and roughly how much memory it may use to do so
+constexpr static uint32_t maxBlockRows{256};
+constexpr static size_t maxBlockLength{262144};
+// How much of a (MAX) column's value to try reading in one go when fetching a row at a time
+constexpr static size_t firstChunkLength{8192};
+
 inline tSQLExecErrorType_t translateError(const SQLRETURN result) noexcept
 {
 	if (result == SQL_NEED_DATA)
@@ -80,6 +93,30 @@ inline int16_t odbcToCType(const int16_t typeODBC) noexcept
 	return typeODBC;
 }
 
+/*!
+ * @internal
+ * @brief Closes any cursor a previous execution left open on a statement and drops the columns its
+ *     result bound for block fetching, so the statement can be executed afresh
+ */
+inline void closeStatement(void *const handle) noexcept
+{
+	SQLFreeStmt(handle, SQL_CLOSE);
+	SQLFreeStmt(handle, SQL_UNBIND);
+	SQLSetStmtAttr(handle, SQL_ATTR_ROW_ARRAY_SIZE, reinterpret_cast<void *>(1), 0); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	SQLSetStmtAttr(handle, SQL_ATTR_ROWS_FETCHED_PTR, nullptr, 0);
+}
+
+// Frees the statement handle it holds once the last of an uncached query and its results let go of it
+struct statementOwner_t final
+{
+	void *const handle;
+
+	statementOwner_t(void *const _handle) noexcept : handle{_handle} { }
+	~statementOwner_t() noexcept { SQLFreeHandle(SQL_HANDLE_STMT, handle); }
+	statementOwner_t(const statementOwner_t &) = delete;
+	statementOwner_t &operator =(const statementOwner_t &) = delete;
+};
+
 tSQLClient_t::tSQLClient_t() noexcept : dbHandle(nullptr), connection(nullptr), haveConnection(false), needsCommit(false), _error()
 {
 	if (SQLAllocHandle(SQL_HANDLE_ENV, nullptr, &dbHandle) != SQL_SUCCESS || !dbHandle)
@@ -104,6 +141,7 @@ void tSQLClient_t::operator =(tSQLClient_t &&con) noexcept
 	std::swap(haveConnection, con.haveConnection);
 	std::swap(needsCommit, con.needsCommit);
 	std::swap(_error, con._error);
+	cachedQueries.swap(con.cachedQueries);
 }
 
 void tSQLClient_t::disconnect() const noexcept
@@ -112,6 +150,10 @@ void tSQLClient_t::disconnect() const noexcept
 	{
 		if (needsCommit)
 			rollback();
+		// Statements only live as long as the connection they were allocated on
+		for (const auto &cachedQuery : cachedQueries)
+			SQLFreeHandle(SQL_HANDLE_STMT, cachedQuery.handle);
+		cachedQueries.clear();
 		haveConnection = error(SQLDisconnect(connection), SQL_HANDLE_DBC, connection);
 	}
 }
@@ -144,27 +186,139 @@ bool tSQLClient_t::selectDB(const char *const db) const noexcept
 		return false;
 	auto odbcString = utf16::convert(db);
 	auto odbcStringLen = utf16::length(odbcString);
-	if (odbcStringLen > std::numeric_limits<SQLINTEGER>::max())
-		return false;
-	return !error(SQLSetConnectAttr(
+	if (odbcStringLen > std::numeric_limits<SQLINTEGER>::max() ||
+		error(SQLSetConnectAttr(
 			connection, SQL_ATTR_CURRENT_CATALOG, odbcString, static_cast<SQLINTEGER>(utf16::length(odbcString) * 2)
-		), SQL_HANDLE_DBC, connection);
+		), SQL_HANDLE_DBC, connection))
+		return false;
+	// Statements prepared against the old database must not be handed out again for this one
+	dropCachedQueries();
+	return true;
 }
 
-tSQLQuery_t tSQLClient_t::prepare(const char *const queryStmt, const size_t paramsCount) const noexcept
+/*! @internal @brief Allocates a new statement handle on this client's connection, returning nullptr on failure */
+void *tSQLClient_t::allocStatement() const noexcept
 {
 	void *queryHandle = nullptr;
-	if (!valid() || error(SQLAllocHandle(SQL_HANDLE_STMT, connection, &queryHandle), SQL_HANDLE_STMT, queryHandle) || !queryHandle)
+	if (!valid() || error(SQLAllocHandle(SQL_HANDLE_STMT, connection, &queryHandle), SQL_HANDLE_STMT, queryHandle))
+		return nullptr;
+	return queryHandle;
+}
+
+tSQLQuery_t tSQLClient_t::prepare(const char *const queryStmt, const size_t paramsCount) const noexcept
+{
+	void *const queryHandle{allocStatement()};
+	if (!queryHandle)
 		return {};
 	return {this, queryHandle, queryStmt, paramsCount};
 }
 
+/*!
+ * @brief Creates a prepared query from UTF-16 query text, such as that generated by toString16<>
+ * @details This hands the text to the driver as it is, avoiding converting it from UTF-8 first.
+ */
+tSQLQuery_t tSQLClient_t::prepare(const char16_t *const queryStmt, const size_t paramsCount) const noexcept
+{
+	void *const queryHandle{allocStatement()};
+	if (!queryHandle)
+		return {};
+	return {this, queryHandle, queryStmt, paramsCount};
+}
+
+/*!
+ * @brief Creates a prepared query whose statement this client keeps once the query is done with it, handing
+ *     the statement straight back out the next time the same query text is prepared this way
+ * @details This skips allocating a new statement handle and having the server prepare the query again.
+ *     Statements are looked up by the address of the query text, so this must only be used with query
+ *     text of static storage duration that never changes, such as that generated by toString16<>.
+ *     If the statement for the query text is still in use by another query, this falls back to prepare().
+ */
+tSQLQuery_t tSQLClient_t::prepareCached(const char *const queryStmt, const size_t paramsCount) const noexcept
+	{ return prepareCachedQuery(queryStmt, paramsCount); }
+tSQLQuery_t tSQLClient_t::prepareCached(const char16_t *const queryStmt, const size_t paramsCount) const noexcept
+	{ return prepareCachedQuery(queryStmt, paramsCount); }
+
+template<typename char_t> tSQLQuery_t tSQLClient_t::prepareCachedQuery(const char_t *const queryStmt,
+	const size_t paramsCount) const noexcept
+{
+	if (!valid() || !queryStmt)
+		return {};
+	for (auto &cachedQuery : cachedQueries)
+	{
+		if (cachedQuery.queryStmt != queryStmt)
+			continue;
+		else if (cachedQuery.inUse)
+			break;
+		cachedQuery.inUse = true;
+		return {this, cachedQuery.handle, paramsCount};
+	}
+
+	auto query{prepare(queryStmt, paramsCount)};
+	// Only keep the statement around if the server was able to prepare it
+	if (query.valid() && _error == tSQLExecErrorType_t::ok && cacheQuery(queryStmt, query.queryHandle))
+		query.cached = true;
+	return query;
+}
+
 tSQLResult_t tSQLClient_t::query(const char *const queryStmt) const noexcept
 {
-	const auto query = prepare(queryStmt, 0);
-	if (query.valid())
-		return query.execute();
-	return {};
+	if (!queryStmt)
+		return {};
+	const auto query{utf16::convert(queryStmt)};
+	if (!query)
+		return {};
+	return this->query(static_cast<const char16_t *>(query));
+}
+
+/*!
+ * @brief Runs a query from UTF-16 query text, such as that generated by toString16<>
+ * @details The query is executed directly rather than being prepared first, saving a round trip to the server.
+ */
+tSQLResult_t tSQLClient_t::query(const char16_t *const queryStmt) const noexcept
+{
+	void *const queryHandle{queryStmt ? allocStatement() : nullptr};
+	if (!queryHandle)
+		return {};
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast,cppcoreguidelines-pro-type-reinterpret-cast)
+	if (error(SQLExecDirect(queryHandle, reinterpret_cast<SQLWCHAR *>(const_cast<char16_t *>(queryStmt)), SQL_NTS),
+			SQL_HANDLE_STMT, queryHandle) && _error != tSQLExecErrorType_t::dataAvail &&
+		_error != tSQLExecErrorType_t::noData)
+	{
+		SQLFreeHandle(SQL_HANDLE_STMT, queryHandle);
+		return {};
+	}
+	return {this, queryHandle, _error == tSQLExecErrorType_t::ok};
+}
+
+tSQLAsyncQuery_t tSQLClient_t::queryAsync(const char *const queryStmt, void *const event) const noexcept
+{
+	if (!queryStmt)
+		return {};
+	auto queryText{utf16::convert(queryStmt)};
+	if (!queryText)
+		return {};
+	// The converted text doesn't move when handed over, so the query can go on using it while it is polled
+	auto query{queryAsync(static_cast<const char16_t *>(queryText), event)};
+	query.queryText.swap(queryText);
+	return query;
+}
+
+/*!
+ * @brief Starts running a query from UTF-16 query text, returning straight away rather than waiting on the result
+ * @details The query text must be left alone until the query is done, as it is handed to the driver each time
+ *     the query is polled. If given an event to signal, the driver manager uses that to say when the query
+ *     completes, otherwise the query must be polled with process(). Event notification needs the Windows
+ *     driver manager, so elsewhere an event makes this fail. Drivers that can't run queries asynchronously
+ *     run the query to completion before this returns. Without MARS, only one query can be in flight
+ *     on a connection at a time - to run many queries at once, use one client per query.
+ * @returns a tSQLAsyncQuery_t to drive to completion, which is invalid if the query could not be started
+ */
+tSQLAsyncQuery_t tSQLClient_t::queryAsync(const char16_t *const queryStmt, void *const event) const noexcept
+{
+	void *const queryHandle{queryStmt ? allocStatement() : nullptr};
+	if (!queryHandle)
+		return {};
+	return {this, queryHandle, queryStmt, event};
 }
 
 bool tSQLClient_t::beginTransact() const noexcept
@@ -188,6 +342,69 @@ bool tSQLClient_t::endTransact(const bool commitSuccess) const noexcept
 	return !needsCommit;
 }
 
+bool tSQLClient_t::cacheQuery(const void *const queryStmt, void *const handle) const noexcept try
+{
+	// If this query text's statement was in use, there is one prepared already - don't cache a second
+	for (const auto &cachedQuery : cachedQueries)
+	{
+		if (cachedQuery.queryStmt == queryStmt)
+			return false;
+	}
+	cachedQueries.push_back({queryStmt, handle, true});
+	return true;
+}
+catch (const std::bad_alloc &)
+	{ return false; }
+
+/*!
+ * @internal
+ * @brief Hands a statement from prepareCached() back to the cache, closing any cursor left open on it and
+ *     dropping the parameters bound to it so it's ready for the next query to bind its own
+ */
+void tSQLClient_t::releaseQuery(void *const handle) const noexcept
+{
+	for (auto cachedQuery{cachedQueries.begin()}; cachedQuery != cachedQueries.end(); ++cachedQuery)
+	{
+		if (cachedQuery->handle != handle)
+			continue;
+		// This statement was dropped from the cache while in use, so it's now done with entirely
+		if (!cachedQuery->queryStmt)
+		{
+			SQLFreeHandle(SQL_HANDLE_STMT, handle);
+			cachedQueries.erase(cachedQuery);
+			return;
+		}
+		closeStatement(handle);
+		SQLFreeStmt(handle, SQL_RESET_PARAMS);
+		// Undo anything paramSets() set up on the statement
+		SQLSetStmtAttr(handle, SQL_ATTR_PARAMSET_SIZE, reinterpret_cast<void *>(1), 0); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		SQLSetStmtAttr(handle, SQL_ATTR_PARAM_STATUS_PTR, nullptr, 0);
+		cachedQuery->inUse = false;
+		return;
+	}
+}
+
+/*!
+ * @internal
+ * @brief Empties the cache of statements made by prepareCached(), freeing those not in use and leaving
+ *     those that are for releaseQuery() to free once their queries are done with them
+ */
+void tSQLClient_t::dropCachedQueries() const noexcept
+{
+	auto cachedQuery{cachedQueries.begin()};
+	while (cachedQuery != cachedQueries.end())
+	{
+		if (cachedQuery->inUse)
+		{
+			cachedQuery->queryStmt = nullptr;
+			++cachedQuery;
+			continue;
+		}
+		SQLFreeHandle(SQL_HANDLE_STMT, cachedQuery->handle);
+		cachedQuery = cachedQueries.erase(cachedQuery);
+	}
+}
+
 bool tSQLClient_t::error(const int16_t err, const int16_t handleType, void *const handle) const noexcept
 	{ return error(translateError(err), handleType, handle); }
 bool tSQLClient_t::error(const tSQLExecErrorType_t err) const noexcept
@@ -200,6 +417,10 @@ bool tSQLClient_t::error(const tSQLExecErrorType_t err, const int16_t handleType
 }
 
 tSQLQuery_t::tSQLQuery_t(const tSQLClient_t *const parent, void *handle, const char *const queryStmt,
+	const size_t paramsCount) noexcept : tSQLQuery_t{parent, handle,
+		static_cast<const char16_t *>(queryStmt ? utf16::convert(queryStmt) : utf16_t{nullptr}), paramsCount} { }
+
+tSQLQuery_t::tSQLQuery_t(const tSQLClient_t *const parent, void *handle, const char16_t *const queryStmt,
 	const size_t paramsCount) noexcept : client{parent}, queryHandle{handle}, numParams{paramsCount},
 		paramStorage{paramsCount}, dataLengths{paramsCount}
 {
@@ -208,17 +429,31 @@ tSQLQuery_t::tSQLQuery_t(const tSQLClient_t *const parent, void *handle, const c
 		client = nullptr;
 		return;
 	}
-	const auto query{utf16::convert(queryStmt)};
-	const auto queryLength{utf16::length(query)};
-	if (!query || queryLength > std::numeric_limits<SQLINTEGER>::max())
-		error(SQL_ERROR);
-	else
-		error(SQLPrepare(queryHandle, query, static_cast<SQLINTEGER>(queryLength)));
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast,cppcoreguidelines-pro-type-reinterpret-cast)
+	error(SQLPrepare(queryHandle, reinterpret_cast<SQLWCHAR *>(const_cast<char16_t *>(queryStmt)), SQL_NTS));
+}
+
+/*! @internal @brief Constructs a query around a statement from the client's cache that has already been prepared */
+tSQLQuery_t::tSQLQuery_t(const tSQLClient_t *const parent, void *handle, const size_t paramsCount) noexcept :
+	client{parent}, queryHandle{handle}, numParams{paramsCount}, paramStorage{paramsCount},
+	dataLengths{paramsCount}, cached{true}
+{
+	if (numParams && !dataLengths)
+	{
+		client->releaseQuery(queryHandle);
+		client = nullptr;
+		queryHandle = nullptr;
+	}
 }
 
 tSQLQuery_t::~tSQLQuery_t() noexcept
 {
-	if (queryHandle && !executed)
+	if (!queryHandle)
+		return;
+	else if (cached)
+		client->releaseQuery(queryHandle);
+	// Once shared with the query's results, the statement is freed by whichever of them goes last
+	else if (!statement)
 		error(SQLFreeHandle(SQL_HANDLE_STMT, queryHandle));
 }
 
@@ -230,22 +465,383 @@ void tSQLQuery_t::swap(tSQLQuery_t &qry) noexcept
 	std::swap(paramStorage, qry.paramStorage);
 	std::swap(dataLengths, qry.dataLengths);
 	std::swap(executed, qry.executed);
+	std::swap(cached, qry.cached);
+	statement.swap(qry.statement);
+	paramColumns.swap(qry.paramColumns);
+	paramStatus.swap(qry.paramStatus);
+	std::swap(setsCount, qry.setsCount);
+	std::swap(currentSet, qry.currentSet);
 }
 
+/*!
+ * @brief Switches the query to binding many sets of parameters at once, running the statement once for each
+ *     set when executed but in a single call to the driver. This must be done before anything is bound.
+ * @details Having done this, select each set in turn with paramSet() and then bind() its parameters as normal.
+ *     After execution, paramSetSucceeded() tells you which sets were run successfully.
+ * @returns true if the query is ready to take the parameter sets, false otherwise
+ */
+bool tSQLQuery_t::paramSets(const size_t count) noexcept
+{
+	if (!valid() || executed || paramColumns.valid() || !count || !numParams)
+		return false;
+	paramColumns = fixedVector_t<paramColumn_t>{numParams};
+	paramStatus = fixedVector_t<uint16_t>{count};
+	if (!paramColumns.valid() || !paramStatus.valid())
+	{
+		paramColumns = {};
+		paramStatus = {};
+		return false;
+	}
+	for (auto &status : paramStatus)
+		status = SQL_PARAM_UNUSED;
+	setsCount = count;
+	currentSet = 0;
+	return true;
+}
+
+/*! @brief Selects which parameter set the following calls to bind() fill in */
+void tSQLQuery_t::paramSet(const size_t set) noexcept
+{
+	if (set < setsCount)
+		currentSet = set;
+}
+
+/*! @returns true if the query has been executed and the given parameter set was successfully run, false otherwise */
+bool tSQLQuery_t::paramSetSucceeded(const size_t set) const noexcept
+{
+	if (!executed || set >= setsCount || !paramStatus.valid())
+		return false;
+	const auto status{paramStatus.data()[set]};
+	return status == SQL_PARAM_SUCCESS || status == SQL_PARAM_SUCCESS_WITH_INFO;
+}
+
+/*!
+ * @internal
+ * @brief Gets the column-wise storage for a parameter, making sure it's at least width bytes wide per set
+ * @details If this fails, the parameter sets are dropped so the query cannot then be executed with a set
+ *     of parameters missing
+ * @returns the parameter's storage, or nullptr if it could not be allocated or widened
+ */
+auto tSQLQuery_t::paramSetColumn(const size_t index, const int16_t typeC, const int16_t typeODBC,
+	const size_t digits, const int16_t scale, const size_t width) noexcept -> paramColumn_t *
+{
+	if (index >= numParams || !paramStatus.valid())
+		return nullptr;
+	auto &column{paramColumns.data()[index]};
+	if (!column.lengths.valid())
+	{
+		column.lengths = fixedVector_t<sql_len_t>{setsCount};
+		if (!column.lengths.valid())
+		{
+			paramStatus = {};
+			return nullptr;
+		}
+	}
+	column.typeC = typeC;
+	column.typeODBC = typeODBC;
+	column.scale = scale;
+	column.digits = std::max(column.digits, digits);
+
+	if (width > column.width || !column.data.valid())
+	{
+		// Grow geometrically so a run of ever longer strings doesn't re-layout the column every time
+		const auto newWidth{std::max({width, column.width * 2U, size_t{1}})};
+		if (newWidth > static_cast<size_t>(std::numeric_limits<SQLLEN>::max()) / setsCount)
+		{
+			paramStatus = {};
+			return nullptr;
+		}
+		fixedVector_t<char> data{newWidth * setsCount};
+		if (!data.valid())
+		{
+			paramStatus = {};
+			return nullptr;
+		}
+		if (column.data.valid())
+		{
+			for (size_t set{0}; set < setsCount; ++set)
+				std::memcpy(data.data() + (set * newWidth), column.data.data() + (set * column.width), column.width);
+		}
+		column.data.swap(data);
+		column.width = newWidth;
+	}
+	return &column;
+}
+
+/*!
+ * @internal
+ * @brief Binds the column-wise storage of every parameter and tells the driver how many sets there are
+ * @returns false if a parameter was never bound or any part of the binding failed, true otherwise
+ */
+bool tSQLQuery_t::bindParamSets() const noexcept
+{
+	if (!paramStatus.valid() ||
+		error(SQLSetStmtAttr(queryHandle, SQL_ATTR_PARAM_BIND_TYPE,
+			reinterpret_cast<void *>(SQL_PARAM_BIND_BY_COLUMN), 0)) || // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		error(SQLSetStmtAttr(queryHandle, SQL_ATTR_PARAMSET_SIZE,
+			reinterpret_cast<void *>(static_cast<uintptr_t>(setsCount)), 0)) || // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+		error(SQLSetStmtAttr(queryHandle, SQL_ATTR_PARAM_STATUS_PTR, const_cast<uint16_t *>(paramStatus.data()), 0)))
+		return false;
+	for (size_t i{0}; i < numParams; ++i)
+	{
+		const auto &column{paramColumns.data()[i]};
+		if (!column.lengths.valid() || !column.data.valid())
+			return false;
+		if (error(SQLBindParameter(queryHandle, static_cast<SQLUSMALLINT>(i + 1U), SQL_PARAM_INPUT, column.typeC,
+			column.typeODBC, column.digits, column.scale,
+			const_cast<char *>(column.data.data()), // NOLINT(cppcoreguidelines-pro-type-const-cast)
+			static_cast<SQLLEN>(column.width),
+			const_cast<sql_len_t *>(column.lengths.data())))) // NOLINT(cppcoreguidelines-pro-type-const-cast)
+			return false;
+	}
+	return true;
+}
+
+/*!
+ * @internal
+ * @brief Hands ownership of an uncached query's statement over to a reference count shared with the
+ *     results of executing it, so the statement lives on for as long as any of them are around
+ * @returns false if the reference count could not be allocated, true otherwise
+ */
+bool tSQLQuery_t::shareStatement() const noexcept try
+{
+	if (!cached && !statement)
+		statement = std::make_shared<statementOwner_t>(queryHandle);
+	return true;
+}
+catch (const std::bad_alloc &)
+	{ return false; }
+
+/*!
+ * @brief Executes the query with the parameters currently bound
+ * @details The query may be executed as many times as needed, binding new parameter values in between.
+ *     The result refers to this query's statement, so is only usable until the query is next executed.
+ *     The result of an uncached query keeps its statement alive, so may outlive the query; that of a query
+ *     from prepareCached() borrows the cached statement, so is only usable for as long as the query is around.
+ */
 tSQLResult_t tSQLQuery_t::execute() const noexcept
 {
-	if (!valid() || !queryHandle || !client || executed ||
-		(error(SQLExecute(queryHandle)) && client->error() != tSQLExecErrorType_t::dataAvail &&
-		client->error() != tSQLExecErrorType_t::noData))
+	if (!valid() || !queryHandle || !client || (paramColumns.valid() && !bindParamSets()) || !shareStatement())
+		return {};
+	if (executed)
+		closeStatement(queryHandle);
+	if (error(SQLExecute(queryHandle)) && client->error() != tSQLExecErrorType_t::dataAvail &&
+		client->error() != tSQLExecErrorType_t::noData)
 		return {};
 	executed = true;
-	return {client, queryHandle, client->error() == tSQLExecErrorType_t::ok};
+	tSQLResult_t result{client, queryHandle, client->error() == tSQLExecErrorType_t::ok, false};
+	result.statement = statement;
+	return result;
+}
+
+/*!
+ * @brief Starts executing the query with the parameters currently bound, returning straight away
+ *     rather than waiting on the result
+ * @details As with execute(), the result refers to this query's statement, so the query must outlive the
+ *     asynchronous query and not be executed again until that is done. See tSQLClient_t::queryAsync()
+ *     for how the query gets driven to completion.
+ * @returns a tSQLAsyncQuery_t to drive to completion, which is invalid if the query could not be started
+ */
+tSQLAsyncQuery_t tSQLQuery_t::executeAsync(void *const event) const noexcept
+{
+	if (!valid() || !queryHandle || !client || (paramColumns.valid() && !bindParamSets()))
+		return {};
+	if (executed)
+		closeStatement(queryHandle);
+	executed = true;
+	return {client, queryHandle, nullptr, event};
 }
 
 bool tSQLQuery_t::error(const int16_t err) const noexcept
 	{ return !client || client->error(err, SQL_HANDLE_STMT, queryHandle); }
 
-tSQLResult_t::tSQLResult_t(const tSQLClient_t *const _client, void *handle, const bool hasData, const bool freeHandle) noexcept :
+tSQLAsyncQuery_t::tSQLAsyncQuery_t(const tSQLClient_t *const parent, void *handle, const char16_t *const query,
+	void *const event) noexcept : client{parent}, queryHandle{handle}, queryStmt{query}, freeHandle{query != nullptr}
+{
+	if (!enableAsync(event))
+	{
+		if (freeHandle)
+			SQLFreeHandle(SQL_HANDLE_STMT, queryHandle);
+		client = nullptr;
+		queryHandle = nullptr;
+		return;
+	}
+	update(invoke());
+}
+
+/*!
+ * @details An abandoned query has to be polled through to its cancellation before the driver lets go of it.
+ *     This backs off between polls, and after cancelPolls of them gives up on the statement rather than
+ *     holding the thread up indefinitely.
+ */
+tSQLAsyncQuery_t::~tSQLAsyncQuery_t() noexcept
+{
+	if (!valid())
+		return;
+	SQLCancel(queryHandle);
+	for (uint32_t poll{0}; poll < cancelPolls && process() && !completed; ++poll)
+		std::this_thread::sleep_for(std::chrono::milliseconds{1U << std::min(poll, 7U)});
+	if (valid() && freeHandle)
+		SQLFreeHandle(SQL_HANDLE_STMT, queryHandle);
+}
+
+/*!
+ * @internal
+ * @brief Switches the statement over to running asynchronously, with completion signalled through the
+ *     event given if there is one
+ * @returns false if an event was given and the driver manager can't signal it, true otherwise
+ */
+bool tSQLAsyncQuery_t::enableAsync(void *const event) noexcept
+{
+	// Drivers that don't support this just go on running the query synchronously, which is still correct
+	SQLSetStmtAttr(queryHandle, SQL_ATTR_ASYNC_ENABLE, reinterpret_cast<void *>(SQL_ASYNC_ENABLE_ON), 0); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	if (!event)
+		return true;
+#if defined(_WINDOWS) && defined(SQL_ATTR_ASYNC_STMT_EVENT)
+	if (client->error(SQLSetStmtAttr(queryHandle, SQL_ATTR_ASYNC_STMT_EVENT, event, SQL_IS_POINTER),
+		SQL_HANDLE_STMT, queryHandle))
+	{
+		SQLSetStmtAttr(queryHandle, SQL_ATTR_ASYNC_ENABLE, reinterpret_cast<void *>(SQL_ASYNC_ENABLE_OFF), 0); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		return false;
+	}
+	return notified = true;
+#else
+	SQLSetStmtAttr(queryHandle, SQL_ATTR_ASYNC_ENABLE, reinterpret_cast<void *>(SQL_ASYNC_ENABLE_OFF), 0); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	return !client->error(tSQLExecErrorType_t::generalError);
+#endif
+}
+
+/*! @internal @brief Switches the statement back to running synchronously, dropping any event it was signalling */
+void tSQLAsyncQuery_t::disableAsync() const noexcept
+{
+	SQLSetStmtAttr(queryHandle, SQL_ATTR_ASYNC_ENABLE, reinterpret_cast<void *>(SQL_ASYNC_ENABLE_OFF), 0); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+#if defined(_WINDOWS) && defined(SQL_ATTR_ASYNC_STMT_EVENT)
+	if (notified)
+		SQLSetStmtAttr(queryHandle, SQL_ATTR_ASYNC_STMT_EVENT, nullptr, SQL_IS_POINTER);
+#endif
+}
+
+/*!
+ * @internal
+ * @brief Calls the function running the query, which when polling is also how the driver gets asked
+ *     if it has finished yet
+ */
+int16_t tSQLAsyncQuery_t::invoke() const noexcept
+{
+	if (fetching)
+		return SQLFetch(queryHandle);
+	else if (!queryStmt)
+		return SQLExecute(queryHandle);
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast,cppcoreguidelines-pro-type-reinterpret-cast)
+	return SQLExecDirect(queryHandle, reinterpret_cast<SQLWCHAR *>(const_cast<char16_t *>(queryStmt)), SQL_NTS);
+}
+
+/*!
+ * @internal
+ * @brief Moves the query on once the driver reports the step in flight is no longer executing
+ * @details Once the query has run, the result is built with the statement briefly running synchronously,
+ *     which only looks up the result's columns and binds them. The result's first fetch, where the driver
+ *     waits on the server to start sending rows, then runs asynchronously too - the query completes once
+ *     that fetch does. If the statement can't be switched back to running asynchronously, that fetch blocks.
+ */
+void tSQLAsyncQuery_t::update(const int16_t result) noexcept
+{
+	if (result == SQL_STILL_EXECUTING)
+		return;
+	else if (fetching)
+	{
+		disableAsync();
+		queryResult.fetched(result);
+		finish(false);
+		return;
+	}
+	const bool failed{client->error(result, SQL_HANDLE_STMT, queryHandle) &&
+		client->error() != tSQLExecErrorType_t::dataAvail && client->error() != tSQLExecErrorType_t::noData};
+	const bool hasData{client->error() == tSQLExecErrorType_t::ok};
+	if (failed || !hasData)
+	{
+		disableAsync();
+		if (!failed)
+			queryResult = {client, queryHandle, hasData, freeHandle};
+		finish(failed);
+		return;
+	}
+
+	// Any event stays set on the statement for the fetch, so only asynchronous running gets switched off here
+	SQLSetStmtAttr(queryHandle, SQL_ATTR_ASYNC_ENABLE, reinterpret_cast<void *>(SQL_ASYNC_ENABLE_OFF), 0); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	queryResult = {client, queryHandle, hasData, freeHandle, false};
+	// The result now owns the statement if it was ours
+	freeHandle = false;
+	if (!queryResult.valid() || !queryResult.numFields() ||
+		SQLSetStmtAttr(queryHandle, SQL_ATTR_ASYNC_ENABLE, reinterpret_cast<void *>(SQL_ASYNC_ENABLE_ON), 0) != SQL_SUCCESS) // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	{
+		disableAsync();
+		if (queryResult.valid() && queryResult.numFields())
+			queryResult.next();
+		finish(false);
+		return;
+	}
+	fetching = true;
+	update(invoke());
+}
+
+/*! @internal @brief Completes the query, freeing the statement if it failed and was ours */
+void tSQLAsyncQuery_t::finish(const bool failed) noexcept
+{
+	if (failed && freeHandle)
+		SQLFreeHandle(SQL_HANDLE_STMT, queryHandle);
+	queryHandle = nullptr;
+	queryText = nullptr;
+	queryStmt = nullptr;
+	completed = true;
+}
+
+/*!
+ * @brief Makes as much progress on the query as can be made without blocking
+ * @details When polling, this should be called periodically. When the driver manager is signalling an event,
+ *     this should be called once the event is signalled. Once done() returns true, the query's result is
+ *     available from result() - if the query failed, the result is invalid and the client's error()
+ *     says why, just as for blocking queries.
+ * @returns false if the query is not in flight, true otherwise
+ */
+bool tSQLAsyncQuery_t::process() noexcept
+{
+	if (!valid())
+		return false;
+#if defined(_WINDOWS) && defined(SQL_ATTR_ASYNC_STMT_EVENT)
+	if (notified)
+	{
+		SQLRETURN result{};
+		const auto status{SQLCompleteAsync(SQL_HANDLE_STMT, queryHandle, &result)};
+		update(status == SQL_SUCCESS ? result : status);
+		return true;
+	}
+#endif
+	update(invoke());
+	return true;
+}
+
+void tSQLAsyncQuery_t::swap(tSQLAsyncQuery_t &query) noexcept
+{
+	std::swap(client, query.client);
+	std::swap(queryHandle, query.queryHandle);
+	std::swap(queryStmt, query.queryStmt);
+	queryText.swap(query.queryText);
+	std::swap(freeHandle, query.freeHandle);
+	std::swap(notified, query.notified);
+	std::swap(fetching, query.fetching);
+	std::swap(completed, query.completed);
+	queryResult = std::move(query.queryResult);
+}
+
+/*!
+ * @internal
+ * @param fetchFirst Whether to fetch the first row (or block of rows) straight away - if not, the caller
+ *     must make that fetch itself and hand what it returned to fetched()
+ */
+tSQLResult_t::tSQLResult_t(const tSQLClient_t *const _client, void *handle, const bool hasData, const bool freeHandle,
+	const bool fetchFirst) noexcept :
 	client{_client}, queryHandle{handle}, _hasData{hasData}, _freeHandle{freeHandle}, fieldInfo{}, valueCache{}
 {
 	int16_t _fields{};
@@ -261,8 +857,8 @@ tSQLResult_t::tSQLResult_t(const tSQLClient_t *const _client, void *handle, cons
 			return;
 		for (uint16_t i = 0; i < fields; ++i)
 		{
-			long type = 0;
-			long length = 0;
+			sql_len_t type = 0;
+			sql_len_t length = 0;
 			if (error(
 					SQLColAttribute(queryHandle, static_cast<SQLUSMALLINT>(i + 1U), SQL_DESC_CONCISE_TYPE,
 						nullptr, 0, nullptr, &type)
@@ -276,13 +872,26 @@ tSQLResult_t::tSQLResult_t(const tSQLClient_t *const _client, void *handle, cons
 			}
 			fieldInfo[i] = {int16_t(type), uint32_t(length)};
 		}
-		if (hasData)
+		// If the columns can't all be bound for block fetching, fall back to fetching a row at a time
+		if (hasData && !bindBlock())
+		{
+			block.reset();
+			columnBuffers = fixedVector_t<fixedVector_t<char>>{fields};
+			wideBuffers = fixedVector_t<fixedVector_t<char16_t>>{fields};
+			if (!columnBuffers.valid() || !wideBuffers.valid())
+			{
+				fieldInfo.reset();
+				return;
+			}
+		}
+		if (hasData && fetchFirst)
 			next();
 	}
 }
 
 tSQLResult_t::~tSQLResult_t() noexcept
 {
+	// Borrowed statements get reset by their query when it next executes or is done with them
 	if (_freeHandle)
 		SQLFreeHandle(SQL_HANDLE_STMT, queryHandle);
 }
@@ -293,14 +902,18 @@ void tSQLResult_t::operator =(tSQLResult_t &&res) noexcept
 	std::swap(queryHandle, res.queryHandle);
 	std::swap(_hasData, res._hasData);
 	std::swap(_freeHandle, res._freeHandle);
+	statement.swap(res.statement);
 	std::swap(fields, res.fields);
 	std::swap(fieldInfo, res.fieldInfo);
 	valueCache.swap(res.valueCache);
+	block.swap(res.block);
+	columnBuffers.swap(res.columnBuffers);
+	wideBuffers.swap(res.wideBuffers);
 }
 
 uint64_t tSQLResult_t::numRows() const noexcept
 {
-	long rows = 0;
+	sql_len_t rows = 0;
 	if (!valid() || error(SQLRowCount(queryHandle, &rows)) || rows < 0)
 		return 0;
 	return uint64_t(rows);
@@ -312,7 +925,28 @@ bool tSQLResult_t::next() const noexcept
 		return false;
 	for (auto &value : valueCache)
 		value = tSQLValue_t{};
-	return !error(SQLFetch(queryHandle));
+	// Step through the current block, only going back to the driver once it's used up
+	if (block && ++block->row < block->rowsFetched)
+		return true;
+	return fetched(SQLFetch(queryHandle));
+}
+
+/*!
+ * @internal
+ * @brief Takes on the outcome of a call to SQLFetch() made on this result's statement
+ * @returns true if a row (or block of rows) was fetched, false otherwise
+ */
+bool tSQLResult_t::fetched(const int16_t result) const noexcept
+{
+	if (!block)
+		return !error(result);
+	block->row = 0;
+	if (error(result))
+	{
+		block->rowsFetched = 0;
+		return false;
+	}
+	return block->rowsFetched != 0;
 }
 
 inline bool isCharType(const int16_t type) noexcept
@@ -323,43 +957,181 @@ inline bool isBinType(const int16_t type) noexcept
 	{ return type == SQL_LONGVARBINARY || type == SQL_VARBINARY || type == SQL_BINARY; }
 tSQLValue_t tSQLResult_t::nullValue{};
 
+/*!
+ * @internal
+ * @brief Gives the space needed to read the longest value a string or binary column can hold,
+ *     including the NUL terminator the driver writes on the end of strings
+ * @returns the width in bytes, or 0 for (MAX) columns, which have no upper bound on their length
+ */
+inline size_t stringWidth(const int16_t type, const uint32_t length) noexcept
+{
+	if (!length)
+		return 0;
+	// The driver recodes narrow strings into UTF-8 for us, so allow for every character growing to 4 bytes
+	else if (isCharType(type))
+		return (size_t{length} * 4U) + 1U;
+	return size_t{length} + (isWCharType(type) ? 2U : 0U);
+}
+
+/*! @internal @brief Gives the size of the NUL terminator the driver writes on the end of a column's values */
+inline size_t terminatorWidth(const int16_t type) noexcept
+	{ return isCharType(type) ? 1U : isWCharType(type) ? 2U : 0U; }
+
+/*!
+ * @internal
+ * @brief Gives the space a column needs per row when bound for block fetching
+ * @returns the width in bytes, or 0 if the column can't be block fetched - such as (MAX) columns,
+ *     which have no upper bound on their length
+ */
+inline size_t blockWidth(const int16_t type, const uint32_t length) noexcept
+{
+	if (isCharType(type) || isWCharType(type) || isBinType(type))
+	{
+		const auto width{stringWidth(type, length)};
+		return width > maxBlockLength ? 0 : width;
+	}
+	switch (type)
+	{
+		case SQL_BIGINT:
+		case SQL_INTEGER:
+		case SQL_SMALLINT:
+		case SQL_TINYINT:
+		case SQL_BIT:
+		case SQL_REAL:
+		case SQL_FLOAT:
+		case SQL_DOUBLE:
+		case SQL_GUID:
+		case SQL_TYPE_DATE:
+		case SQL_TYPE_TIMESTAMP:
+			return length;
+	}
+	return 0;
+}
+
+/*!
+ * @internal
+ * @brief Binds every column of the result to column-wise buffers and switches the statement to fetching
+ *     as many rows as fit in those buffers per SQLFetch()
+ * @returns true if block fetching could be set up, false if the result must be fetched a row at a time
+ */
+bool tSQLResult_t::bindBlock() noexcept
+{
+	size_t rowWidth{0};
+	for (uint16_t i = 0; i < fields; ++i)
+	{
+		const auto width{blockWidth(fieldInfo[i].first, fieldInfo[i].second)};
+		if (!width)
+			return false;
+		rowWidth += width + sizeof(sql_len_t);
+	}
+
+	block = substrate::make_unique_nothrow<rowBlock_t>();
+	if (!block)
+		return false;
+	auto &rowBlock{*block};
+	rowBlock.rows = static_cast<uint32_t>(std::max<size_t>(std::min<size_t>(maxBlockLength / rowWidth, maxBlockRows), 1U));
+	rowBlock.data = fixedVector_t<char>{(rowWidth - (sizeof(sql_len_t) * fields)) * rowBlock.rows};
+	rowBlock.lengths = fixedVector_t<sql_len_t>{size_t{fields} * rowBlock.rows};
+	rowBlock.offsets = fixedVector_t<size_t>{fields};
+	if (!rowBlock.data.valid() || !rowBlock.lengths.valid() || !rowBlock.offsets.valid())
+		return false;
+
+	// Failing here just means falling back to row-at-a-time fetching, so don't report errors through the client
+	const auto succeeded{[](const SQLRETURN result) noexcept { return translateError(result) == tSQLExecErrorType_t::ok; }};
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+	if (!succeeded(SQLSetStmtAttr(queryHandle, SQL_ATTR_ROW_BIND_TYPE, reinterpret_cast<void *>(SQL_BIND_BY_COLUMN), 0)) ||
+		!succeeded(SQLSetStmtAttr(queryHandle, SQL_ATTR_ROW_ARRAY_SIZE,
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+			reinterpret_cast<void *>(static_cast<uintptr_t>(rowBlock.rows)), 0)) ||
+		!succeeded(SQLSetStmtAttr(queryHandle, SQL_ATTR_ROWS_FETCHED_PTR, &rowBlock.rowsFetched, 0)))
+	{
+		unbindBlock();
+		return false;
+	}
+
+	size_t offset{0};
+	for (uint16_t i = 0; i < fields; ++i)
+	{
+		const auto width{blockWidth(fieldInfo[i].first, fieldInfo[i].second)};
+		rowBlock.offsets.data()[i] = offset;
+		if (!succeeded(SQLBindCol(queryHandle, static_cast<SQLUSMALLINT>(i + 1U), odbcToCType(fieldInfo[i].first),
+			rowBlock.data.data() + offset, static_cast<SQLLEN>(width), rowBlock.lengths.data() + (size_t{i} * rowBlock.rows))))
+		{
+			unbindBlock();
+			return false;
+		}
+		offset += width * rowBlock.rows;
+	}
+	// Make the first next() fetch the first block
+	rowBlock.row = rowBlock.rows;
+	return true;
+}
+
+/*! @internal @brief Puts the statement back to fetching a row at a time with no bound columns */
+void tSQLResult_t::unbindBlock() const noexcept
+{
+	SQLFreeStmt(queryHandle, SQL_UNBIND);
+	SQLSetStmtAttr(queryHandle, SQL_ATTR_ROW_ARRAY_SIZE, reinterpret_cast<void *>(1), 0); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	SQLSetStmtAttr(queryHandle, SQL_ATTR_ROWS_FETCHED_PTR, nullptr, 0);
+}
+
+/*!
+ * @internal
+ * @brief Reads a value out of the current row of the fetched block, for operator []()
+ */
+tSQLValue_t &tSQLResult_t::blockValue(const uint16_t idx) const noexcept
+{
+	const auto &rowBlock{*block};
+	const auto length{rowBlock.lengths.data()[(size_t{idx} * rowBlock.rows) + rowBlock.row]};
+	if (length == SQL_NULL_DATA || length == SQL_NO_TOTAL || length < 0)
+		return nullValue;
+
+	int16_t type{};
+	uint32_t valueLength{};
+	std::tie(type, valueLength) = fieldInfo[idx];
+	const auto width{blockWidth(type, valueLength)};
+	const char *const value{rowBlock.data.data() + rowBlock.offsets.data()[idx] + (width * rowBlock.row)};
+	size_t dataLength{valueLength};
+	if (isCharType(type) || isWCharType(type) || isBinType(type))
+	{
+		// The width bound includes space for the NUL terminator, which is not part of the value
+		dataLength = std::min(static_cast<size_t>(length), width - terminatorWidth(type));
+		valueLength = uint32_t(dataLength) + (isWCharType(type) ? 2U : 1U);
+	}
+
+	// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+	auto valueStorage = substrate::make_unique_nothrow<char []>(valueLength);
+	if (!valueStorage)
+		return nullValue;
+	std::memcpy(valueStorage.get(), value, dataLength);
+	for (size_t i{dataLength}; i < valueLength; ++i)
+		valueStorage[i] = 0;
+	valueCache.data()[idx] = {valueStorage.release(), valueLength, type};
+	return valueCache.data()[idx];
+}
+
 tSQLValue_t &tSQLResult_t::operator [](const uint16_t idx) const noexcept try
 {
 	if (idx >= fields || !valid())
 		return nullValue;
 	else if (!valueCache[idx].isNull())
 		return valueCache[idx];
+	else if (block)
+		return blockValue(idx);
 	const auto column{static_cast<uint16_t>(idx + 1U)};
 
 	// Pitty this can't use C++17 syntax: [const int16_t type, const uint32_t valueLength] = fieldInfo[idx];
 	int16_t type{};
 	uint32_t valueLength{};
 	std::tie(type, valueLength) = fieldInfo[idx];
-	const int16_t cType = odbcToCType(type);
 	if (isCharType(type) || isWCharType(type) || isBinType(type))
-	{
-		uint32_t temp = 0;
-		long length = 0;
-		if (error(SQLGetData(queryHandle, column, cType, &temp, 0, &length)) || length == SQL_NULL_DATA || length == SQL_NO_TOTAL)
-			return nullValue;
-		valueLength = uint32_t(length) + 1;
-		if (isWCharType(type))
-			++valueLength;
-	}
+		return stringValue(idx);
 
 	// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
 	auto valueStorage = substrate::make_unique_nothrow<char []>(valueLength);
-	if (!valueStorage)
+	if (!valueStorage ||
+		error(SQLGetData(queryHandle, column, odbcToCType(type), valueStorage.get(), valueLength, nullptr)))
 		return nullValue;
-	valueStorage[valueLength - 1] = 0;
-	if (isWCharType(type))
-		valueStorage[valueLength - 2] = 0;
-	// Hmm.. I think this might actually be wrong.. needs more thought.
-	if (!(isBinType(type) && valueLength == 1))
-	{
-		if (error(SQLGetData(queryHandle, column, cType, valueStorage.get(), valueLength, nullptr)))
-			return nullValue;
-	}
 	valueCache[idx] = {valueStorage.release(), valueLength, type};
 	return valueCache[idx];
 }
@@ -382,6 +1154,100 @@ catch (const std::out_of_range &error)
 	std::terminate();
 }
 
+/*!
+ * @internal
+ * @brief Reads a string or binary column of the current row into that column's reusable buffer
+ * @details The buffer is sized from the column's declared length so the whole value is read by a single
+ *     SQLGetData(). Only (MAX) columns, which have no upper bound on their length, can need several
+ *     reads to get all of a value. For those the buffer grows to fit and stays that size for the rows after.
+ *     All lengths here are in bytes, whatever the width of the buffer's elements.
+ * @returns true if the value was read, false if it was NULL or could not be read
+ */
+template<typename char_t> bool tSQLResult_t::readString(const uint16_t idx, fixedVector_t<char_t> &buffer,
+	size_t &dataLength) const noexcept
+{
+	int16_t type{};
+	uint32_t length{};
+	std::tie(type, length) = fieldInfo[idx];
+	const auto terminator{terminatorWidth(type)};
+	const auto elements{[](const size_t bytes) noexcept { return (bytes + sizeof(char_t) - 1U) / sizeof(char_t); }};
+	if (!buffer.valid())
+	{
+		const auto width{stringWidth(type, length)};
+		buffer = fixedVector_t<char_t>{elements(width ? width : firstChunkLength)};
+		if (!buffer.valid())
+			return false;
+	}
+
+	const auto column{static_cast<uint16_t>(idx + 1U)};
+	const auto cType{odbcToCType(type)};
+	size_t offset{0};
+	while (true)
+	{
+		const size_t space{(buffer.count() * sizeof(char_t)) - offset};
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		auto *const data{reinterpret_cast<char *>(buffer.data()) + offset};
+		sql_len_t remaining{0};
+		if (error(SQLGetData(queryHandle, column, cType, data, static_cast<SQLLEN>(space), &remaining)) ||
+			remaining == SQL_NULL_DATA)
+			return false;
+		// If what was left of the value fit, we're done
+		else if (remaining != SQL_NO_TOTAL && static_cast<size_t>(remaining) <= space - terminator)
+		{
+			dataLength = offset + static_cast<size_t>(remaining);
+			return true;
+		}
+
+		// Otherwise the driver filled the buffer, so grow it to fit the rest (or by half again when that's unknown)
+		offset += space - terminator;
+		const size_t size{remaining == SQL_NO_TOTAL ? buffer.count() + (buffer.count() / 2U) :
+			elements(offset + static_cast<size_t>(remaining) - (space - terminator) + terminator)};
+		fixedVector_t<char_t> newBuffer{size};
+		if (!newBuffer.valid())
+			return false;
+		std::memcpy(newBuffer.data(), buffer.data(), offset);
+		buffer.swap(newBuffer);
+	}
+}
+
+/*!
+ * @internal
+ * @brief Reads a string or binary column of the current row when fetching a row at a time, for operator []()
+ * @details Wide-character values are read into a buffer of char16_t and recoded to UTF-8 straight out of it,
+ *     so the copy kept by the value is the only allocation made per value.
+ */
+tSQLValue_t &tSQLResult_t::stringValue(const uint16_t idx) const noexcept
+{
+	size_t dataLength{0};
+	const auto type{fieldInfo[idx].first};
+	auto &value{valueCache.data()[idx]};
+	if (isWCharType(type))
+	{
+		auto &buffer{wideBuffers.data()[idx]};
+		if (!readString(idx, buffer, dataLength))
+			return nullValue;
+		auto string{utf16::convert(buffer.data())};
+		if (!string)
+			return nullValue;
+		value = {stringPtr_t{string.release()}, dataLength + 2U, type};
+		return value;
+	}
+
+	auto &buffer{columnBuffers.data()[idx]};
+	if (!readString(idx, buffer, dataLength))
+		return nullValue;
+
+	const size_t valueLength{dataLength + 1U};
+	// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+	auto valueStorage = substrate::make_unique_nothrow<char []>(valueLength);
+	if (!valueStorage)
+		return nullValue;
+	std::memcpy(valueStorage.get(), buffer.data(), dataLength);
+	valueStorage[dataLength] = 0;
+	value = {valueStorage.release(), valueLength, type};
+	return value;
+}
+
 bool tSQLResult_t::error(const int16_t err) const noexcept
 	{ return !client || client->error(err, SQL_HANDLE_STMT, queryHandle); }
 
@@ -5,6 +5,7 @@
 #include <array>
 #include <memory>
 #include <utility>
+#include <vector>
 #include <substrate/managed_ptr>
 #include "tmplORM.hxx"
 
@@ -26,6 +27,14 @@ using stringPtr_t = std::unique_ptr<const char []>;
 struct tSQLClient_t;
 using namespace tmplORM::types::baseTypes;
 using tmplORM::common::fieldLength_t;
+// ODBC's SQLLEN and SQLULEN, which are pointer-width on 64-bit platforms - including Win64, where long is not
+#ifdef _WIN64
+using sql_len_t = int64_t;
+using sql_ulen_t = uint64_t;
+#else
+using sql_len_t = long;
+using sql_ulen_t = unsigned long;
+#endif
 
 enum class tSQLExecErrorType_t : uint8_t
 {
@@ -89,6 +98,11 @@ private:
 	template<typename T> T reinterpret() const noexcept;
 	template<int16_t rawType, int16_t, tSQLErrorType_t error, typename T> T asInt(int16_t type) const;
 
+	/*! @internal @brief Constructs a string value around text that has already been recoded to UTF-8 */
+	tSQLValue_t(stringPtr_t &&string, const uint64_t _length, const int16_t _type) noexcept :
+		data{std::move(string)}, length{_length}, type{_type} { }
+	friend struct tSQLResult_t;
+
 public:
 	/*! @brief Default constructor for value objects, constructing the null value by default */
 	tSQLValue_t() noexcept = default;
@@ -165,16 +179,46 @@ private:
 	void *queryHandle{nullptr};
 	bool _hasData{false};
 	bool _freeHandle{false};
+	// Keeps the statement of the uncached query this result came from alive for as long as the result is around
+	std::shared_ptr<void> statement{};
 	uint16_t fields{0};
 	// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
 	std::unique_ptr<fieldType_t []> fieldInfo{};
 	mutable fixedVector_t<tSQLValue_t> valueCache{};
 	static tSQLValue_t nullValue;
 
+	// Column-wise buffers for fetching a block of rows at a time. This lives on the heap
+	// as ODBC holds on to pointers into it (including to rowsFetched) across fetches
+	struct rowBlock_t final
+	{
+		fixedVector_t<char> data{};
+		fixedVector_t<sql_len_t> lengths{};
+		fixedVector_t<size_t> offsets{};
+		sql_ulen_t rowsFetched{0};
+		uint32_t rows{0};
+		uint32_t row{0};
+	};
+	std::unique_ptr<rowBlock_t> block{};
+	// When fetching a row at a time, the buffers string and binary columns are read into, reused row to row.
+	// Wide-character columns get buffers of char16_t so their values can be recoded straight out of them
+	mutable fixedVector_t<fixedVector_t<char>> columnBuffers{};
+	mutable fixedVector_t<fixedVector_t<char16_t>> wideBuffers{};
+
+	bool bindBlock() noexcept;
+	void unbindBlock() const noexcept;
+	tSQLValue_t &blockValue(uint16_t idx) const noexcept;
+	bool fetched(int16_t result) const noexcept;
+	template<typename char_t> bool readString(uint16_t idx, fixedVector_t<char_t> &buffer,
+		size_t &dataLength) const noexcept;
+	tSQLValue_t &stringValue(uint16_t idx) const noexcept;
+
 protected:
-	tSQLResult_t(const tSQLClient_t *const _client, void *handle, const bool hasData, const bool freeHandle = true) noexcept;
+	tSQLResult_t(const tSQLClient_t *const _client, void *handle, const bool hasData, const bool freeHandle = true,
+		const bool fetchFirst = true) noexcept;
 	bool error(const int16_t err) const noexcept;
 	friend struct tSQLQuery_t;
+	friend struct tSQLClient_t;
+	friend struct tSQLAsyncQuery_t;
 
 public:
 	/*! @brief Default constructor for result objects, constructing invalid result objects by default */
@@ -199,6 +243,64 @@ public:
 	tSQLResult_t &operator =(const tSQLResult_t &) = delete;
 };
 
+struct tmplORM_API tSQLAsyncQuery_t final
+{
+private:
+	const tSQLClient_t *client{nullptr};
+	void *queryHandle{nullptr};
+	// The text of a query being run directly, which the driver must be handed again each time it is polled
+	const char16_t *queryStmt{nullptr};
+	// Holds that text when it had to be converted from UTF-8 first
+	utf16_t queryText{nullptr};
+	// Whether the statement belongs to this query rather than to the prepared query that started it
+	bool freeHandle{false};
+	// Whether the driver signals an event when the query completes rather than needing to be polled
+	bool notified{false};
+	// Whether the query has run and the result's first fetch is what's now in flight
+	bool fetching{false};
+	bool completed{false};
+	tSQLResult_t queryResult{};
+
+	// How many times the destructor polls a cancelled query before giving up on it
+	constexpr static uint32_t cancelPolls{16};
+
+	bool enableAsync(void *event) noexcept;
+	void disableAsync() const noexcept;
+	int16_t invoke() const noexcept;
+	void update(int16_t result) noexcept;
+	void finish(bool failed) noexcept;
+
+protected:
+	tSQLAsyncQuery_t(const tSQLClient_t *const parent, void *handle, const char16_t *const query, void *event) noexcept;
+	friend struct tSQLClient_t;
+	friend struct tSQLQuery_t;
+
+public:
+	/*! @brief Default constructor for asynchronous queries, constructing an invalid query by default */
+	tSQLAsyncQuery_t() noexcept = default;
+	tSQLAsyncQuery_t(tSQLAsyncQuery_t &&query) noexcept : tSQLAsyncQuery_t{} { swap(query); }
+	~tSQLAsyncQuery_t() noexcept;
+	void operator =(tSQLAsyncQuery_t &&query) noexcept { swap(query); }
+	/*!
+	 * @brief Call to determine if this query is valid and still in flight
+	 * @returns true if the object is valid, false otherwise
+	 */
+	bool valid() const noexcept { return client && queryHandle; }
+	/*!
+	 * @brief Call to determine if the query has finished, after which its result can be looked at
+	 * @returns true if the query has finished, false otherwise
+	 */
+	bool done() const noexcept { return completed; }
+	bool process() noexcept;
+	tSQLResult_t &result() noexcept { return queryResult; }
+	void swap(tSQLAsyncQuery_t &query) noexcept;
+
+	/*! @brief Deleted copy constructor for tSQLAsyncQuery_t as queries are not copyable */
+	tSQLAsyncQuery_t(const tSQLAsyncQuery_t &) = delete;
+	/*! @brief Deleted copy assignment operator for tSQLAsyncQuery_t as queries are not copyable */
+	tSQLAsyncQuery_t &operator =(const tSQLAsyncQuery_t &) = delete;
+};
+
 // TODO: Introduce multiQuery support in here.. we know which we are based on whether this has been created via query() or prepare() down below.
 struct tmplORM_API tSQLQuery_t final
 {
@@ -207,11 +309,39 @@ private:
 	void *queryHandle{nullptr};
 	size_t numParams{0};
 	fixedVector_t<substrate::managedPtr_t<void>> paramStorage{};
-	fixedVector_t<long> dataLengths{};
+	fixedVector_t<sql_len_t> dataLengths{};
 	mutable bool executed{false};
+	// Whether the statement handle belongs to the client's cache rather than to this query
+	bool cached{false};
+	// Ownership of an uncached query's statement once executed, shared with the results that use it
+	mutable std::shared_ptr<void> statement{};
+
+	// Column-wise storage for one parameter's values across all the parameter sets being bound
+	struct paramColumn_t final
+	{
+		fixedVector_t<char> data{};
+		fixedVector_t<sql_len_t> lengths{};
+		size_t width{0};
+		size_t digits{0};
+		int16_t typeC{0};
+		int16_t typeODBC{0};
+		int16_t scale{0};
+	};
+	fixedVector_t<paramColumn_t> paramColumns{};
+	fixedVector_t<uint16_t> paramStatus{};
+	size_t setsCount{0};
+	size_t currentSet{0};
+
+	paramColumn_t *paramSetColumn(size_t index, int16_t typeC, int16_t typeODBC, size_t digits,
+		int16_t scale, size_t width) noexcept;
+	template<typename T> void bindSet(size_t index, const T &value, fieldLength_t length) noexcept;
+	bool bindParamSets() const noexcept;
+	bool shareStatement() const noexcept;
 
 protected:
 	tSQLQuery_t(const tSQLClient_t *const parent, void *handle, const char *const queryStmt, const size_t paramsCount) noexcept;
+	tSQLQuery_t(const tSQLClient_t *const parent, void *handle, const char16_t *const queryStmt, const size_t paramsCount) noexcept;
+	tSQLQuery_t(const tSQLClient_t *const parent, void *handle, const size_t paramsCount) noexcept;
 	bool error(const int16_t err) const noexcept;
 	friend struct tSQLClient_t;
 
@@ -227,8 +357,13 @@ public:
 	 */
 	bool valid() const noexcept { return client && queryHandle; }
 	tSQLResult_t execute() const noexcept;
+	tSQLAsyncQuery_t executeAsync(void *event = nullptr) const noexcept;
 	template<typename T> void bind(const size_t index, const T &value, const fieldLength_t length) noexcept;
 	template<typename T> void bind(const size_t index, const std::nullptr_t, const fieldLength_t length) noexcept;
+	bool paramSets(size_t count) noexcept;
+	void paramSet(size_t set) noexcept;
+	size_t paramSetsCount() const noexcept { return setsCount; }
+	bool paramSetSucceeded(size_t set) const noexcept;
 	void swap(tSQLQuery_t &qry) noexcept;
 
 	/*! @brief Deleted copy constructor for tSQLQuery_t as prepared queries are not copyable */
@@ -245,12 +380,28 @@ private:
 	mutable bool haveConnection, needsCommit;
 	mutable tSQLExecError_t _error;
 
+	// A statement prepared by prepareCached(), kept around to be handed out again for the same query text
+	struct cachedQuery_t final
+	{
+		const void *queryStmt;
+		void *handle;
+		bool inUse;
+	};
+	mutable std::vector<cachedQuery_t> cachedQueries{};
+
+	void *allocStatement() const noexcept;
+	template<typename char_t> tSQLQuery_t prepareCachedQuery(const char_t *queryStmt, size_t paramsCount) const noexcept;
+	bool cacheQuery(const void *queryStmt, void *handle) const noexcept;
+	void releaseQuery(void *handle) const noexcept;
+	void dropCachedQueries() const noexcept;
+
 protected:
 	bool error(const int16_t err, const int16_t handleType, void *const handle) const noexcept;
 	bool error(const tSQLExecErrorType_t err, const int16_t handleType, void *const handle) const noexcept;
 	bool error(const tSQLExecErrorType_t err) const noexcept;
 	friend struct tSQLResult_t;
 	friend struct tSQLQuery_t;
+	friend struct tSQLAsyncQuery_t;
 
 public:
 	tSQLClient_t() noexcept;
@@ -270,7 +421,22 @@ public:
 	bool commit() const noexcept { return endTransact(true); }
 	bool rollback() const noexcept { return endTransact(false); }
 	tSQLResult_t query(const char *queryStmt) const noexcept;
+	tSQLResult_t query(const char16_t *queryStmt) const noexcept;
+	/*! @brief Overload so a nullptr query isn't ambiguous, always giving back an invalid result */
+	tSQLResult_t query(const std::nullptr_t) const noexcept { return {}; }
+	tSQLAsyncQuery_t queryAsync(const char *queryStmt, void *event = nullptr) const noexcept;
+	tSQLAsyncQuery_t queryAsync(const char16_t *queryStmt, void *event = nullptr) const noexcept;
+	/*! @brief Overload so a nullptr query isn't ambiguous, always giving back an invalid query */
+	tSQLAsyncQuery_t queryAsync(const std::nullptr_t, void * = nullptr) const noexcept { return {}; }
 	tSQLQuery_t prepare(const char *queryStmt, const size_t paramsCount) const noexcept;
+	tSQLQuery_t prepare(const char16_t *queryStmt, const size_t paramsCount) const noexcept;
+	/*! @brief Overload so a nullptr query isn't ambiguous, always giving back an invalid query */
+	tSQLQuery_t prepare(const std::nullptr_t, const size_t) const noexcept { return {}; }
+	tSQLQuery_t prepareCached(const char *queryStmt, const size_t paramsCount) const noexcept;
+	tSQLQuery_t prepareCached(const char16_t *queryStmt, const size_t paramsCount) const noexcept;
+	/*! @brief Overload so a nullptr query isn't ambiguous, always giving back an invalid query */
+	tSQLQuery_t prepareCached(const std::nullptr_t, const size_t) const noexcept { return {}; }
+	size_t cachedCount() const noexcept { return cachedQueries.size(); }
 	const tSQLExecError_t &error() const noexcept { return _error; }
 
 	/*! @brief Deleted copy constructor for tSQLClient_t as client connections are not copyable */
@@ -1,13 +1,16 @@
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 #ifndef _WINDOWS
 #include <unistd.h>
+#include <poll.h>
 #else
 #include <io.h>
 #endif
 #include <substrate/utility>
 #include "mysql.hxx"
 #include "value.hxx"
+#include "numeric.hxx"
 
 /*!
  * @internal
@@ -17,8 +20,10 @@
  * @brief C++ MySQL driver abstraction layer for handling client connections and query datasets
  */
 
-using substrate::vectorStateException_t;
 using namespace tmplORM::mysql::driver;
+using tmplORM::numeric::parseUint;
+using tmplORM::numeric::parseFloat;
+using tmplORM::numeric::parseDouble;
 
 // General documentation block (used to document mysql.hxx stuff cleanly
 /*!
@@ -47,6 +52,8 @@ MYSQL *mySQLClient_t::con = nullptr;
 uint32_t mySQLClient_t::handles = 0;
 /*! @brief Variable that defines if mySQLClient_t::con actually refers to a valid, connected, connection */
 bool mySQLClient_t::haveConnection = false;
+/*! @brief The parameters mySQLClient_t::con was connected with */
+mySQLConnectParams_t mySQLClient_t::connectParams{};
 
 /*! @brief Constant used for telling MySQL Client that we really want it to auto-reconnect */
 static const bool autoReconnect = true;
@@ -91,15 +98,7 @@ mySQLClient_t::~mySQLClient_t() noexcept
  * @returns true if the connection was successful (or pre-existing), false otherwise
  */
 bool mySQLClient_t::connect(const char *const host, const uint32_t port, const char *const user,
-	const char *const passwd) const noexcept
-{
-	if (haveConnection)
-		return true;
-	else if (!con)
-		return false;
-	haveConnection = mysql_real_connect(con, host, user, passwd, nullptr, port, nullptr, CLIENT_IGNORE_SIGPIPE) != nullptr;
-	return haveConnection;
-}
+	const char *const passwd) const noexcept { return connect(host, port, nullptr, user, passwd); }
 
 /*!
  * @brief Creates a connection based on a Unix Socket
@@ -109,12 +108,23 @@ bool mySQLClient_t::connect(const char *const host, const uint32_t port, const c
  * @returns true if the connection was successful (or pre-existing), false otherwise
  */
 bool mySQLClient_t::connect(const char *const unixSocket, const char *const user, const char *const passwd) const noexcept
+	{ return connect(nullptr, 0, unixSocket, user, passwd); }
+
+/*!
+ * @internal
+ * @brief Creates the client connection, keeping the parameters it was made with for any side connections
+ * @returns true if the connection was successful (or pre-existing), false otherwise
+ */
+bool mySQLClient_t::connect(const char *const host, const uint32_t port, const char *const unixSocket,
+	const char *const user, const char *const passwd) noexcept
 {
 	if (haveConnection)
 		return true;
 	else if (!con)
 		return false;
-	haveConnection = mysql_real_connect(con, nullptr, user, passwd, nullptr, 0, unixSocket, CLIENT_IGNORE_SIGPIPE) != nullptr;
+	haveConnection = mysql_real_connect(con, host, user, passwd, nullptr, port, unixSocket, CLIENT_IGNORE_SIGPIPE) != nullptr;
+	if (haveConnection)
+		connectParams = {stringDup(host), port, stringDup(unixSocket), stringDup(user), stringDup(passwd)};
 	return haveConnection;
 }
 
@@ -125,12 +135,22 @@ void mySQLClient_t::disconnect() noexcept
 	{
 		mysql_close(con);
 		haveConnection = false;
+		connectParams = {};
 		con = mysql_init(nullptr);
 		if (con)
 			mysql_options(con, MYSQL_OPT_RECONNECT, &autoReconnect);
 	}
 }
 
+/*!
+ * @brief Resets the session state of the current connection without reconnecting
+ * @details This drops any temporary tables, user variables and prepared statements, rolls back any open
+ *     transaction and releases any locks held, but keeps both the connection and selected database.
+ *     This makes the connection safe to hand to a new logical user without a TCP and authentication round trip.
+ * @returns true if the connection was reset, false otherwise
+ */
+bool mySQLClient_t::reset() const noexcept { return valid() && mysql_reset_connection(con) == 0; }
+
 /*!
  * @brief Select a database on the current MySQL server
  * @param db The database to select
@@ -161,12 +181,35 @@ bool mySQLClient_t::query(const char *const queryStmt, ...) const noexcept
  * @returns a mySQLResult_t that represents the result of the most recent query on the connection (if there is one)
  */
 mySQLResult_t mySQLClient_t::queryResult() const noexcept { return valid() ? mySQLResult_t(con) : mySQLResult_t(); }
+/*!
+ * @brief Gets the mySQLResult_t for any active query, streaming the rows from the server as they are fetched
+ * @details Unlike queryResult(), this does not pull the whole result set across the wire up front,
+ *     which allows large scans to be abandoned early with mySQLRow_t::cancel(). No other query may be
+ *     run on the connection until every row has been fetched or the scan cancelled, and numRows() only
+ *     counts the rows fetched so far.
+ * @returns a mySQLResult_t that represents the result of the most recent query on the connection (if there is one)
+ */
+mySQLResult_t mySQLClient_t::streamResult() const noexcept
+	{ return valid() ? mySQLResult_t{mysql_use_result(con), con} : mySQLResult_t{}; }
 /*!
  * @brief Construct a prepared query to run and return that
  * @returns a mySQLPreparedQuery_t that represents the query to run for further prep and execution
  */
 mySQLPreparedQuery_t mySQLClient_t::prepare(const char *const queryStmt, const size_t paramsCount) const noexcept
 	{ return valid() ? mySQLPreparedQuery_t(con, queryStmt, paramsCount) : mySQLPreparedQuery_t(); }
+/*!
+ * @brief Construct a prepared query to run that binds its parameters into pre-existing storage
+ * @param queryStmt The query statement to prepare
+ * @param binds The parameter binding set to use, normally from mySQLBindSlab_t::binds()
+ * @returns a mySQLPreparedQuery_t that represents the query to run for further prep and execution
+ */
+mySQLPreparedQuery_t mySQLClient_t::prepare(const char *const queryStmt, mySQLBind_t &&binds) const noexcept
+	{ return valid() ? mySQLPreparedQuery_t(con, queryStmt, std::move(binds)) : mySQLPreparedQuery_t(); }
+/*!
+ * @brief Construct a batch that statements can be queued into for execution in a single round trip
+ * @returns a mySQLBatch_t that represents the batch to build and then execute
+ */
+mySQLBatch_t mySQLClient_t::batch() const noexcept { return valid() ? mySQLBatch_t{con} : mySQLBatch_t{}; }
 /*!
  * @brief MySQL calls can result in an error outside this driver layer, this allows you to know what that error is if something fails
  * @returns The current MySQL errno error number code
@@ -178,6 +221,289 @@ uint32_t mySQLClient_t::errorNum() const noexcept { return con ? mysql_errno(con
  */
 const char *mySQLClient_t::error() const noexcept { return con ? mysql_error(con) : nullptr; }
 
+#ifdef tmplORM_MYSQL_NONBLOCKING
+/*!
+ * @internal
+ * @brief Creates a fresh connection handle that has been switched into non-blocking mode
+ * @returns The new connection handle, or nullptr if it could not be created
+ */
+static MYSQL *asyncInit() noexcept
+{
+	MYSQL *const con = mysql_init(nullptr);
+	// Passing nullptr here asks for the default stack size for the connection's co-routine
+	if (con && mysql_options(con, MYSQL_OPT_NONBLOCK, nullptr))
+	{
+		mysql_close(con);
+		return nullptr;
+	}
+	return con;
+}
+
+/*!
+ * @brief Constructs a fresh non-blocking MySQL client connection
+ * @details Unlike mySQLClient_t, each non-blocking client owns its own connection so that
+ *     many queries can be in flight at once from a single thread.
+ */
+mySQLAsyncClient_t::mySQLAsyncClient_t() noexcept : con{asyncInit()} { }
+
+/*!
+ * @brief Destructor for non-blocking client connections
+ * @note If still connected, this closes the connection using the blocking API.
+ *     Use disconnect() and drive it to completion to avoid this.
+ */
+mySQLAsyncClient_t::~mySQLAsyncClient_t() noexcept
+{
+	if (storedResult)
+		mysql_free_result(storedResult);
+	if (con)
+		mysql_close(con);
+}
+
+/*! @brief Swaps the contents of a non-blocking client connection with another */
+void mySQLAsyncClient_t::swap(mySQLAsyncClient_t &client) noexcept
+{
+	std::swap(con, client.con);
+	std::swap(operation, client.operation);
+	std::swap(waitStatus, client.waitStatus);
+	std::swap(queryError, client.queryError);
+	std::swap(connectResult, client.connectResult);
+	std::swap(storedResult, client.storedResult);
+	std::swap(haveConnection, client.haveConnection);
+	std::swap(_successful, client._successful);
+}
+
+/*!
+ * @internal
+ * @brief Records the state of a freshly started operation, completing it if it did not need to wait
+ * @param op The operation that was started
+ * @param status The MYSQL_WAIT_* status returned by the operation's _start() call
+ * @returns true, to indicate the operation was started
+ */
+bool mySQLAsyncClient_t::start(const mySQLAsyncOp_t op, const int status) noexcept
+{
+	operation = op;
+	waitStatus = status;
+	if (!waitStatus)
+		complete();
+	return true;
+}
+
+/*! @internal @brief Handles the result of the operation that just finished and returns the client to idle */
+void mySQLAsyncClient_t::complete() noexcept
+{
+	switch (operation)
+	{
+		case mySQLAsyncOp_t::connect:
+			haveConnection = connectResult != nullptr;
+			_successful = haveConnection;
+			break;
+		case mySQLAsyncOp_t::selectDB:
+		case mySQLAsyncOp_t::query:
+			_successful = !queryError;
+			break;
+		case mySQLAsyncOp_t::storeResult:
+			_successful = storedResult || !mysql_errno(con);
+			break;
+		case mySQLAsyncOp_t::close:
+			// The connection handle is freed by the close, so get a fresh one ready for the next connect()
+			haveConnection = false;
+			con = asyncInit();
+			_successful = true;
+			break;
+		case mySQLAsyncOp_t::none:
+			break;
+	}
+	operation = mySQLAsyncOp_t::none;
+	waitStatus = 0;
+}
+
+/*!
+ * @brief Starts creating a client connection based on a TCP/IP connection
+ * @param host The host string of the server housing the MySQL instance to connect to
+ * @param port The port number of the desired MySQL instance on the server to connect to
+ * @param user The user to connect in with
+ * @param passwd The password for the user to connect in with
+ * @returns true if the connection attempt was started, false otherwise
+ */
+bool mySQLAsyncClient_t::connect(const char *const host, const uint32_t port, const char *const user,
+	const char *const passwd) noexcept
+{
+	if (!con || haveConnection || pending())
+		return false;
+	return start(mySQLAsyncOp_t::connect, mysql_real_connect_start(&connectResult, con, host, user, passwd,
+		nullptr, port, nullptr, CLIENT_IGNORE_SIGPIPE));
+}
+
+/*!
+ * @brief Starts creating a connection based on a Unix Socket
+ * @param unixSocket The path to the Unix Socket of the MySQL instance to connect to
+ * @param user The user to connect in with
+ * @param passwd The password for the user to connect in with
+ * @returns true if the connection attempt was started, false otherwise
+ */
+bool mySQLAsyncClient_t::connect(const char *const unixSocket, const char *const user, const char *const passwd) noexcept
+{
+	if (!con || haveConnection || pending())
+		return false;
+	return start(mySQLAsyncOp_t::connect, mysql_real_connect_start(&connectResult, con, nullptr, user, passwd,
+		nullptr, 0, unixSocket, CLIENT_IGNORE_SIGPIPE));
+}
+
+/*!
+ * @brief Starts disconnecting from the current MySQL server
+ * @returns true if the disconnect was started, false otherwise
+ */
+bool mySQLAsyncClient_t::disconnect() noexcept
+{
+	if (!valid() || pending())
+		return false;
+	if (storedResult)
+	{
+		mysql_free_result(storedResult);
+		storedResult = nullptr;
+	}
+	return start(mySQLAsyncOp_t::close, mysql_close_start(con));
+}
+
+/*!
+ * @brief Starts selecting a database on the current MySQL server
+ * @param db The database to select
+ * @returns true if the selection was started, false otherwise
+ */
+bool mySQLAsyncClient_t::selectDB(const char *const db) noexcept
+{
+	if (!valid() || pending())
+		return false;
+	return start(mySQLAsyncOp_t::selectDB, mysql_select_db_start(&queryError, con, db));
+}
+
+/*!
+ * @brief Starts running a query
+ * @param queryStmt The query statement to run
+ * @returns true if the query was started, false otherwise
+ */
+bool mySQLAsyncClient_t::query(const char *const queryStmt) noexcept
+{
+	if (!valid() || pending() || !queryStmt)
+		return false;
+	return start(mySQLAsyncOp_t::query, mysql_real_query_start(&queryError, con, queryStmt, strlen(queryStmt)));
+}
+
+/*!
+ * @brief Starts transferring the result set of the last query to the client
+ * @details Once complete, the rows are held in memory and so can be walked via queryResult() without blocking.
+ * @returns true if the transfer was started, false otherwise
+ */
+bool mySQLAsyncClient_t::storeResult() noexcept
+{
+	if (!valid() || pending() || storedResult)
+		return false;
+	return start(mySQLAsyncOp_t::storeResult, mysql_store_result_start(&storedResult, con));
+}
+
+/*!
+ * @brief Gets the result set transferred by the last completed storeResult()
+ * @returns a mySQLResult_t that takes ownership of the stored result set (if there is one)
+ */
+mySQLResult_t mySQLAsyncClient_t::queryResult() noexcept
+{
+	if (pending())
+		return {};
+	mySQLResult_t result{storedResult};
+	storedResult = nullptr;
+	return result;
+}
+
+/*!
+ * @brief Continues the pending operation after the socket became ready
+ * @param events The MYSQL_WAIT_* events that occured, or MYSQL_WAIT_TIMEOUT if timeout() elapsed first
+ * @returns true if the pending operation has now completed, false if it still needs to wait
+ */
+bool mySQLAsyncClient_t::resume(const uint32_t events) noexcept
+{
+	const auto readyEvents = static_cast<int>(events);
+	switch (operation)
+	{
+		case mySQLAsyncOp_t::connect:
+			waitStatus = mysql_real_connect_cont(&connectResult, con, readyEvents);
+			break;
+		case mySQLAsyncOp_t::selectDB:
+			waitStatus = mysql_select_db_cont(&queryError, con, readyEvents);
+			break;
+		case mySQLAsyncOp_t::query:
+			waitStatus = mysql_real_query_cont(&queryError, con, readyEvents);
+			break;
+		case mySQLAsyncOp_t::storeResult:
+			waitStatus = mysql_store_result_cont(&storedResult, con, readyEvents);
+			break;
+		case mySQLAsyncOp_t::close:
+			waitStatus = mysql_close_cont(con, readyEvents);
+			break;
+		case mySQLAsyncOp_t::none:
+			return false;
+	}
+	if (waitStatus)
+		return false;
+	complete();
+	return true;
+}
+
+/*! @brief Returns the socket to wait for the events from waitEvents() on, for use with select(), poll() or epoll */
+int mySQLAsyncClient_t::socket() const noexcept { return con ? mysql_get_socket(con) : -1; }
+
+/*! @brief Returns how long in milliseconds to wait before resuming with MYSQL_WAIT_TIMEOUT, if waitEvents() includes it */
+uint32_t mySQLAsyncClient_t::timeout() const noexcept
+	{ return con && (waitStatus & MYSQL_WAIT_TIMEOUT) ? mysql_get_timeout_value_ms(con) : 0; }
+
+#ifndef _WINDOWS
+/*!
+ * @brief Translates waitEvents() into the equivalent poll() events
+ * @note The values match the EPOLL* equivalents on Linux, so this can also be used with epoll
+ */
+short mySQLAsyncClient_t::pollEvents() const noexcept
+{
+	short events{0};
+	if (waitStatus & MYSQL_WAIT_READ)
+		events |= POLLIN;
+	if (waitStatus & MYSQL_WAIT_WRITE)
+		events |= POLLOUT;
+	if (waitStatus & MYSQL_WAIT_EXCEPT)
+		events |= POLLPRI;
+	return events;
+}
+
+/*!
+ * @brief Continues the pending operation using the events returned by poll() or epoll
+ * @param events The events that occured on the socket, or 0 if the wait timed out
+ * @returns true if the pending operation has now completed, false if it still needs to wait
+ */
+bool mySQLAsyncClient_t::resumeFromPoll(const short events) noexcept
+{
+	uint32_t readyEvents{0};
+	if (events & (POLLIN | POLLHUP | POLLERR))
+		readyEvents |= MYSQL_WAIT_READ;
+	if (events & POLLOUT)
+		readyEvents |= MYSQL_WAIT_WRITE;
+	if (events & POLLPRI)
+		readyEvents |= MYSQL_WAIT_EXCEPT;
+	if (!events)
+		readyEvents = MYSQL_WAIT_TIMEOUT;
+	return resume(readyEvents);
+}
+#endif
+
+/*!
+ * @brief MySQL calls can result in an error outside this driver layer, this allows you to know what that error is if something fails
+ * @returns The current MySQL errno error number code
+ */
+uint32_t mySQLAsyncClient_t::errorNum() const noexcept { return con ? mysql_errno(con) : 0; }
+/*!
+ * @brief MySQL calls can result in an error outside this driver layer, this allows you to know the human readable error string
+ * @returns The current MySQL error string
+ */
+const char *mySQLAsyncClient_t::error() const noexcept { return con ? mysql_error(con) : nullptr; }
+#endif
+
 /*!
  * @internal
  * @brief Constructor for prepared queries from MySQL query statements
@@ -186,11 +512,21 @@ const char *mySQLClient_t::error() const noexcept { return con ? mysql_error(con
  * @param paramsCount The count of the number of parameters that the query statement contains
  */
 mySQLPreparedQuery_t::mySQLPreparedQuery_t(MYSQL *const con, const char *const queryStmt,
-	const size_t paramsCount) noexcept : query{mysql_stmt_init(con)}, params{paramsCount}
+	const size_t paramsCount) noexcept : mySQLPreparedQuery_t{con, queryStmt, mySQLBind_t{paramsCount}} { }
+
+/*!
+ * @internal
+ * @brief Constructor for prepared queries from MySQL query statements, binding parameters into the given storage
+ * @param con The connection for which to prepare the query against
+ * @param queryStmt The query statement to prepare
+ * @param binds The parameter binding set to bind the query's parameters into
+ */
+mySQLPreparedQuery_t::mySQLPreparedQuery_t(MYSQL *const con, const char *const queryStmt,
+	mySQLBind_t &&binds) noexcept : query{mysql_stmt_init(con)}, params{std::move(binds)}
 {
-	if (!query || !params.valid())
+	if (!query)
 		return;
-	if (mysql_stmt_prepare(query, queryStmt, strlen(queryStmt) + 1) != 0)
+	if (!params.valid() || mysql_stmt_prepare(query, queryStmt, strlen(queryStmt) + 1) != 0)
 		dtor();
 }
 
@@ -244,6 +580,20 @@ bool mySQLPreparedQuery_t::execute() noexcept
 	return executed;
 }
 
+/*!
+ * @brief Resets the prepared query so it can be executed again
+ * @details Any parameters must be rebound before the next execution, which for queries prepared against
+ *     a mySQLBindSlab_t can be done without making any allocations.
+ * @returns true if the query could be reset, false otherwise
+ */
+bool mySQLPreparedQuery_t::reset() noexcept
+{
+	if (!valid() || mysql_stmt_free_result(query) || mysql_stmt_reset(query))
+		return false;
+	executed = false;
+	return true;
+}
+
 /*!
  * @brief MySQL calls can result in an error outside this driver layer, this allows you to know what that error is if something fails
  * @returns The current MySQL errno error number code
@@ -285,43 +635,293 @@ void mySQLPreparedResult_t::fetchColumn(const size_t index) const noexcept
 	mysql_stmt_fetch_column(query, columns.data() + index, static_cast<uint32_t>(index), 0);
 }
 
-mySQLBind_t::mySQLBind_t(mySQLBind_t &&binds) noexcept : mySQLBind_t{} { *this = std::move(binds); }
+/*!
+ * @internal
+ * @brief Constructor for batch statements from MySQL query statements
+ * @param _con The connection against which string literals for the statement get escaped
+ * @param _queryStmt The query statement to build, containing a ? for each parameter
+ * @param paramsCount The count of the number of parameters that the query statement contains
+ */
+mySQLBatchStatement_t::mySQLBatchStatement_t(MYSQL *const _con, const char *const _queryStmt,
+	const size_t paramsCount) noexcept : con{_con}, queryStmt{_queryStmt}, literals{paramsCount}, numParams{paramsCount} { }
 
-void mySQLBind_t::resetParams() noexcept try
+/*! @brief Swaps the contents of a batch statement object with another */
+void mySQLBatchStatement_t::swap(mySQLBatchStatement_t &stmt) noexcept
 {
-	for (size_t i = 0; i < numParams; ++i)
-		params[i].buffer_type = MYSQL_TYPE_NULL;
+	std::swap(con, stmt.con);
+	std::swap(queryStmt, stmt.queryStmt);
+	literals.swap(stmt.literals);
+	std::swap(numParams, stmt.numParams);
 }
-catch (const vectorStateException_t &error)
+
+/*!
+ * @brief Renders a floating point value as an SQL literal, independent of the current locale
+ * @param value The value to render
+ * @param digits The number of significant digits needed to round-trip the value's type
+ * @returns the literal, or nullptr if the value is infinite or NaN as SQL has no literals for those
+ */
+std::unique_ptr<const char []> tmplORM::mysql::driver::floatLiteral(const double value, const int digits) noexcept
 {
-	const std::string desc{"tmplORM FATAL: Failed to allocate parameters - "_s};
-	const std::string what{error.what()};
-	write(STDERR_FILENO, desc.data(), desc.size());
-	write(STDERR_FILENO, what.data(), what.size());
-	write(STDERR_FILENO, "\n", 1);
-	std::terminate();
+	if (!std::isfinite(value))
+		return nullptr;
+	std::array<char, 48> number{};
+	const int length = snprintf(number.data(), number.size(), "%.*g", digits, value);
+	if (length < 0 || size_t(length) >= number.size())
+		return nullptr;
+	// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+	auto literal = substrate::make_unique_nothrow<char []>(size_t(length) + 1U);
+	if (!literal)
+		return nullptr;
+	// printf() writes the LC_NUMERIC locale's decimal point, which can be a comma or even several bytes long.
+	// Everything else it writes for %g is ASCII digits, signs and the exponent marker, so swap that for a '.'
+	size_t offset{0};
+	for (size_t i{0}; i < size_t(length); ++i)
+	{
+		const char chr = number[i];
+		if (tmplORM::numeric::isDigit(chr) || chr == '-' || chr == '+' || chr == 'e')
+			literal[offset++] = chr;
+		else if (!offset || literal[offset - 1] != '.')
+			literal[offset++] = '.';
+	}
+	literal[offset] = 0;
+	// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+	return std::unique_ptr<const char []>{literal.release()};
 }
-catch (const std::out_of_range &error)
+
+/*!
+ * @internal
+ * @brief Stores the rendered SQL literal for a parameter of the statement
+ * @param index The index of the parameter to store the literal for
+ * @param value The SQL literal text for the parameter
+ */
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+void mySQLBatchStatement_t::literal(const size_t index, std::unique_ptr<const char []> &&value) noexcept
 {
-	const std::string desc{"tmplORM FATAL: Indexing failure - "_s};
-	const std::string what{error.what()};
-	write(STDERR_FILENO, desc.data(), desc.size());
-	write(STDERR_FILENO, what.data(), what.size());
-	write(STDERR_FILENO, "\n", 1);
-	std::terminate();
+	if (index >= numParams)
+		return;
+	literals[index] = std::move(value);
 }
 
-mySQLBind_t::mySQLBind_t(const size_t paramsCount) noexcept : params{paramsCount}, paramStorage{paramsCount}, numParams{paramsCount}
+/*!
+ * @internal
+ * @brief Escapes a string parameter using the connection's character set and stores it as a quoted SQL literal
+ * @param index The index of the parameter to store the literal for
+ * @param value The string to escape
+ * @param length The length of the string to escape
+ */
+void mySQLBatchStatement_t::quote(const size_t index, const char *const value, const size_t length) noexcept
 {
-	if (!params.valid())
+	if (index >= numParams || !value)
 		return;
+	// Escaping can at worst double the string, and we need room for the quotes and the NUL terminator
+	// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+	auto str = substrate::make_unique_nothrow<char []>((length * 2) + 3);
+	if (!str)
+		return;
+	str[0] = '\'';
+	const sql_ulong_t escapedLength = mysql_real_escape_string(con, str.get() + 1, value, length);
+	if (escapedLength == sql_ulong_t(-1))
+		return;
+	str[escapedLength + 1] = '\'';
+	str[escapedLength + 2] = 0;
+	// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+	literal(index, std::unique_ptr<const char []>{str.release()});
+}
+
+/*!
+ * @internal
+ * @brief Constructor for batches of MySQL query statements
+ * @param _con The connection on which the batch will be executed
+ */
+mySQLBatch_t::mySQLBatch_t(MYSQL *const _con) noexcept : con{_con} { }
+
+/*! @brief Swaps the contents of a batch object with another */
+void mySQLBatch_t::swap(mySQLBatch_t &batch) noexcept
+{
+	std::swap(con, batch.con);
+	queryText.swap(batch.queryText);
+	std::swap(statements, batch.statements);
+	results.swap(batch.results);
+	std::swap(numResults, batch.numResults);
+	std::swap(_errorNum, batch._errorNum);
+	_error.swap(batch._error);
+}
+
+/*!
+ * @brief Construct a statement to bind parameters to for adding to this batch
+ * @param queryStmt The query statement to build, containing a ? for each parameter
+ * @param paramsCount The count of the number of parameters that the query statement contains
+ * @returns a mySQLBatchStatement_t that represents the statement for binding and then adding to the batch
+ */
+mySQLBatchStatement_t mySQLBatch_t::prepare(const char *const queryStmt, const size_t paramsCount) const noexcept
+	{ return valid() && queryStmt ? mySQLBatchStatement_t{con, queryStmt, paramsCount} : mySQLBatchStatement_t{}; }
+
+/*!
+ * @internal
+ * @brief Appends a single statement to the text of the batch, terminating it with a ; if it is not already
+ * @returns true if the statement could be appended, false otherwise
+ */
+bool mySQLBatch_t::append(const char *const queryStmt, const size_t length) noexcept
+{
+	const size_t textLength = queryText.size();
+	try
+	{
+		queryText.append(queryStmt, length);
+		if (!length || queryStmt[length - 1] != ';')
+			queryText += ';';
+	}
+	catch (const std::bad_alloc &)
+	{
+		queryText.resize(textLength);
+		return false;
+	}
+	++statements;
+	return true;
+}
+
+/*!
+ * @brief Adds a bound statement to the batch, substituting each ? for the literal bound to it
+ * @param statement The statement to add, which must have all of its parameters bound
+ * @returns true if the statement was added, false otherwise
+ */
+bool mySQLBatch_t::add(const mySQLBatchStatement_t &statement) noexcept try
+{
+	if (!valid() || !statement.valid() || statement.con != con)
+		return false;
+	std::string query{};
+	size_t param{0};
+	char quote{0};
+	for (const char *chr = statement.queryStmt; *chr; ++chr)
+	{
+		// Placeholders inside quoted names and strings are not parameters, so copy those through untouched
+		if (quote)
+		{
+			if (*chr == quote)
+				quote = 0;
+			else if (*chr == '\\' && quote != '`' && chr[1])
+				query += *chr++;
+		}
+		else if (*chr == '`' || *chr == '\'' || *chr == '"')
+			quote = *chr;
+		else if (*chr == '?')
+		{
+			if (param == statement.numParams || !statement.literals[param])
+				return false;
+			query += statement.literals[param++].get();
+			continue;
+		}
+		query += *chr;
+	}
+	if (param != statement.numParams)
+		return false;
+	return append(query.data(), query.size());
+}
+catch (const std::bad_alloc &)
+	{ return false; }
+
+/*!
+ * @brief Adds a complete statement that requires no parameters to the batch
+ * @param queryStmt The statement to add
+ * @returns true if the statement was added, false otherwise
+ */
+bool mySQLBatch_t::add(const char *const queryStmt) noexcept
+	{ return valid() && queryStmt && append(queryStmt, strlen(queryStmt)); }
+
+/*!
+ * @brief Executes every statement in the batch as a single multi-statement query
+ * @details Multi-statement support is only turned on for the connection for the duration of the
+ *     batch so that everything else keeps MySQL's single-statement protection. All results are
+ *     drained via mysql_next_result(), leaving the connection ready for the next query.
+ *     MySQL stops executing the batch at the first failing statement, so that statement and every
+ *     statement after it is reported as having failed.
+ * @returns true if every statement in the batch succeeded, false otherwise
+ */
+bool mySQLBatch_t::execute() noexcept
+{
+	if (!valid() || !statements)
+		return false;
+	fixedVector_t<bool> status{statements};
+	if (!status.valid() || mysql_set_server_option(con, MYSQL_OPTION_MULTI_STATEMENTS_ON))
+		return false;
+
+	// mysql_next_result() uses -1 to signal the end of the results, so map any failure here to a positive value
+	int result = mysql_real_query(con, queryText.data(), queryText.size()) ? 1 : 0;
+	for (size_t index{0}; !result; ++index)
+	{
+		if (index < statements)
+			status[index] = true;
+		// Any statement that generates a result set must have it consumed before we can move on
+		MYSQL_RES *const res = mysql_store_result(con);
+		if (res)
+			mysql_free_result(res);
+		result = mysql_next_result(con);
+	}
+	_errorNum = mysql_errno(con);
+	_error = _errorNum ? stringDup(mysql_error(con)) : nullptr;
+	mysql_set_server_option(con, MYSQL_OPTION_MULTI_STATEMENTS_OFF);
+
+	results.swap(status);
+	numResults = statements;
+	return result == -1;
+}
+
+/*! @brief Empties the batch so it can be reused to build a new set of statements */
+void mySQLBatch_t::clear() noexcept
+{
+	queryText.clear();
+	statements = 0;
+}
+
+/*!
+ * @brief Call to determine if a given statement succeeded when the batch was last executed
+ * @param index The index of the statement in the order it was added to the batch
+ * @returns true if the statement succeeded, false if it failed or was not run
+ */
+bool mySQLBatch_t::succeeded(const size_t index) const noexcept
+	{ return index < numResults && results[index]; }
+
+mySQLBind_t::mySQLBind_t(mySQLBind_t &&binds) noexcept : mySQLBind_t{} { *this = std::move(binds); }
+
+/*! @internal @brief Marks every parameter as NULL-typed until something gets bound to it */
+void mySQLBind_t::resetParams() noexcept
+{
+	for (size_t i = 0; i < numParams; ++i)
+		params[i].buffer_type = MYSQL_TYPE_NULL;
+}
+
+/*!
+ * @internal
+ * @brief Constructs a parameter binding set that owns its own storage
+ * @param paramsCount The number of parameters to allocate storage for
+ */
+mySQLBind_t::mySQLBind_t(const size_t paramsCount) noexcept : ownedParams{paramsCount}, ownedStorage{paramsCount},
+	params{ownedParams.data()}, paramStorage{ownedStorage.data()}, numParams{paramsCount}
+{
+	if (!ownedParams.valid() || !ownedStorage.valid())
+	{
+		params = nullptr;
+		paramStorage = nullptr;
+		return;
+	}
 	resetParams();
 }
 
+/*!
+ * @internal
+ * @brief Constructs a parameter binding set over externally owned storage, such as a mySQLBindSlab_t
+ * @param _params The MYSQL_BIND structures to use for the parameters
+ * @param storage The storage to use for any parameters that must be converted for binding
+ * @param paramsCount The number of parameters the storage is for
+ */
+mySQLBind_t::mySQLBind_t(MYSQL_BIND *const _params, mySQLParamStorage_t *const storage, const size_t paramsCount) noexcept :
+	params{paramsCount ? _params : nullptr}, paramStorage{storage}, numParams{paramsCount} { resetParams(); }
+
 void mySQLBind_t::operator =(mySQLBind_t &&binds) noexcept
 {
-	params.swap(binds.params);
-	paramStorage.swap(binds.paramStorage);
+	ownedParams.swap(binds.ownedParams);
+	ownedStorage.swap(binds.ownedStorage);
+	std::swap(params, binds.params);
+	std::swap(paramStorage, binds.paramStorage);
 	std::swap(numParams, binds.numParams);
 }
 
@@ -335,13 +935,19 @@ mySQLResult_t::mySQLResult_t(MYSQL *const con) noexcept : result(mysql_store_res
  * @brief Move constructor for the results of a MySQL query
  * @param res The original result object who's results we will make our own in trade
  */
-mySQLResult_t::mySQLResult_t(mySQLResult_t &&res) noexcept : mySQLResult_t() { std::swap(result, res.result); }
+mySQLResult_t::mySQLResult_t(mySQLResult_t &&res) noexcept : mySQLResult_t()
+{
+	std::swap(result, res.result);
+	std::swap(con, res.con);
+}
 
 // General documentation block for mySQLResult_t
 /*!
  * @internal
  * @var mySQLResult_t::result
  * @brief The MYSQL_RES result pointer for this result object (or nullptr if invalid)
+ * @var mySQLResult_t::con
+ * @brief The connection the rows are being streamed from for streamed results (or nullptr if the result is buffered)
  */
 
 /*! @brief Destructor for MySQL result objects */
@@ -358,24 +964,27 @@ mySQLResult_t::~mySQLResult_t() noexcept
 mySQLResult_t &mySQLResult_t::operator =(mySQLResult_t &&res) noexcept
 {
 	std::swap(result, res.result);
+	std::swap(con, res.con);
 	return *this;
 }
 
 /*! @brief Returns the number of rows this result object represents, or 0 if this is an invalid result object */
 uint64_t mySQLResult_t::numRows() const noexcept { return valid() ? mysql_num_rows(result) : 0; }
 /*! @brief Creates a row object representing result rows for this result object */
-mySQLRow_t mySQLResult_t::resultRows() const noexcept { return valid() ? mySQLRow_t{result} : mySQLRow_t{}; }
+mySQLRow_t mySQLResult_t::resultRows() const noexcept { return valid() ? mySQLRow_t{result, con} : mySQLRow_t{}; }
 /*!
  * @internal
  * @brief Constructor for the result rows from a MySQL query
  * @param result The result from which to fetch the result rows from
+ * @param con The connection the result is being streamed from, or nullptr if it is buffered
  */
-mySQLRow_t::mySQLRow_t(MYSQL_RES *res) noexcept : result{res} { fetch(); }
+mySQLRow_t::mySQLRow_t(MYSQL_RES *res, MYSQL *const _con) noexcept : result{res}, con{_con} { fetch(); }
 
 /*! @brief Swaps the contents of a result rows object with another for a MySQL query */
 void mySQLRow_t::swap(mySQLRow_t &r) noexcept
 {
 	std::swap(result, r.result);
+	std::swap(con, r.con);
 	std::swap(row, r.row);
 	std::swap(fields, r.fields);
 	std::swap(rowLengths, r.rowLengths);
@@ -384,10 +993,62 @@ void mySQLRow_t::swap(mySQLRow_t &r) noexcept
 
 /*!
  * @brief Destroys a result rows object, ensuring that no rows are left to fetch
- * @note This may not actually be required - maybe we can get away with invalidating the result set rather than expensively processing our way through any remaining rows?
+ * @note For streamed results this pulls any remaining rows across the wire - use cancel() first to
+ *     abandon a large scan early without paying for the full transfer.
  */
 mySQLRow_t::~mySQLRow_t() noexcept { while (row) fetch(); }
 
+/*! @brief How long, in seconds, a side connection gets to connect and answer before the kill is given up on */
+static const uint32_t killTimeout = 5;
+
+/*!
+ * @internal
+ * @brief Interrupts the query running on a connection by issuing a KILL QUERY for it from a side connection
+ * @details The side connection is made using the same server and credentials as the connection being interrupted.
+ * @param con The connection running the query to interrupt
+ * @param params The parameters that connection was made with
+ * @returns true if the query was successfully killed, false otherwise
+ */
+static bool killQuery(MYSQL *const con, const mySQLConnectParams_t &params) noexcept
+{
+	MYSQL *const side = mysql_init(nullptr);
+	if (!side)
+		return false;
+	mysql_options(side, MYSQL_OPT_CONNECT_TIMEOUT, &killTimeout);
+	mysql_options(side, MYSQL_OPT_READ_TIMEOUT, &killTimeout);
+	const bool connected = mysql_real_connect(side, params.host.get(), params.user.get(), params.passwd.get(), nullptr,
+		params.port, params.unixSocket.get(), CLIENT_IGNORE_SIGPIPE) != nullptr;
+	const auto query = formatString("KILL QUERY %lu", mysql_thread_id(con));
+	const bool killed = connected && query && mysql_query(side, query.get()) == 0;
+	mysql_close(side);
+	return killed;
+}
+
+/*!
+ * @brief Abandons any rows of the result set that have not yet been fetched
+ * @details Buffered results are already entirely client side, so this just stops iteration. For streamed
+ *     results, up to drainLimit rows are fetched and discarded in the hope that the result set ends -
+ *     past that, the query is killed from a side connection so the rest of the result set never gets sent.
+ *     Either way the connection remains usable afterwards.
+ * @param drainLimit The number of rows to drain before resorting to killing the query
+ * @returns true if the remaining rows were abandoned, false if they had to be fetched in full
+ */
+bool mySQLRow_t::cancel(const uint64_t drainLimit) noexcept
+{
+	if (!con)
+	{
+		row = nullptr;
+		return true;
+	}
+	for (uint64_t i = 0; row && i < drainLimit; ++i)
+		fetch();
+	const bool cancelled = !row || killQuery(con, mySQLClient_t::connectParams);
+	// Whatever was already in flight when the query was killed still has to be read off the connection
+	while (row)
+		fetch();
+	return cancelled;
+}
+
 /*!
  * @internal
  * @brief Fetches the next result row for this result set, or sets row to nullptr if there are no results left
@@ -439,8 +1100,6 @@ mySQLValue_t mySQLRow_t::operator [](const uint32_t idx) const noexcept
 	return {row[idx], rowLengths[idx], fieldTypes[idx]};
 }
 
-/*! @internal @brief Returns a boolean indicating if the given character is a number of not */
-inline bool isNumber(const char x) noexcept { return x >= '0' && x <= '9'; }
 /*! @internal @brief Returns a boolean indicating if the given character is a '-' or not */
 inline bool isMinus(const char x) noexcept { return x == '-'; }
 
@@ -507,27 +1166,19 @@ bool mySQLValue_t::asBool(const uint8_t bit) const
 template<typename T, mySQLErrorType_t errorType> valueOrError_t<T, mySQLValueError_t>
 	checkedConvertInt(const char *const data, const uint64_t len) noexcept
 {
-	using UT = typename std::make_unsigned<T>::type;
-	using U = substrate::promoted_type_t<UT>;
 	if (!len)
 		return 0;
 	const bool sign = std::is_signed<T>::value && isMinus(data[0]);
 	const uint64_t numLen = data[len - 1] ? len : len - 1;
-	U preNum = 0;
-	U num = 0;
-	for (uint64_t i = 0; i < numLen; ++i)
-	{
-		if (sign && i == 0)
-			continue;
-		else if (!isNumber(data[i]))
-			return mySQLValueError_t{errorType};
-		num *= 10U;
-		if ((num / 10U) < preNum)
-			return mySQLValueError_t{errorType};
-		preNum = num;
-		num += static_cast<U>(data[i] - '0');
-	}
-	if (static_cast<UT>(num) < preNum)
+	const uint64_t offset = sign ? 1U : 0U;
+	if (numLen <= offset)
+		return 0;
+	uint64_t num{};
+	if (!parseUint(data + offset, numLen - offset, num))
+		return mySQLValueError_t{errorType};
+	// Negative values may go one further than positive ones for signed types
+	const uint64_t limit = uint64_t(std::numeric_limits<T>::max()) + offset;
+	if (num > limit)
 		return mySQLValueError_t{errorType};
 	else if (sign)
 		return static_cast<T>(~num + 1U);
@@ -638,18 +1289,32 @@ int64_t mySQLValue_t::asInt64() const
 	return num;
 }
 
+/*!
+ * @throws mySQLValueError_t
+ */
 float mySQLValue_t::asFloat() const
 {
 	if (isNull() || type != MYSQL_TYPE_FLOAT)
 		throw mySQLValueError_t(mySQLErrorType_t::floatError);
-	return strtof(data, nullptr);
+	const uint64_t numLen = len && !data[len - 1] ? len - 1 : len;
+	float value{};
+	if (numLen && !parseFloat(data, numLen, value))
+		throw mySQLValueError_t(mySQLErrorType_t::floatError);
+	return value;
 }
 
+/*!
+ * @throws mySQLValueError_t
+ */
 double mySQLValue_t::asDouble() const
 {
 	if (isNull() || type != MYSQL_TYPE_DOUBLE)
 		throw mySQLValueError_t(mySQLErrorType_t::doubleError);
-	return strtod(data, nullptr);
+	const uint64_t numLen = len && !data[len - 1] ? len - 1 : len;
+	double value{};
+	if (numLen && !parseDouble(data, numLen, value))
+		throw mySQLValueError_t(mySQLErrorType_t::doubleError);
+	return value;
 }
 
 ormDate_t mySQLValue_t::asDate() const
@@ -696,8 +1361,15 @@ valueOrError_t<ormUUID_t, mySQLValueError_t> checkedConvertUUID(const char *cons
  */
 ormUUID_t mySQLValue_t::asUUID() const
 {
-	if (isNull() || type != MYSQL_TYPE_STRING || len != 32)
+	if (isNull() || type != MYSQL_TYPE_STRING || (len != 32 && len != sizeof(guid_t)))
 		throw mySQLValueError_t(mySQLErrorType_t::dateTimeError);
+	// BINARY(16) fields hold the raw big-endian bytes of the UUID
+	if (len == sizeof(guid_t))
+	{
+		ormUUID_t uuid{};
+		memcpy(uuid.asPointer(), data, sizeof(guid_t));
+		return uuid;
+	}
 	auto uuid = checkedConvertUUID(data);
 	if (uuid.isError())
 		throw uuid.error();
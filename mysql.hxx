@@ -3,7 +3,9 @@
 
 #include <cstdint>
 #include <mysql.h>
+#include <array>
 #include <utility>
+#include <string>
 #include <substrate/managed_ptr>
 #include "tmplORM.hxx"
 
@@ -27,6 +29,8 @@ using mySQLFieldType_t = enum enum_field_types;
 using namespace tmplORM::types::baseTypes;
 using tmplORM::common::fieldLength_t;
 tmplORM_FNAPI const char nullParam;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+tmplORM_FNAPI std::unique_ptr<const char []> floatLiteral(double value, int digits) noexcept;
 
 struct tmplORM_API mySQLValue_t final
 {
@@ -106,13 +110,14 @@ struct tmplORM_API mySQLRow_t final
 {
 private:
 	MYSQL_RES *result{nullptr};
+	MYSQL *con{nullptr};
 	MYSQL_ROW row{nullptr};
 	uint32_t fields{0};
 	sql_ulong_t *rowLengths{nullptr};
 	// fixedVector_t?
 	std::unique_ptr<mySQLFieldType_t []> fieldTypes{};
 
-	mySQLRow_t(MYSQL_RES *const result) noexcept;
+	mySQLRow_t(MYSQL_RES *const result, MYSQL *const con) noexcept;
 	void fetch() noexcept;
 	friend struct mySQLResult_t;
 
@@ -129,6 +134,7 @@ public:
 	bool valid() const noexcept { return row && rowLengths && fieldTypes; }
 	uint32_t numFields() const noexcept;
 	bool next() noexcept;
+	bool cancel(const uint64_t drainLimit = 1024) noexcept;
 	mySQLValue_t operator [](const uint32_t idx) const noexcept;
 	void swap(mySQLRow_t &row) noexcept;
 
@@ -144,10 +150,13 @@ struct tmplORM_API mySQLResult_t final
 {
 private:
 	MYSQL_RES *result{nullptr};
+	MYSQL *con{nullptr};
 
 protected:
 	mySQLResult_t(MYSQL *const con) noexcept;
+	mySQLResult_t(MYSQL_RES *const res, MYSQL *const streamCon = nullptr) noexcept : result{res}, con{streamCon} { }
 	friend struct mySQLClient_t;
+	friend struct mySQLAsyncClient_t;
 
 public:
 	/*! @brief Default constructor for result objects, constructing invalid result objects by default */
@@ -169,19 +178,34 @@ public:
 	mySQLResult_t &operator =(const mySQLResult_t &) = delete;
 };
 
+/*! @brief Inline storage for a single parameter, large enough to hold any value that must be converted for binding */
+union mySQLParamStorage_t
+{
+	int64_t integer;
+	double decimal;
+	MYSQL_TIME dateTime;
+	std::array<char, 32> uuid;
+};
+
+template<size_t> struct mySQLBindSlab_t;
+
 struct mySQLBind_t final
 {
 private:
-	fixedVector_t<MYSQL_BIND> params{};
-	fixedVector_t<substrate::managedPtr_t<void>> paramStorage{};
+	fixedVector_t<MYSQL_BIND> ownedParams{};
+	fixedVector_t<mySQLParamStorage_t> ownedStorage{};
+	MYSQL_BIND *params{nullptr};
+	mySQLParamStorage_t *paramStorage{nullptr};
 	size_t numParams{0};
 
 	void resetParams() noexcept;
 
 protected:
 	mySQLBind_t(const size_t paramsCount) noexcept;
+	mySQLBind_t(MYSQL_BIND *const params, mySQLParamStorage_t *const storage, const size_t paramsCount) noexcept;
 	friend struct mySQLPreparedResult_t;
 	friend struct mySQLPreparedQuery_t;
+	template<size_t> friend struct mySQLBindSlab_t;
 
 public:
 	mySQLBind_t() noexcept = default;
@@ -190,8 +214,8 @@ public:
 	void operator =(mySQLBind_t && binds) noexcept;
 
 	bool valid() const noexcept { return !numParams || params; }
-	bool haveData() const noexcept { return params.valid(); }
-	MYSQL_BIND *data() const noexcept { return params.data(); }
+	bool haveData() const noexcept { return params; }
+	MYSQL_BIND *data() const noexcept { return params; }
 	template<typename T> void bindIn(const size_t index, const T &value, const fieldLength_t length) noexcept;
 	template<typename T> void bindIn(const size_t index, const nullptr_t, const fieldLength_t length) noexcept;
 	template<typename T> void bindOut(const size_t index, const fieldLength_t length) noexcept;
@@ -201,6 +225,28 @@ public:
 	mySQLBind_t &operator =(const mySQLBind_t &) = delete;
 };
 
+/*!
+ * @brief Fixed, inline storage for the parameters of a prepared query with a compile-time known parameter count
+ * @details Preparing a query against a slab rather than a parameter count means that binding the
+ *     parameters makes no allocations, and the slab can be rebound for every execution of the query.
+ *     The slab must outlive any query prepared against it.
+ */
+template<size_t N> struct mySQLBindSlab_t final
+{
+private:
+	std::array<MYSQL_BIND, N> params{};
+	std::array<mySQLParamStorage_t, N> storage{};
+
+public:
+	mySQLBindSlab_t() noexcept = default;
+	mySQLBind_t binds() noexcept { return {params.data(), storage.data(), N}; }
+
+	mySQLBindSlab_t(const mySQLBindSlab_t &) = delete;
+	mySQLBindSlab_t(mySQLBindSlab_t &&) = delete;
+	mySQLBindSlab_t &operator =(const mySQLBindSlab_t &) = delete;
+	mySQLBindSlab_t &operator =(mySQLBindSlab_t &&) = delete;
+};
+
 struct tmplORM_API mySQLPreparedResult_t final
 {
 private:
@@ -243,6 +289,7 @@ private:
 
 protected:
 	mySQLPreparedQuery_t(MYSQL *con, const char *queryStmt, size_t paramsCount) noexcept;
+	mySQLPreparedQuery_t(MYSQL *con, const char *queryStmt, mySQLBind_t &&binds) noexcept;
 	friend struct mySQLClient_t;
 
 public:
@@ -257,6 +304,7 @@ public:
 	 */
 	bool valid() const noexcept { return query; }
 	bool execute() noexcept;
+	bool reset() noexcept;
 	uint64_t rowID() const noexcept;
 	template<typename T> void bind(size_t index, const T &value, fieldLength_t length) noexcept
 		{ params.bindIn(index, value, length); }
@@ -272,12 +320,120 @@ public:
 	mySQLPreparedQuery_t &operator =(const mySQLPreparedQuery_t &) = delete;
 };
 
+struct tmplORM_API mySQLBatchStatement_t final
+{
+private:
+	MYSQL *con{nullptr};
+	const char *queryStmt{nullptr};
+	// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+	fixedVector_t<std::unique_ptr<const char []>> literals{};
+	size_t numParams{0};
+
+	// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+	void literal(const size_t index, std::unique_ptr<const char []> &&value) noexcept;
+	void quote(const size_t index, const char *const value, const size_t length) noexcept;
+
+protected:
+	mySQLBatchStatement_t(MYSQL *const con, const char *const queryStmt, const size_t paramsCount) noexcept;
+	friend struct mySQLBatch_t;
+
+public:
+	/*! @brief Default constructor for batch statement objects, constructing an invalid statement by default */
+	mySQLBatchStatement_t() noexcept = default;
+	mySQLBatchStatement_t(mySQLBatchStatement_t &&stmt) noexcept : mySQLBatchStatement_t{} { swap(stmt); }
+	~mySQLBatchStatement_t() noexcept = default;
+	void operator =(mySQLBatchStatement_t &&stmt) noexcept { swap(stmt); }
+	/*!
+	 * @brief Call to determine if this batch statement object is valid
+	 * @returns true if the object is valid, false otherwise
+	 */
+	bool valid() const noexcept { return con && queryStmt && (!numParams || literals.valid()); }
+	template<typename T> void bind(const size_t index, const T &value, const fieldLength_t length) noexcept;
+	template<typename T> void bind(const size_t index, const nullptr_t, const fieldLength_t length) noexcept;
+	size_t count() const noexcept { return numParams; }
+	void swap(mySQLBatchStatement_t &stmt) noexcept;
+
+	/*! @brief Deleted copy constructor for mySQLBatchStatement_t as batch statements are not copyable */
+	mySQLBatchStatement_t(const mySQLBatchStatement_t &) = delete;
+	/*! @brief Deleted copy assignment operator for mySQLBatchStatement_t as batch statements are not copyable */
+	mySQLBatchStatement_t &operator =(const mySQLBatchStatement_t &) = delete;
+};
+
+struct tmplORM_API mySQLBatch_t final
+{
+private:
+	MYSQL *con{nullptr};
+	std::string queryText{};
+	size_t statements{0};
+	fixedVector_t<bool> results{};
+	size_t numResults{0};
+	uint32_t _errorNum{0};
+	// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+	std::unique_ptr<char []> _error{};
+
+	bool append(const char *const queryStmt, const size_t length) noexcept;
+
+protected:
+	mySQLBatch_t(MYSQL *const con) noexcept;
+	friend struct mySQLClient_t;
+
+public:
+	/*! @brief Default constructor for batch objects, constructing an invalid batch by default */
+	mySQLBatch_t() noexcept = default;
+	mySQLBatch_t(mySQLBatch_t &&batch) noexcept : mySQLBatch_t{} { swap(batch); }
+	~mySQLBatch_t() noexcept = default;
+	void operator =(mySQLBatch_t &&batch) noexcept { swap(batch); }
+	/*!
+	 * @brief Call to determine if this batch object is valid
+	 * @returns true if the object is valid, false otherwise
+	 */
+	bool valid() const noexcept { return con; }
+	mySQLBatchStatement_t prepare(const char *const queryStmt, const size_t paramsCount) const noexcept;
+	bool add(const mySQLBatchStatement_t &statement) noexcept;
+	bool add(const char *const queryStmt) noexcept;
+	bool execute() noexcept;
+	void clear() noexcept;
+	/*! @brief Returns the number of statements queued in this batch */
+	size_t count() const noexcept { return statements; }
+	bool succeeded(const size_t index) const noexcept;
+	uint32_t errorNum() const noexcept { return _errorNum; }
+	const char *error() const noexcept { return _error.get(); }
+	void swap(mySQLBatch_t &batch) noexcept;
+
+	/*! @brief Deleted copy constructor for mySQLBatch_t as batches are not copyable */
+	mySQLBatch_t(const mySQLBatch_t &) = delete;
+	/*! @brief Deleted copy assignment operator for mySQLBatch_t as batches are not copyable */
+	mySQLBatch_t &operator =(const mySQLBatch_t &) = delete;
+};
+
+inline void swap(mySQLBatchStatement_t &a, mySQLBatchStatement_t &b) noexcept { a.swap(b); }
+inline void swap(mySQLBatch_t &a, mySQLBatch_t &b) noexcept { a.swap(b); }
+
+/*! @brief The parameters a connection was made with, kept so a side connection can be made to the same server */
+struct mySQLConnectParams_t final
+{
+	// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+	std::unique_ptr<char []> host;
+	uint32_t port;
+	// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+	std::unique_ptr<char []> unixSocket;
+	// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+	std::unique_ptr<char []> user;
+	// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+	std::unique_ptr<char []> passwd;
+};
+
 struct tmplORM_API mySQLClient_t final
 {
 private:
 	static MYSQL *con;
 	static uint32_t handles;
 	static bool haveConnection;
+	static mySQLConnectParams_t connectParams;
+
+	static bool connect(const char *const host, const uint32_t port, const char *const unixSocket,
+		const char *const user, const char *const passwd) noexcept;
+	friend struct mySQLRow_t;
 
 public:
 	mySQLClient_t() noexcept;
@@ -293,10 +449,14 @@ public:
 	bool connect(const char *const host, const uint32_t port, const char *const user, const char *const passwd) const noexcept;
 	bool connect(const char *const unixSocket, const char *const user, const char *const passwd) const noexcept;
 	void disconnect() noexcept;
+	bool reset() const noexcept;
 	bool selectDB(const char *const db) const noexcept;
 	bool query(const char *const queryStmt, ...) const noexcept MySQL_FORMAT_ARGS(2, 3);
 	mySQLResult_t queryResult() const noexcept;
+	mySQLResult_t streamResult() const noexcept;
 	mySQLPreparedQuery_t prepare(const char *const queryStmt, const size_t paramsCount) const noexcept;
+	mySQLPreparedQuery_t prepare(const char *const queryStmt, mySQLBind_t &&binds) const noexcept;
+	mySQLBatch_t batch() const noexcept;
 	uint32_t errorNum() const noexcept;
 	const char *error() const noexcept;
 
@@ -306,6 +466,74 @@ public:
 	mySQLClient_t &operator =(mySQLClient_t &&) = delete;
 };
 
+// The non-blocking API is a MariaDB Connector/C extension, so we can only offer this client when building against it
+#if defined(LIBMARIADB) || defined(MARIADB_BASE_VERSION)
+#define tmplORM_MYSQL_NONBLOCKING 1
+
+enum class mySQLAsyncOp_t : uint8_t
+{
+	none, connect, selectDB,
+	query, storeResult, close
+};
+
+struct tmplORM_API mySQLAsyncClient_t final
+{
+private:
+	MYSQL *con{nullptr};
+	mySQLAsyncOp_t operation{mySQLAsyncOp_t::none};
+	int waitStatus{0};
+	int queryError{0};
+	MYSQL *connectResult{nullptr};
+	MYSQL_RES *storedResult{nullptr};
+	bool haveConnection{false};
+	bool _successful{false};
+
+	bool start(const mySQLAsyncOp_t op, const int status) noexcept;
+	void complete() noexcept;
+
+public:
+	mySQLAsyncClient_t() noexcept;
+	mySQLAsyncClient_t(mySQLAsyncClient_t &&client) noexcept { swap(client); }
+	~mySQLAsyncClient_t() noexcept;
+	void operator =(mySQLAsyncClient_t &&client) noexcept { swap(client); }
+	/*!
+	 * @brief Call to determine if this client connection is valid
+	 * @returns true if the object is valid, false otherwise
+	 */
+	bool valid() const noexcept { return con && haveConnection; }
+	bool connect(const char *const host, const uint32_t port, const char *const user, const char *const passwd) noexcept;
+	bool connect(const char *const unixSocket, const char *const user, const char *const passwd) noexcept;
+	bool disconnect() noexcept;
+	bool selectDB(const char *const db) noexcept;
+	bool query(const char *const queryStmt) noexcept;
+	bool storeResult() noexcept;
+	mySQLResult_t queryResult() noexcept;
+	bool resume(const uint32_t events) noexcept;
+	/*! @brief Returns true while an operation is waiting on the connection's socket */
+	bool pending() const noexcept { return operation != mySQLAsyncOp_t::none; }
+	/*! @brief Returns whether the most recently completed operation succeeded */
+	bool successful() const noexcept { return _successful; }
+	int socket() const noexcept;
+	/*! @brief Returns the MYSQL_WAIT_* events the pending operation is waiting on */
+	uint32_t waitEvents() const noexcept { return static_cast<uint32_t>(waitStatus); }
+	uint32_t timeout() const noexcept;
+#ifndef _WINDOWS
+	short pollEvents() const noexcept;
+	bool resumeFromPoll(const short events) noexcept;
+#endif
+	uint32_t errorNum() const noexcept;
+	const char *error() const noexcept;
+	void swap(mySQLAsyncClient_t &client) noexcept;
+
+	/*! @brief Deleted copy constructor for mySQLAsyncClient_t as client connections are not copyable */
+	mySQLAsyncClient_t(const mySQLAsyncClient_t &) = delete;
+	/*! @brief Deleted copy assignment operator for mySQLAsyncClient_t as client connections are not copyable */
+	mySQLAsyncClient_t &operator =(const mySQLAsyncClient_t &) = delete;
+};
+
+inline void swap(mySQLAsyncClient_t &a, mySQLAsyncClient_t &b) noexcept { a.swap(b); }
+#endif
+
 enum class mySQLErrorType_t : uint8_t
 {
 	noError, queryError,
@@ -0,0 +1,986 @@
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+#include "numeric.hxx"
+
+/*!
+ * @internal
+ * @file
+ * @author Rachel Mant
+ * @date 2026
+ * @brief Correctly rounded, locale-independent decimal to binary floating point conversion
+ * @details This implements the Eisel-Lemire algorithm - the decimal mantissa is multiplied by a
+ *     128-bit truncated approximation of the power of 5 for the decimal exponent, which is almost always
+ *     enough to determine the correctly rounded result. Exactly representable inputs take Clinger's fast
+ *     path, and the rare inputs that remain ambiguous fall back to a classic locale stream conversion.
+ */
+
+namespace tmplORM
+{
+	namespace numeric
+	{
+		template<typename> struct binaryFormat_t;
+
+		template<> struct binaryFormat_t<float>
+		{
+			using bits_t = uint32_t;
+			constexpr static int32_t mantissaBits = 23;
+			constexpr static int32_t minExponent = -127;
+			constexpr static int32_t infinitePower = 0xFF;
+			constexpr static int32_t minRoundToEven = -17;
+			constexpr static int32_t maxRoundToEven = 10;
+			constexpr static int64_t smallestPowerOfTen = -64;
+			constexpr static int64_t largestPowerOfTen = 38;
+			constexpr static int64_t maxFastPower = 10;
+			constexpr static uint64_t maxFastMantissa = uint64_t{1} << 24U;
+		};
+
+		template<> struct binaryFormat_t<double>
+		{
+			using bits_t = uint64_t;
+			constexpr static int32_t mantissaBits = 52;
+			constexpr static int32_t minExponent = -1023;
+			constexpr static int32_t infinitePower = 0x7FF;
+			constexpr static int32_t minRoundToEven = -4;
+			constexpr static int32_t maxRoundToEven = 23;
+			constexpr static int64_t smallestPowerOfTen = -342;
+			constexpr static int64_t largestPowerOfTen = 308;
+			constexpr static int64_t maxFastPower = 22;
+			constexpr static uint64_t maxFastMantissa = uint64_t{1} << 53U;
+		};
+
+		// The powers of ten that are exactly representable in each type, for the fast path
+		constexpr static std::array<float, 11> floatPowersOfTen
+			{{1e0F, 1e1F, 1e2F, 1e3F, 1e4F, 1e5F, 1e6F, 1e7F, 1e8F, 1e9F, 1e10F}};
+		constexpr static std::array<double, 23> doublePowersOfTen
+		{{
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		}};
+
+		inline float powerOfTen(const float, const size_t power) noexcept
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+			{ return floatPowersOfTen[power]; }
+		inline double powerOfTen(const double, const size_t power) noexcept
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+			{ return doublePowersOfTen[power]; }
+
+		constexpr static int64_t smallestPowerOfFive = -342;
+		/*!
+		 * @internal
+		 * @brief 128-bit approximations of 5^q for q in [-342, 308], high 64 bits first
+		 * @details Each value is normalised so its top bit is set. Positive powers are truncated, while
+		 *     negative powers are rounded up, such that the true value always lies within the 128 bits
+		 *     given and the 128 bits following them.
+		 */
+		static const std::array<uint64_t, 1302> powersOfFive
+		{{
+			0xEEF453D6923BD65AU, 0x113FAA2906A13B3FU,
+			0x9558B4661B6565F8U, 0x4AC7CA59A424C507U,
+			0xBAAEE17FA23EBF76U, 0x5D79BCF00D2DF649U,
+			0xE95A99DF8ACE6F53U, 0xF4D82C2C107973DCU,
+			0x91D8A02BB6C10594U, 0x79071B9B8A4BE869U,
+			0xB64EC836A47146F9U, 0x9748E2826CDEE284U,
+			0xE3E27A444D8D98B7U, 0xFD1B1B2308169B25U,
+			0x8E6D8C6AB0787F72U, 0xFE30F0F5E50E20F7U,
+			0xB208EF855C969F4FU, 0xBDBD2D335E51A935U,
+			0xDE8B2B66B3BC4723U, 0xAD2C788035E61382U,
+			0x8B16FB203055AC76U, 0x4C3BCB5021AFCC31U,
+			0xADDCB9E83C6B1793U, 0xDF4ABE242A1BBF3DU,
+			0xD953E8624B85DD78U, 0xD71D6DAD34A2AF0DU,
+			0x87D4713D6F33AA6BU, 0x8672648C40E5AD68U,
+			0xA9C98D8CCB009506U, 0x680EFDAF511F18C2U,
+			0xD43BF0EFFDC0BA48U, 0x0212BD1B2566DEF2U,
+			0x84A57695FE98746DU, 0x014BB630F7604B57U,
+			0xA5CED43B7E3E9188U, 0x419EA3BD35385E2DU,
+			0xCF42894A5DCE35EAU, 0x52064CAC828675B9U,
+			0x818995CE7AA0E1B2U, 0x7343EFEBD1940993U,
+			0xA1EBFB4219491A1FU, 0x1014EBE6C5F90BF8U,
+			0xCA66FA129F9B60A6U, 0xD41A26E077774EF6U,
+			0xFD00B897478238D0U, 0x8920B098955522B4U,
+			0x9E20735E8CB16382U, 0x55B46E5F5D5535B0U,
+			0xC5A890362FDDBC62U, 0xEB2189F734AA831DU,
+			0xF712B443BBD52B7BU, 0xA5E9EC7501D523E4U,
+			0x9A6BB0AA55653B2DU, 0x47B233C92125366EU,
+			0xC1069CD4EABE89F8U, 0x999EC0BB696E840AU,
+			0xF148440A256E2C76U, 0xC00670EA43CA250DU,
+			0x96CD2A865764DBCAU, 0x380406926A5E5728U,
+			0xBC807527ED3E12BCU, 0xC605083704F5ECF2U,
+			0xEBA09271E88D976BU, 0xF7864A44C633682EU,
+			0x93445B8731587EA3U, 0x7AB3EE6AFBE0211DU,
+			0xB8157268FDAE9E4CU, 0x5960EA05BAD82964U,
+			0xE61ACF033D1A45DFU, 0x6FB92487298E33BDU,
+			0x8FD0C16206306BABU, 0xA5D3B6D479F8E056U,
+			0xB3C4F1BA87BC8696U, 0x8F48A4899877186CU,
+			0xE0B62E2929ABA83CU, 0x331ACDABFE94DE87U,
+			0x8C71DCD9BA0B4925U, 0x9FF0C08B7F1D0B14U,
+			0xAF8E5410288E1B6FU, 0x07ECF0AE5EE44DD9U,
+			0xDB71E91432B1A24AU, 0xC9E82CD9F69D6150U,
+			0x892731AC9FAF056EU, 0xBE311C083A225CD2U,
+			0xAB70FE17C79AC6CAU, 0x6DBD630A48AAF406U,
+			0xD64D3D9DB981787DU, 0x092CBBCCDAD5B108U,
+			0x85F0468293F0EB4EU, 0x25BBF56008C58EA5U,
+			0xA76C582338ED2621U, 0xAF2AF2B80AF6F24EU,
+			0xD1476E2C07286FAAU, 0x1AF5AF660DB4AEE1U,
+			0x82CCA4DB847945CAU, 0x50D98D9FC890ED4DU,
+			0xA37FCE126597973CU, 0xE50FF107BAB528A0U,
+			0xCC5FC196FEFD7D0CU, 0x1E53ED49A96272C8U,
+			0xFF77B1FCBEBCDC4FU, 0x25E8E89C13BB0F7AU,
+			0x9FAACF3DF73609B1U, 0x77B191618C54E9ACU,
+			0xC795830D75038C1DU, 0xD59DF5B9EF6A2417U,
+			0xF97AE3D0D2446F25U, 0x4B0573286B44AD1DU,
+			0x9BECCE62836AC577U, 0x4EE367F9430AEC32U,
+			0xC2E801FB244576D5U, 0x229C41F793CDA73FU,
+			0xF3A20279ED56D48AU, 0x6B43527578C1110FU,
+			0x9845418C345644D6U, 0x830A13896B78AAA9U,
+			0xBE5691EF416BD60CU, 0x23CC986BC656D553U,
+			0xEDEC366B11C6CB8FU, 0x2CBFBE86B7EC8AA8U,
+			0x94B3A202EB1C3F39U, 0x7BF7D71432F3D6A9U,
+			0xB9E08A83A5E34F07U, 0xDAF5CCD93FB0CC53U,
+			0xE858AD248F5C22C9U, 0xD1B3400F8F9CFF68U,
+			0x91376C36D99995BEU, 0x23100809B9C21FA1U,
+			0xB58547448FFFFB2DU, 0xABD40A0C2832A78AU,
+			0xE2E69915B3FFF9F9U, 0x16C90C8F323F516CU,
+			0x8DD01FAD907FFC3BU, 0xAE3DA7D97F6792E3U,
+			0xB1442798F49FFB4AU, 0x99CD11CFDF41779CU,
+			0xDD95317F31C7FA1DU, 0x40405643D711D583U,
+			0x8A7D3EEF7F1CFC52U, 0x482835EA666B2572U,
+			0xAD1C8EAB5EE43B66U, 0xDA3243650005EECFU,
+			0xD863B256369D4A40U, 0x90BED43E40076A82U,
+			0x873E4F75E2224E68U, 0x5A7744A6E804A291U,
+			0xA90DE3535AAAE202U, 0x711515D0A205CB36U,
+			0xD3515C2831559A83U, 0x0D5A5B44CA873E03U,
+			0x8412D9991ED58091U, 0xE858790AFE9486C2U,
+			0xA5178FFF668AE0B6U, 0x626E974DBE39A872U,
+			0xCE5D73FF402D98E3U, 0xFB0A3D212DC8128FU,
+			0x80FA687F881C7F8EU, 0x7CE66634BC9D0B99U,
+			0xA139029F6A239F72U, 0x1C1FFFC1EBC44E80U,
+			0xC987434744AC874EU, 0xA327FFB266B56220U,
+			0xFBE9141915D7A922U, 0x4BF1FF9F0062BAA8U,
+			0x9D71AC8FADA6C9B5U, 0x6F773FC3603DB4A9U,
+			0xC4CE17B399107C22U, 0xCB550FB4384D21D3U,
+			0xF6019DA07F549B2BU, 0x7E2A53A146606A48U,
+			0x99C102844F94E0FBU, 0x2EDA7444CBFC426DU,
+			0xC0314325637A1939U, 0xFA911155FEFB5308U,
+			0xF03D93EEBC589F88U, 0x793555AB7EBA27CAU,
+			0x96267C7535B763B5U, 0x4BC1558B2F3458DEU,
+			0xBBB01B9283253CA2U, 0x9EB1AAEDFB016F16U,
+			0xEA9C227723EE8BCBU, 0x465E15A979C1CADCU,
+			0x92A1958A7675175FU, 0x0BFACD89EC191EC9U,
+			0xB749FAED14125D36U, 0xCEF980EC671F667BU,
+			0xE51C79A85916F484U, 0x82B7E12780E7401AU,
+			0x8F31CC0937AE58D2U, 0xD1B2ECB8B0908810U,
+			0xB2FE3F0B8599EF07U, 0x861FA7E6DCB4AA15U,
+			0xDFBDCECE67006AC9U, 0x67A791E093E1D49AU,
+			0x8BD6A141006042BDU, 0xE0C8BB2C5C6D24E0U,
+			0xAECC49914078536DU, 0x58FAE9F773886E18U,
+			0xDA7F5BF590966848U, 0xAF39A475506A899EU,
+			0x888F99797A5E012DU, 0x6D8406C952429603U,
+			0xAAB37FD7D8F58178U, 0xC8E5087BA6D33B83U,
+			0xD5605FCDCF32E1D6U, 0xFB1E4A9A90880A64U,
+			0x855C3BE0A17FCD26U, 0x5CF2EEA09A55067FU,
+			0xA6B34AD8C9DFC06FU, 0xF42FAA48C0EA481EU,
+			0xD0601D8EFC57B08BU, 0xF13B94DAF124DA26U,
+			0x823C12795DB6CE57U, 0x76C53D08D6B70858U,
+			0xA2CB1717B52481EDU, 0x54768C4B0C64CA6EU,
+			0xCB7DDCDDA26DA268U, 0xA9942F5DCF7DFD09U,
+			0xFE5D54150B090B02U, 0xD3F93B35435D7C4CU,
+			0x9EFA548D26E5A6E1U, 0xC47BC5014A1A6DAFU,
+			0xC6B8E9B0709F109AU, 0x359AB6419CA1091BU,
+			0xF867241C8CC6D4C0U, 0xC30163D203C94B62U,
+			0x9B407691D7FC44F8U, 0x79E0DE63425DCF1DU,
+			0xC21094364DFB5636U, 0x985915FC12F542E4U,
+			0xF294B943E17A2BC4U, 0x3E6F5B7B17B2939DU,
+			0x979CF3CA6CEC5B5AU, 0xA705992CEECF9C42U,
+			0xBD8430BD08277231U, 0x50C6FF782A838353U,
+			0xECE53CEC4A314EBDU, 0xA4F8BF5635246428U,
+			0x940F4613AE5ED136U, 0x871B7795E136BE99U,
+			0xB913179899F68584U, 0x28E2557B59846E3FU,
+			0xE757DD7EC07426E5U, 0x331AEADA2FE589CFU,
+			0x9096EA6F3848984FU, 0x3FF0D2C85DEF7621U,
+			0xB4BCA50B065ABE63U, 0x0FED077A756B53A9U,
+			0xE1EBCE4DC7F16DFBU, 0xD3E8495912C62894U,
+			0x8D3360F09CF6E4BDU, 0x64712DD7ABBBD95CU,
+			0xB080392CC4349DECU, 0xBD8D794D96AACFB3U,
+			0xDCA04777F541C567U, 0xECF0D7A0FC5583A0U,
+			0x89E42CAAF9491B60U, 0xF41686C49DB57244U,
+			0xAC5D37D5B79B6239U, 0x311C2875C522CED5U,
+			0xD77485CB25823AC7U, 0x7D633293366B828BU,
+			0x86A8D39EF77164BCU, 0xAE5DFF9C02033197U,
+			0xA8530886B54DBDEBU, 0xD9F57F830283FDFCU,
+			0xD267CAA862A12D66U, 0xD072DF63C324FD7BU,
+			0x8380DEA93DA4BC60U, 0x4247CB9E59F71E6DU,
+			0xA46116538D0DEB78U, 0x52D9BE85F074E608U,
+			0xCD795BE870516656U, 0x67902E276C921F8BU,
+			0x806BD9714632DFF6U, 0x00BA1CD8A3DB53B6U,
+			0xA086CFCD97BF97F3U, 0x80E8A40ECCD228A4U,
+			0xC8A883C0FDAF7DF0U, 0x6122CD128006B2CDU,
+			0xFAD2A4B13D1B5D6CU, 0x796B805720085F81U,
+			0x9CC3A6EEC6311A63U, 0xCBE3303674053BB0U,
+			0xC3F490AA77BD60FCU, 0xBEDBFC4411068A9CU,
+			0xF4F1B4D515ACB93BU, 0xEE92FB5515482D44U,
+			0x991711052D8BF3C5U, 0x751BDD152D4D1C4AU,
+			0xBF5CD54678EEF0B6U, 0xD262D45A78A0635DU,
+			0xEF340A98172AACE4U, 0x86FB897116C87C34U,
+			0x9580869F0E7AAC0EU, 0xD45D35E6AE3D4DA0U,
+			0xBAE0A846D2195712U, 0x8974836059CCA109U,
+			0xE998D258869FACD7U, 0x2BD1A438703FC94BU,
+			0x91FF83775423CC06U, 0x7B6306A34627DDCFU,
+			0xB67F6455292CBF08U, 0x1A3BC84C17B1D542U,
+			0xE41F3D6A7377EECAU, 0x20CABA5F1D9E4A93U,
+			0x8E938662882AF53EU, 0x547EB47B7282EE9CU,
+			0xB23867FB2A35B28DU, 0xE99E619A4F23AA43U,
+			0xDEC681F9F4C31F31U, 0x6405FA00E2EC94D4U,
+			0x8B3C113C38F9F37EU, 0xDE83BC408DD3DD04U,
+			0xAE0B158B4738705EU, 0x9624AB50B148D445U,
+			0xD98DDAEE19068C76U, 0x3BADD624DD9B0957U,
+			0x87F8A8D4CFA417C9U, 0xE54CA5D70A80E5D6U,
+			0xA9F6D30A038D1DBCU, 0x5E9FCF4CCD211F4CU,
+			0xD47487CC8470652BU, 0x7647C3200069671FU,
+			0x84C8D4DFD2C63F3BU, 0x29ECD9F40041E073U,
+			0xA5FB0A17C777CF09U, 0xF468107100525890U,
+			0xCF79CC9DB955C2CCU, 0x7182148D4066EEB4U,
+			0x81AC1FE293D599BFU, 0xC6F14CD848405530U,
+			0xA21727DB38CB002FU, 0xB8ADA00E5A506A7CU,
+			0xCA9CF1D206FDC03BU, 0xA6D90811F0E4851CU,
+			0xFD442E4688BD304AU, 0x908F4A166D1DA663U,
+			0x9E4A9CEC15763E2EU, 0x9A598E4E043287FEU,
+			0xC5DD44271AD3CDBAU, 0x40EFF1E1853F29FDU,
+			0xF7549530E188C128U, 0xD12BEE59E68EF47CU,
+			0x9A94DD3E8CF578B9U, 0x82BB74F8301958CEU,
+			0xC13A148E3032D6E7U, 0xE36A52363C1FAF01U,
+			0xF18899B1BC3F8CA1U, 0xDC44E6C3CB279AC1U,
+			0x96F5600F15A7B7E5U, 0x29AB103A5EF8C0B9U,
+			0xBCB2B812DB11A5DEU, 0x7415D448F6B6F0E7U,
+			0xEBDF661791D60F56U, 0x111B495B3464AD21U,
+			0x936B9FCEBB25C995U, 0xCAB10DD900BEEC34U,
+			0xB84687C269EF3BFBU, 0x3D5D514F40EEA742U,
+			0xE65829B3046B0AFAU, 0x0CB4A5A3112A5112U,
+			0x8FF71A0FE2C2E6DCU, 0x47F0E785EABA72ABU,
+			0xB3F4E093DB73A093U, 0x59ED216765690F56U,
+			0xE0F218B8D25088B8U, 0x306869C13EC3532CU,
+			0x8C974F7383725573U, 0x1E414218C73A13FBU,
+			0xAFBD2350644EEACFU, 0xE5D1929EF90898FAU,
+			0xDBAC6C247D62A583U, 0xDF45F746B74ABF39U,
+			0x894BC396CE5DA772U, 0x6B8BBA8C328EB783U,
+			0xAB9EB47C81F5114FU, 0x066EA92F3F326564U,
+			0xD686619BA27255A2U, 0xC80A537B0EFEFEBDU,
+			0x8613FD0145877585U, 0xBD06742CE95F5F36U,
+			0xA798FC4196E952E7U, 0x2C48113823B73704U,
+			0xD17F3B51FCA3A7A0U, 0xF75A15862CA504C5U,
+			0x82EF85133DE648C4U, 0x9A984D73DBE722FBU,
+			0xA3AB66580D5FDAF5U, 0xC13E60D0D2E0EBBAU,
+			0xCC963FEE10B7D1B3U, 0x318DF905079926A8U,
+			0xFFBBCFE994E5C61FU, 0xFDF17746497F7052U,
+			0x9FD561F1FD0F9BD3U, 0xFEB6EA8BEDEFA633U,
+			0xC7CABA6E7C5382C8U, 0xFE64A52EE96B8FC0U,
+			0xF9BD690A1B68637BU, 0x3DFDCE7AA3C673B0U,
+			0x9C1661A651213E2DU, 0x06BEA10CA65C084EU,
+			0xC31BFA0FE5698DB8U, 0x486E494FCFF30A62U,
+			0xF3E2F893DEC3F126U, 0x5A89DBA3C3EFCCFAU,
+			0x986DDB5C6B3A76B7U, 0xF89629465A75E01CU,
+			0xBE89523386091465U, 0xF6BBB397F1135823U,
+			0xEE2BA6C0678B597FU, 0x746AA07DED582E2CU,
+			0x94DB483840B717EFU, 0xA8C2A44EB4571CDCU,
+			0xBA121A4650E4DDEBU, 0x92F34D62616CE413U,
+			0xE896A0D7E51E1566U, 0x77B020BAF9C81D17U,
+			0x915E2486EF32CD60U, 0x0ACE1474DC1D122EU,
+			0xB5B5ADA8AAFF80B8U, 0x0D819992132456BAU,
+			0xE3231912D5BF60E6U, 0x10E1FFF697ED6C69U,
+			0x8DF5EFABC5979C8FU, 0xCA8D3FFA1EF463C1U,
+			0xB1736B96B6FD83B3U, 0xBD308FF8A6B17CB2U,
+			0xDDD0467C64BCE4A0U, 0xAC7CB3F6D05DDBDEU,
+			0x8AA22C0DBEF60EE4U, 0x6BCDF07A423AA96BU,
+			0xAD4AB7112EB3929DU, 0x86C16C98D2C953C6U,
+			0xD89D64D57A607744U, 0xE871C7BF077BA8B7U,
+			0x87625F056C7C4A8BU, 0x11471CD764AD4972U,
+			0xA93AF6C6C79B5D2DU, 0xD598E40D3DD89BCFU,
+			0xD389B47879823479U, 0x4AFF1D108D4EC2C3U,
+			0x843610CB4BF160CBU, 0xCEDF722A585139BAU,
+			0xA54394FE1EEDB8FEU, 0xC2974EB4EE658828U,
+			0xCE947A3DA6A9273EU, 0x733D226229FEEA32U,
+			0x811CCC668829B887U, 0x0806357D5A3F525FU,
+			0xA163FF802A3426A8U, 0xCA07C2DCB0CF26F7U,
+			0xC9BCFF6034C13052U, 0xFC89B393DD02F0B5U,
+			0xFC2C3F3841F17C67U, 0xBBAC2078D443ACE2U,
+			0x9D9BA7832936EDC0U, 0xD54B944B84AA4C0DU,
+			0xC5029163F384A931U, 0x0A9E795E65D4DF11U,
+			0xF64335BCF065D37DU, 0x4D4617B5FF4A16D5U,
+			0x99EA0196163FA42EU, 0x504BCED1BF8E4E45U,
+			0xC06481FB9BCF8D39U, 0xE45EC2862F71E1D6U,
+			0xF07DA27A82C37088U, 0x5D767327BB4E5A4CU,
+			0x964E858C91BA2655U, 0x3A6A07F8D510F86FU,
+			0xBBE226EFB628AFEAU, 0x890489F70A55368BU,
+			0xEADAB0ABA3B2DBE5U, 0x2B45AC74CCEA842EU,
+			0x92C8AE6B464FC96FU, 0x3B0B8BC90012929DU,
+			0xB77ADA0617E3BBCBU, 0x09CE6EBB40173744U,
+			0xE55990879DDCAABDU, 0xCC420A6A101D0515U,
+			0x8F57FA54C2A9EAB6U, 0x9FA946824A12232DU,
+			0xB32DF8E9F3546564U, 0x47939822DC96ABF9U,
+			0xDFF9772470297EBDU, 0x59787E2B93BC56F7U,
+			0x8BFBEA76C619EF36U, 0x57EB4EDB3C55B65AU,
+			0xAEFAE51477A06B03U, 0xEDE622920B6B23F1U,
+			0xDAB99E59958885C4U, 0xE95FAB368E45ECEDU,
+			0x88B402F7FD75539BU, 0x11DBCB0218EBB414U,
+			0xAAE103B5FCD2A881U, 0xD652BDC29F26A119U,
+			0xD59944A37C0752A2U, 0x4BE76D3346F0495FU,
+			0x857FCAE62D8493A5U, 0x6F70A4400C562DDBU,
+			0xA6DFBD9FB8E5B88EU, 0xCB4CCD500F6BB952U,
+			0xD097AD07A71F26B2U, 0x7E2000A41346A7A7U,
+			0x825ECC24C873782FU, 0x8ED400668C0C28C8U,
+			0xA2F67F2DFA90563BU, 0x728900802F0F32FAU,
+			0xCBB41EF979346BCAU, 0x4F2B40A03AD2FFB9U,
+			0xFEA126B7D78186BCU, 0xE2F610C84987BFA8U,
+			0x9F24B832E6B0F436U, 0x0DD9CA7D2DF4D7C9U,
+			0xC6EDE63FA05D3143U, 0x91503D1C79720DBBU,
+			0xF8A95FCF88747D94U, 0x75A44C6397CE912AU,
+			0x9B69DBE1B548CE7CU, 0xC986AFBE3EE11ABAU,
+			0xC24452DA229B021BU, 0xFBE85BADCE996168U,
+			0xF2D56790AB41C2A2U, 0xFAE27299423FB9C3U,
+			0x97C560BA6B0919A5U, 0xDCCD879FC967D41AU,
+			0xBDB6B8E905CB600FU, 0x5400E987BBC1C920U,
+			0xED246723473E3813U, 0x290123E9AAB23B68U,
+			0x9436C0760C86E30BU, 0xF9A0B6720AAF6521U,
+			0xB94470938FA89BCEU, 0xF808E40E8D5B3E69U,
+			0xE7958CB87392C2C2U, 0xB60B1D1230B20E04U,
+			0x90BD77F3483BB9B9U, 0xB1C6F22B5E6F48C2U,
+			0xB4ECD5F01A4AA828U, 0x1E38AEB6360B1AF3U,
+			0xE2280B6C20DD5232U, 0x25C6DA63C38DE1B0U,
+			0x8D590723948A535FU, 0x579C487E5A38AD0EU,
+			0xB0AF48EC79ACE837U, 0x2D835A9DF0C6D851U,
+			0xDCDB1B2798182244U, 0xF8E431456CF88E65U,
+			0x8A08F0F8BF0F156BU, 0x1B8E9ECB641B58FFU,
+			0xAC8B2D36EED2DAC5U, 0xE272467E3D222F3FU,
+			0xD7ADF884AA879177U, 0x5B0ED81DCC6ABB0FU,
+			0x86CCBB52EA94BAEAU, 0x98E947129FC2B4E9U,
+			0xA87FEA27A539E9A5U, 0x3F2398D747B36224U,
+			0xD29FE4B18E88640EU, 0x8EEC7F0D19A03AADU,
+			0x83A3EEEEF9153E89U, 0x1953CF68300424ACU,
+			0xA48CEAAAB75A8E2BU, 0x5FA8C3423C052DD7U,
+			0xCDB02555653131B6U, 0x3792F412CB06794DU,
+			0x808E17555F3EBF11U, 0xE2BBD88BBEE40BD0U,
+			0xA0B19D2AB70E6ED6U, 0x5B6ACEAEAE9D0EC4U,
+			0xC8DE047564D20A8BU, 0xF245825A5A445275U,
+			0xFB158592BE068D2EU, 0xEED6E2F0F0D56712U,
+			0x9CED737BB6C4183DU, 0x55464DD69685606BU,
+			0xC428D05AA4751E4CU, 0xAA97E14C3C26B886U,
+			0xF53304714D9265DFU, 0xD53DD99F4B3066A8U,
+			0x993FE2C6D07B7FABU, 0xE546A8038EFE4029U,
+			0xBF8FDB78849A5F96U, 0xDE98520472BDD033U,
+			0xEF73D256A5C0F77CU, 0x963E66858F6D4440U,
+			0x95A8637627989AADU, 0xDDE7001379A44AA8U,
+			0xBB127C53B17EC159U, 0x5560C018580D5D52U,
+			0xE9D71B689DDE71AFU, 0xAAB8F01E6E10B4A6U,
+			0x9226712162AB070DU, 0xCAB3961304CA70E8U,
+			0xB6B00D69BB55C8D1U, 0x3D607B97C5FD0D22U,
+			0xE45C10C42A2B3B05U, 0x8CB89A7DB77C506AU,
+			0x8EB98A7A9A5B04E3U, 0x77F3608E92ADB242U,
+			0xB267ED1940F1C61CU, 0x55F038B237591ED3U,
+			0xDF01E85F912E37A3U, 0x6B6C46DEC52F6688U,
+			0x8B61313BBABCE2C6U, 0x2323AC4B3B3DA015U,
+			0xAE397D8AA96C1B77U, 0xABEC975E0A0D081AU,
+			0xD9C7DCED53C72255U, 0x96E7BD358C904A21U,
+			0x881CEA14545C7575U, 0x7E50D64177DA2E54U,
+			0xAA242499697392D2U, 0xDDE50BD1D5D0B9E9U,
+			0xD4AD2DBFC3D07787U, 0x955E4EC64B44E864U,
+			0x84EC3C97DA624AB4U, 0xBD5AF13BEF0B113EU,
+			0xA6274BBDD0FADD61U, 0xECB1AD8AEACDD58EU,
+			0xCFB11EAD453994BAU, 0x67DE18EDA5814AF2U,
+			0x81CEB32C4B43FCF4U, 0x80EACF948770CED7U,
+			0xA2425FF75E14FC31U, 0xA1258379A94D028DU,
+			0xCAD2F7F5359A3B3EU, 0x096EE45813A04330U,
+			0xFD87B5F28300CA0DU, 0x8BCA9D6E188853FCU,
+			0x9E74D1B791E07E48U, 0x775EA264CF55347EU,
+			0xC612062576589DDAU, 0x95364AFE032A819EU,
+			0xF79687AED3EEC551U, 0x3A83DDBD83F52205U,
+			0x9ABE14CD44753B52U, 0xC4926A9672793543U,
+			0xC16D9A0095928A27U, 0x75B7053C0F178294U,
+			0xF1C90080BAF72CB1U, 0x5324C68B12DD6339U,
+			0x971DA05074DA7BEEU, 0xD3F6FC16EBCA5E04U,
+			0xBCE5086492111AEAU, 0x88F4BB1CA6BCF585U,
+			0xEC1E4A7DB69561A5U, 0x2B31E9E3D06C32E6U,
+			0x9392EE8E921D5D07U, 0x3AFF322E62439FD0U,
+			0xB877AA3236A4B449U, 0x09BEFEB9FAD487C3U,
+			0xE69594BEC44DE15BU, 0x4C2EBE687989A9B4U,
+			0x901D7CF73AB0ACD9U, 0x0F9D37014BF60A11U,
+			0xB424DC35095CD80FU, 0x538484C19EF38C95U,
+			0xE12E13424BB40E13U, 0x2865A5F206B06FBAU,
+			0x8CBCCC096F5088CBU, 0xF93F87B7442E45D4U,
+			0xAFEBFF0BCB24AAFEU, 0xF78F69A51539D749U,
+			0xDBE6FECEBDEDD5BEU, 0xB573440E5A884D1CU,
+			0x89705F4136B4A597U, 0x31680A88F8953031U,
+			0xABCC77118461CEFCU, 0xFDC20D2B36BA7C3EU,
+			0xD6BF94D5E57A42BCU, 0x3D32907604691B4DU,
+			0x8637BD05AF6C69B5U, 0xA63F9A49C2C1B110U,
+			0xA7C5AC471B478423U, 0x0FCF80DC33721D54U,
+			0xD1B71758E219652BU, 0xD3C36113404EA4A9U,
+			0x83126E978D4FDF3BU, 0x645A1CAC083126EAU,
+			0xA3D70A3D70A3D70AU, 0x3D70A3D70A3D70A4U,
+			0xCCCCCCCCCCCCCCCCU, 0xCCCCCCCCCCCCCCCDU,
+			0x8000000000000000U, 0x0000000000000000U,
+			0xA000000000000000U, 0x0000000000000000U,
+			0xC800000000000000U, 0x0000000000000000U,
+			0xFA00000000000000U, 0x0000000000000000U,
+			0x9C40000000000000U, 0x0000000000000000U,
+			0xC350000000000000U, 0x0000000000000000U,
+			0xF424000000000000U, 0x0000000000000000U,
+			0x9896800000000000U, 0x0000000000000000U,
+			0xBEBC200000000000U, 0x0000000000000000U,
+			0xEE6B280000000000U, 0x0000000000000000U,
+			0x9502F90000000000U, 0x0000000000000000U,
+			0xBA43B74000000000U, 0x0000000000000000U,
+			0xE8D4A51000000000U, 0x0000000000000000U,
+			0x9184E72A00000000U, 0x0000000000000000U,
+			0xB5E620F480000000U, 0x0000000000000000U,
+			0xE35FA931A0000000U, 0x0000000000000000U,
+			0x8E1BC9BF04000000U, 0x0000000000000000U,
+			0xB1A2BC2EC5000000U, 0x0000000000000000U,
+			0xDE0B6B3A76400000U, 0x0000000000000000U,
+			0x8AC7230489E80000U, 0x0000000000000000U,
+			0xAD78EBC5AC620000U, 0x0000000000000000U,
+			0xD8D726B7177A8000U, 0x0000000000000000U,
+			0x878678326EAC9000U, 0x0000000000000000U,
+			0xA968163F0A57B400U, 0x0000000000000000U,
+			0xD3C21BCECCEDA100U, 0x0000000000000000U,
+			0x84595161401484A0U, 0x0000000000000000U,
+			0xA56FA5B99019A5C8U, 0x0000000000000000U,
+			0xCECB8F27F4200F3AU, 0x0000000000000000U,
+			0x813F3978F8940984U, 0x4000000000000000U,
+			0xA18F07D736B90BE5U, 0x5000000000000000U,
+			0xC9F2C9CD04674EDEU, 0xA400000000000000U,
+			0xFC6F7C4045812296U, 0x4D00000000000000U,
+			0x9DC5ADA82B70B59DU, 0xF020000000000000U,
+			0xC5371912364CE305U, 0x6C28000000000000U,
+			0xF684DF56C3E01BC6U, 0xC732000000000000U,
+			0x9A130B963A6C115CU, 0x3C7F400000000000U,
+			0xC097CE7BC90715B3U, 0x4B9F100000000000U,
+			0xF0BDC21ABB48DB20U, 0x1E86D40000000000U,
+			0x96769950B50D88F4U, 0x1314448000000000U,
+			0xBC143FA4E250EB31U, 0x17D955A000000000U,
+			0xEB194F8E1AE525FDU, 0x5DCFAB0800000000U,
+			0x92EFD1B8D0CF37BEU, 0x5AA1CAE500000000U,
+			0xB7ABC627050305ADU, 0xF14A3D9E40000000U,
+			0xE596B7B0C643C719U, 0x6D9CCD05D0000000U,
+			0x8F7E32CE7BEA5C6FU, 0xE4820023A2000000U,
+			0xB35DBF821AE4F38BU, 0xDDA2802C8A800000U,
+			0xE0352F62A19E306EU, 0xD50B2037AD200000U,
+			0x8C213D9DA502DE45U, 0x4526F422CC340000U,
+			0xAF298D050E4395D6U, 0x9670B12B7F410000U,
+			0xDAF3F04651D47B4CU, 0x3C0CDD765F114000U,
+			0x88D8762BF324CD0FU, 0xA5880A69FB6AC800U,
+			0xAB0E93B6EFEE0053U, 0x8EEA0D047A457A00U,
+			0xD5D238A4ABE98068U, 0x72A4904598D6D880U,
+			0x85A36366EB71F041U, 0x47A6DA2B7F864750U,
+			0xA70C3C40A64E6C51U, 0x999090B65F67D924U,
+			0xD0CF4B50CFE20765U, 0xFFF4B4E3F741CF6DU,
+			0x82818F1281ED449FU, 0xBFF8F10E7A8921A4U,
+			0xA321F2D7226895C7U, 0xAFF72D52192B6A0DU,
+			0xCBEA6F8CEB02BB39U, 0x9BF4F8A69F764490U,
+			0xFEE50B7025C36A08U, 0x02F236D04753D5B4U,
+			0x9F4F2726179A2245U, 0x01D762422C946590U,
+			0xC722F0EF9D80AAD6U, 0x424D3AD2B7B97EF5U,
+			0xF8EBAD2B84E0D58BU, 0xD2E0898765A7DEB2U,
+			0x9B934C3B330C8577U, 0x63CC55F49F88EB2FU,
+			0xC2781F49FFCFA6D5U, 0x3CBF6B71C76B25FBU,
+			0xF316271C7FC3908AU, 0x8BEF464E3945EF7AU,
+			0x97EDD871CFDA3A56U, 0x97758BF0E3CBB5ACU,
+			0xBDE94E8E43D0C8ECU, 0x3D52EEED1CBEA317U,
+			0xED63A231D4C4FB27U, 0x4CA7AAA863EE4BDDU,
+			0x945E455F24FB1CF8U, 0x8FE8CAA93E74EF6AU,
+			0xB975D6B6EE39E436U, 0xB3E2FD538E122B44U,
+			0xE7D34C64A9C85D44U, 0x60DBBCA87196B616U,
+			0x90E40FBEEA1D3A4AU, 0xBC8955E946FE31CDU,
+			0xB51D13AEA4A488DDU, 0x6BABAB6398BDBE41U,
+			0xE264589A4DCDAB14U, 0xC696963C7EED2DD1U,
+			0x8D7EB76070A08AECU, 0xFC1E1DE5CF543CA2U,
+			0xB0DE65388CC8ADA8U, 0x3B25A55F43294BCBU,
+			0xDD15FE86AFFAD912U, 0x49EF0EB713F39EBEU,
+			0x8A2DBF142DFCC7ABU, 0x6E3569326C784337U,
+			0xACB92ED9397BF996U, 0x49C2C37F07965404U,
+			0xD7E77A8F87DAF7FBU, 0xDC33745EC97BE906U,
+			0x86F0AC99B4E8DAFDU, 0x69A028BB3DED71A3U,
+			0xA8ACD7C0222311BCU, 0xC40832EA0D68CE0CU,
+			0xD2D80DB02AABD62BU, 0xF50A3FA490C30190U,
+			0x83C7088E1AAB65DBU, 0x792667C6DA79E0FAU,
+			0xA4B8CAB1A1563F52U, 0x577001B891185938U,
+			0xCDE6FD5E09ABCF26U, 0xED4C0226B55E6F86U,
+			0x80B05E5AC60B6178U, 0x544F8158315B05B4U,
+			0xA0DC75F1778E39D6U, 0x696361AE3DB1C721U,
+			0xC913936DD571C84CU, 0x03BC3A19CD1E38E9U,
+			0xFB5878494ACE3A5FU, 0x04AB48A04065C723U,
+			0x9D174B2DCEC0E47BU, 0x62EB0D64283F9C76U,
+			0xC45D1DF942711D9AU, 0x3BA5D0BD324F8394U,
+			0xF5746577930D6500U, 0xCA8F44EC7EE36479U,
+			0x9968BF6ABBE85F20U, 0x7E998B13CF4E1ECBU,
+			0xBFC2EF456AE276E8U, 0x9E3FEDD8C321A67EU,
+			0xEFB3AB16C59B14A2U, 0xC5CFE94EF3EA101EU,
+			0x95D04AEE3B80ECE5U, 0xBBA1F1D158724A12U,
+			0xBB445DA9CA61281FU, 0x2A8A6E45AE8EDC97U,
+			0xEA1575143CF97226U, 0xF52D09D71A3293BDU,
+			0x924D692CA61BE758U, 0x593C2626705F9C56U,
+			0xB6E0C377CFA2E12EU, 0x6F8B2FB00C77836CU,
+			0xE498F455C38B997AU, 0x0B6DFB9C0F956447U,
+			0x8EDF98B59A373FECU, 0x4724BD4189BD5EACU,
+			0xB2977EE300C50FE7U, 0x58EDEC91EC2CB657U,
+			0xDF3D5E9BC0F653E1U, 0x2F2967B66737E3EDU,
+			0x8B865B215899F46CU, 0xBD79E0D20082EE74U,
+			0xAE67F1E9AEC07187U, 0xECD8590680A3AA11U,
+			0xDA01EE641A708DE9U, 0xE80E6F4820CC9495U,
+			0x884134FE908658B2U, 0x3109058D147FDCDDU,
+			0xAA51823E34A7EEDEU, 0xBD4B46F0599FD415U,
+			0xD4E5E2CDC1D1EA96U, 0x6C9E18AC7007C91AU,
+			0x850FADC09923329EU, 0x03E2CF6BC604DDB0U,
+			0xA6539930BF6BFF45U, 0x84DB8346B786151CU,
+			0xCFE87F7CEF46FF16U, 0xE612641865679A63U,
+			0x81F14FAE158C5F6EU, 0x4FCB7E8F3F60C07EU,
+			0xA26DA3999AEF7749U, 0xE3BE5E330F38F09DU,
+			0xCB090C8001AB551CU, 0x5CADF5BFD3072CC5U,
+			0xFDCB4FA002162A63U, 0x73D9732FC7C8F7F6U,
+			0x9E9F11C4014DDA7EU, 0x2867E7FDDCDD9AFAU,
+			0xC646D63501A1511DU, 0xB281E1FD541501B8U,
+			0xF7D88BC24209A565U, 0x1F225A7CA91A4226U,
+			0x9AE757596946075FU, 0x3375788DE9B06958U,
+			0xC1A12D2FC3978937U, 0x0052D6B1641C83AEU,
+			0xF209787BB47D6B84U, 0xC0678C5DBD23A49AU,
+			0x9745EB4D50CE6332U, 0xF840B7BA963646E0U,
+			0xBD176620A501FBFFU, 0xB650E5A93BC3D898U,
+			0xEC5D3FA8CE427AFFU, 0xA3E51F138AB4CEBEU,
+			0x93BA47C980E98CDFU, 0xC66F336C36B10137U,
+			0xB8A8D9BBE123F017U, 0xB80B0047445D4184U,
+			0xE6D3102AD96CEC1DU, 0xA60DC059157491E5U,
+			0x9043EA1AC7E41392U, 0x87C89837AD68DB2FU,
+			0xB454E4A179DD1877U, 0x29BABE4598C311FBU,
+			0xE16A1DC9D8545E94U, 0xF4296DD6FEF3D67AU,
+			0x8CE2529E2734BB1DU, 0x1899E4A65F58660CU,
+			0xB01AE745B101E9E4U, 0x5EC05DCFF72E7F8FU,
+			0xDC21A1171D42645DU, 0x76707543F4FA1F73U,
+			0x899504AE72497EBAU, 0x6A06494A791C53A8U,
+			0xABFA45DA0EDBDE69U, 0x0487DB9D17636892U,
+			0xD6F8D7509292D603U, 0x45A9D2845D3C42B6U,
+			0x865B86925B9BC5C2U, 0x0B8A2392BA45A9B2U,
+			0xA7F26836F282B732U, 0x8E6CAC7768D7141EU,
+			0xD1EF0244AF2364FFU, 0x3207D795430CD926U,
+			0x8335616AED761F1FU, 0x7F44E6BD49E807B8U,
+			0xA402B9C5A8D3A6E7U, 0x5F16206C9C6209A6U,
+			0xCD036837130890A1U, 0x36DBA887C37A8C0FU,
+			0x802221226BE55A64U, 0xC2494954DA2C9789U,
+			0xA02AA96B06DEB0FDU, 0xF2DB9BAA10B7BD6CU,
+			0xC83553C5C8965D3DU, 0x6F92829494E5ACC7U,
+			0xFA42A8B73ABBF48CU, 0xCB772339BA1F17F9U,
+			0x9C69A97284B578D7U, 0xFF2A760414536EFBU,
+			0xC38413CF25E2D70DU, 0xFEF5138519684ABAU,
+			0xF46518C2EF5B8CD1U, 0x7EB258665FC25D69U,
+			0x98BF2F79D5993802U, 0xEF2F773FFBD97A61U,
+			0xBEEEFB584AFF8603U, 0xAAFB550FFACFD8FAU,
+			0xEEAABA2E5DBF6784U, 0x95BA2A53F983CF38U,
+			0x952AB45CFA97A0B2U, 0xDD945A747BF26183U,
+			0xBA756174393D88DFU, 0x94F971119AEEF9E4U,
+			0xE912B9D1478CEB17U, 0x7A37CD5601AAB85DU,
+			0x91ABB422CCB812EEU, 0xAC62E055C10AB33AU,
+			0xB616A12B7FE617AAU, 0x577B986B314D6009U,
+			0xE39C49765FDF9D94U, 0xED5A7E85FDA0B80BU,
+			0x8E41ADE9FBEBC27DU, 0x14588F13BE847307U,
+			0xB1D219647AE6B31CU, 0x596EB2D8AE258FC8U,
+			0xDE469FBD99A05FE3U, 0x6FCA5F8ED9AEF3BBU,
+			0x8AEC23D680043BEEU, 0x25DE7BB9480D5854U,
+			0xADA72CCC20054AE9U, 0xAF561AA79A10AE6AU,
+			0xD910F7FF28069DA4U, 0x1B2BA1518094DA04U,
+			0x87AA9AFF79042286U, 0x90FB44D2F05D0842U,
+			0xA99541BF57452B28U, 0x353A1607AC744A53U,
+			0xD3FA922F2D1675F2U, 0x42889B8997915CE8U,
+			0x847C9B5D7C2E09B7U, 0x69956135FEBADA11U,
+			0xA59BC234DB398C25U, 0x43FAB9837E699095U,
+			0xCF02B2C21207EF2EU, 0x94F967E45E03F4BBU,
+			0x8161AFB94B44F57DU, 0x1D1BE0EEBAC278F5U,
+			0xA1BA1BA79E1632DCU, 0x6462D92A69731732U,
+			0xCA28A291859BBF93U, 0x7D7B8F7503CFDCFEU,
+			0xFCB2CB35E702AF78U, 0x5CDA735244C3D43EU,
+			0x9DEFBF01B061ADABU, 0x3A0888136AFA64A7U,
+			0xC56BAEC21C7A1916U, 0x088AAA1845B8FDD0U,
+			0xF6C69A72A3989F5BU, 0x8AAD549E57273D45U,
+			0x9A3C2087A63F6399U, 0x36AC54E2F678864BU,
+			0xC0CB28A98FCF3C7FU, 0x84576A1BB416A7DDU,
+			0xF0FDF2D3F3C30B9FU, 0x656D44A2A11C51D5U,
+			0x969EB7C47859E743U, 0x9F644AE5A4B1B325U,
+			0xBC4665B596706114U, 0x873D5D9F0DDE1FEEU,
+			0xEB57FF22FC0C7959U, 0xA90CB506D155A7EAU,
+			0x9316FF75DD87CBD8U, 0x09A7F12442D588F2U,
+			0xB7DCBF5354E9BECEU, 0x0C11ED6D538AEB2FU,
+			0xE5D3EF282A242E81U, 0x8F1668C8A86DA5FAU,
+			0x8FA475791A569D10U, 0xF96E017D694487BCU,
+			0xB38D92D760EC4455U, 0x37C981DCC395A9ACU,
+			0xE070F78D3927556AU, 0x85BBE253F47B1417U,
+			0x8C469AB843B89562U, 0x93956D7478CCEC8EU,
+			0xAF58416654A6BABBU, 0x387AC8D1970027B2U,
+			0xDB2E51BFE9D0696AU, 0x06997B05FCC0319EU,
+			0x88FCF317F22241E2U, 0x441FECE3BDF81F03U,
+			0xAB3C2FDDEEAAD25AU, 0xD527E81CAD7626C3U,
+			0xD60B3BD56A5586F1U, 0x8A71E223D8D3B074U,
+			0x85C7056562757456U, 0xF6872D5667844E49U,
+			0xA738C6BEBB12D16CU, 0xB428F8AC016561DBU,
+			0xD106F86E69D785C7U, 0xE13336D701BEBA52U,
+			0x82A45B450226B39CU, 0xECC0024661173473U,
+			0xA34D721642B06084U, 0x27F002D7F95D0190U,
+			0xCC20CE9BD35C78A5U, 0x31EC038DF7B441F4U,
+			0xFF290242C83396CEU, 0x7E67047175A15271U,
+			0x9F79A169BD203E41U, 0x0F0062C6E984D386U,
+			0xC75809C42C684DD1U, 0x52C07B78A3E60868U,
+			0xF92E0C3537826145U, 0xA7709A56CCDF8A82U,
+			0x9BBCC7A142B17CCBU, 0x88A66076400BB691U,
+			0xC2ABF989935DDBFEU, 0x6ACFF893D00EA435U,
+			0xF356F7EBF83552FEU, 0x0583F6B8C4124D43U,
+			0x98165AF37B2153DEU, 0xC3727A337A8B704AU,
+			0xBE1BF1B059E9A8D6U, 0x744F18C0592E4C5CU,
+			0xEDA2EE1C7064130CU, 0x1162DEF06F79DF73U,
+			0x9485D4D1C63E8BE7U, 0x8ADDCB5645AC2BA8U,
+			0xB9A74A0637CE2EE1U, 0x6D953E2BD7173692U,
+			0xE8111C87C5C1BA99U, 0xC8FA8DB6CCDD0437U,
+			0x910AB1D4DB9914A0U, 0x1D9C9892400A22A2U,
+			0xB54D5E4A127F59C8U, 0x2503BEB6D00CAB4BU,
+			0xE2A0B5DC971F303AU, 0x2E44AE64840FD61DU,
+			0x8DA471A9DE737E24U, 0x5CEAECFED289E5D2U,
+			0xB10D8E1456105DADU, 0x7425A83E872C5F47U,
+			0xDD50F1996B947518U, 0xD12F124E28F77719U,
+			0x8A5296FFE33CC92FU, 0x82BD6B70D99AAA6FU,
+			0xACE73CBFDC0BFB7BU, 0x636CC64D1001550BU,
+			0xD8210BEFD30EFA5AU, 0x3C47F7E05401AA4EU,
+			0x8714A775E3E95C78U, 0x65ACFAEC34810A71U,
+			0xA8D9D1535CE3B396U, 0x7F1839A741A14D0DU,
+			0xD31045A8341CA07CU, 0x1EDE48111209A050U,
+			0x83EA2B892091E44DU, 0x934AED0AAB460432U,
+			0xA4E4B66B68B65D60U, 0xF81DA84D5617853FU,
+			0xCE1DE40642E3F4B9U, 0x36251260AB9D668EU,
+			0x80D2AE83E9CE78F3U, 0xC1D72B7C6B426019U,
+			0xA1075A24E4421730U, 0xB24CF65B8612F81FU,
+			0xC94930AE1D529CFCU, 0xDEE033F26797B627U,
+			0xFB9B7CD9A4A7443CU, 0x169840EF017DA3B1U,
+			0x9D412E0806E88AA5U, 0x8E1F289560EE864EU,
+			0xC491798A08A2AD4EU, 0xF1A6F2BAB92A27E2U,
+			0xF5B5D7EC8ACB58A2U, 0xAE10AF696774B1DBU,
+			0x9991A6F3D6BF1765U, 0xACCA6DA1E0A8EF29U,
+			0xBFF610B0CC6EDD3FU, 0x17FD090A58D32AF3U,
+			0xEFF394DCFF8A948EU, 0xDDFC4B4CEF07F5B0U,
+			0x95F83D0A1FB69CD9U, 0x4ABDAF101564F98EU,
+			0xBB764C4CA7A4440FU, 0x9D6D1AD41ABE37F1U,
+			0xEA53DF5FD18D5513U, 0x84C86189216DC5EDU,
+			0x92746B9BE2F8552CU, 0x32FD3CF5B4E49BB4U,
+			0xB7118682DBB66A77U, 0x3FBC8C33221DC2A1U,
+			0xE4D5E82392A40515U, 0x0FABAF3FEAA5334AU,
+			0x8F05B1163BA6832DU, 0x29CB4D87F2A7400EU,
+			0xB2C71D5BCA9023F8U, 0x743E20E9EF511012U,
+			0xDF78E4B2BD342CF6U, 0x914DA9246B255416U,
+			0x8BAB8EEFB6409C1AU, 0x1AD089B6C2F7548EU,
+			0xAE9672ABA3D0C320U, 0xA184AC2473B529B1U,
+			0xDA3C0F568CC4F3E8U, 0xC9E5D72D90A2741EU,
+			0x8865899617FB1871U, 0x7E2FA67C7A658892U,
+			0xAA7EEBFB9DF9DE8DU, 0xDDBB901B98FEEAB7U,
+			0xD51EA6FA85785631U, 0x552A74227F3EA565U,
+			0x8533285C936B35DEU, 0xD53A88958F87275FU,
+			0xA67FF273B8460356U, 0x8A892ABAF368F137U,
+			0xD01FEF10A657842CU, 0x2D2B7569B0432D85U,
+			0x8213F56A67F6B29BU, 0x9C3B29620E29FC73U,
+			0xA298F2C501F45F42U, 0x8349F3BA91B47B8FU,
+			0xCB3F2F7642717713U, 0x241C70A936219A73U,
+			0xFE0EFB53D30DD4D7U, 0xED238CD383AA0110U,
+			0x9EC95D1463E8A506U, 0xF4363804324A40AAU,
+			0xC67BB4597CE2CE48U, 0xB143C6053EDCD0D5U,
+			0xF81AA16FDC1B81DAU, 0xDD94B7868E94050AU,
+			0x9B10A4E5E9913128U, 0xCA7CF2B4191C8326U,
+			0xC1D4CE1F63F57D72U, 0xFD1C2F611F63A3F0U,
+			0xF24A01A73CF2DCCFU, 0xBC633B39673C8CECU,
+			0x976E41088617CA01U, 0xD5BE0503E085D813U,
+			0xBD49D14AA79DBC82U, 0x4B2D8644D8A74E18U,
+			0xEC9C459D51852BA2U, 0xDDF8E7D60ED1219EU,
+			0x93E1AB8252F33B45U, 0xCABB90E5C942B503U,
+			0xB8DA1662E7B00A17U, 0x3D6A751F3B936243U,
+			0xE7109BFBA19C0C9DU, 0x0CC512670A783AD4U,
+			0x906A617D450187E2U, 0x27FB2B80668B24C5U,
+			0xB484F9DC9641E9DAU, 0xB1F9F660802DEDF6U,
+			0xE1A63853BBD26451U, 0x5E7873F8A0396973U,
+			0x8D07E33455637EB2U, 0xDB0B487B6423E1E8U,
+			0xB049DC016ABC5E5FU, 0x91CE1A9A3D2CDA62U,
+			0xDC5C5301C56B75F7U, 0x7641A140CC7810FBU,
+			0x89B9B3E11B6329BAU, 0xA9E904C87FCB0A9DU,
+			0xAC2820D9623BF429U, 0x546345FA9FBDCD44U,
+			0xD732290FBACAF133U, 0xA97C177947AD4095U,
+			0x867F59A9D4BED6C0U, 0x49ED8EABCCCC485DU,
+			0xA81F301449EE8C70U, 0x5C68F256BFFF5A74U,
+			0xD226FC195C6A2F8CU, 0x73832EEC6FFF3111U,
+			0x83585D8FD9C25DB7U, 0xC831FD53C5FF7EABU,
+			0xA42E74F3D032F525U, 0xBA3E7CA8B77F5E55U,
+			0xCD3A1230C43FB26FU, 0x28CE1BD2E55F35EBU,
+			0x80444B5E7AA7CF85U, 0x7980D163CF5B81B3U,
+			0xA0555E361951C366U, 0xD7E105BCC332621FU,
+			0xC86AB5C39FA63440U, 0x8DD9472BF3FEFAA7U,
+			0xFA856334878FC150U, 0xB14F98F6F0FEB951U,
+			0x9C935E00D4B9D8D2U, 0x6ED1BF9A569F33D3U,
+			0xC3B8358109E84F07U, 0x0A862F80EC4700C8U,
+			0xF4A642E14C6262C8U, 0xCD27BB612758C0FAU,
+			0x98E7E9CCCFBD7DBDU, 0x8038D51CB897789CU,
+			0xBF21E44003ACDD2CU, 0xE0470A63E6BD56C3U,
+			0xEEEA5D5004981478U, 0x1858CCFCE06CAC74U,
+			0x95527A5202DF0CCBU, 0x0F37801E0C43EBC8U,
+			0xBAA718E68396CFFDU, 0xD30560258F54E6BAU,
+			0xE950DF20247C83FDU, 0x47C6B82EF32A2069U,
+			0x91D28B7416CDD27EU, 0x4CDC331D57FA5441U,
+			0xB6472E511C81471DU, 0xE0133FE4ADF8E952U,
+			0xE3D8F9E563A198E5U, 0x58180FDDD97723A6U,
+			0x8E679C2F5E44FF8FU, 0x570F09EAA7EA7648U
+		}};
+
+		struct uint128_t final
+		{
+			uint64_t low;
+			uint64_t high;
+		};
+
+		/*! @internal @brief Computes the full 128-bit product of two 64-bit integers */
+		inline uint128_t fullMultiply(const uint64_t a, const uint64_t b) noexcept
+		{
+#if defined(__SIZEOF_INT128__)
+			__extension__ typedef unsigned __int128 u128_t;
+			const u128_t product = u128_t{a} * b;
+			return {uint64_t(product), uint64_t(product >> 64U)};
+#else
+			const uint64_t aLow = a & 0xFFFFFFFFU;
+			const uint64_t aHigh = a >> 32U;
+			const uint64_t bLow = b & 0xFFFFFFFFU;
+			const uint64_t bHigh = b >> 32U;
+			const uint64_t lowLow = aLow * bLow;
+			const uint64_t highLow = aHigh * bLow;
+			const uint64_t lowHigh = aLow * bHigh;
+			const uint64_t highHigh = aHigh * bHigh;
+			const uint64_t middle = (lowLow >> 32U) + (highLow & 0xFFFFFFFFU) + lowHigh;
+			return {(middle << 32U) | (lowLow & 0xFFFFFFFFU), highHigh + (highLow >> 32U) + (middle >> 32U)};
+#endif
+		}
+
+		/*! @internal @brief Counts the number of leading zero bits in a non-zero 64-bit integer */
+		inline uint32_t leadingZeros(uint64_t value) noexcept
+		{
+#if defined(__GNUC__)
+			return uint32_t(__builtin_clzll(value));
+#else
+			uint32_t count{0};
+			for (; !(value & 0x8000000000000000U); value <<= 1U)
+				++count;
+			return count;
+#endif
+		}
+
+		/*! @internal @brief Computes floor(log2(10^q)) + 63, valid for q in [-1233, 1233] */
+		constexpr inline int32_t binaryPower(const int32_t q) noexcept
+			{ return ((q * (152170 + 65536)) >> 16) + 63; }
+
+		/*!
+		 * @internal
+		 * @brief Computes the bit pattern of the correctly rounded value of w * 10^q
+		 * @param w The decimal mantissa
+		 * @param q The decimal exponent
+		 * @param result The variable to store the resulting bit pattern in (without sign)
+		 * @returns false if the result could not be determined without more precision, true otherwise
+		 */
+		template<typename T> bool eiselLemire(uint64_t w, const int64_t q, typename binaryFormat_t<T>::bits_t &result) noexcept
+		{
+			using format = binaryFormat_t<T>;
+			using bits_t = typename format::bits_t;
+			constexpr uint32_t mantissaShift = 64U - format::mantissaBits - 3U;
+
+			if (!w || q < format::smallestPowerOfTen)
+			{
+				result = 0;
+				return true;
+			}
+			else if (q > format::largestPowerOfTen)
+			{
+				result = bits_t(format::infinitePower) << bits_t(format::mantissaBits);
+				return true;
+			}
+
+			// Normalise the mantissa and multiply it by the 128-bit approximation of 5^q
+			const uint32_t zeros = leadingZeros(w);
+			w <<= zeros;
+			const auto index = size_t((q - smallestPowerOfFive) * 2);
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+			uint128_t product = fullMultiply(w, powersOfFive[index]);
+			// If the bits below the ones we need are all set, the truncation of 5^q might matter, so refine
+			constexpr uint64_t precisionMask = UINT64_MAX >> (format::mantissaBits + 3U);
+			if ((product.high & precisionMask) == precisionMask)
+			{
+				// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+				const uint128_t secondProduct = fullMultiply(w, powersOfFive[index + 1U]);
+				product.low += secondProduct.high;
+				if (secondProduct.high > product.low)
+					++product.high;
+			}
+			// Even the refined product could still be off by one here, so let the slow path decide
+			if (product.low == UINT64_MAX && (q < -27 || q > 55))
+				return false;
+
+			const auto upperBit = uint32_t(product.high >> 63U);
+			uint64_t mantissa = product.high >> (upperBit + mantissaShift);
+			int32_t power2 = binaryPower(int32_t(q)) + int32_t(upperBit) - int32_t(zeros) - format::minExponent;
+
+			if (power2 <= 0)
+			{
+				// The result is subnormal (or too small to represent at all)
+				if (-power2 + 1 >= 64)
+				{
+					result = 0;
+					return true;
+				}
+				mantissa >>= uint32_t(-power2 + 1);
+				mantissa += mantissa & 1U;
+				mantissa >>= 1U;
+				// Rounding may have carried us back up into the normal range
+				power2 = mantissa < (uint64_t{1} << uint32_t(format::mantissaBits)) ? 0 : 1;
+				result = bits_t(mantissa | (uint64_t(power2) << uint32_t(format::mantissaBits)));
+				return true;
+			}
+
+			// If we're exactly half way between two values, round to even rather than up
+			if (product.low <= 1 && q >= format::minRoundToEven && q <= format::maxRoundToEven &&
+				(mantissa & 3U) == 1U && (mantissa << (upperBit + mantissaShift)) == product.high)
+				mantissa &= ~uint64_t{1U};
+			mantissa += mantissa & 1U;
+			mantissa >>= 1U;
+			if (mantissa >= (uint64_t{2} << uint32_t(format::mantissaBits)))
+			{
+				mantissa = uint64_t{1} << uint32_t(format::mantissaBits);
+				++power2;
+			}
+			mantissa &= ~(uint64_t{1} << uint32_t(format::mantissaBits));
+			if (power2 >= format::infinitePower)
+			{
+				power2 = format::infinitePower;
+				mantissa = 0;
+			}
+			result = bits_t(mantissa | (uint64_t(power2) << uint32_t(format::mantissaBits)));
+			return true;
+		}
+
+		/*!
+		 * @internal
+		 * @brief Performs the conversion via the classic "C" locale for the inputs the fast algorithms can't handle
+		 * @note The input must already have been validated, so the only way the stream can fail is on a range error.
+		 * Streams report overflow as the largest finite value and (on some implementations) underflow as zero,
+		 * so these get mapped to the infinity or zero that the fast paths produce for the same input.
+		 */
+		template<typename T> bool slowParse(const char *const str, const size_t len, const bool negative, T &value) noexcept try
+		{
+			std::istringstream stream{std::string{str, len}};
+			stream.imbue(std::locale::classic());
+			stream >> value;
+			if (!stream.fail())
+				return stream.eof();
+			const T magnitude = value != 0 ? std::numeric_limits<T>::infinity() : T{};
+			value = negative ? -magnitude : magnitude;
+			return true;
+		}
+		catch (...) { return false; }
+
+		template<typename T> bool parseFloating(const char *const str, const size_t len, T &value) noexcept
+		{
+			using format = binaryFormat_t<T>;
+			using bits_t = typename format::bits_t;
+			const char *const end = str + len;
+			const char *digit = str;
+			const bool negative = digit != end && *digit == '-';
+			if (negative)
+				++digit;
+
+			uint64_t mantissa{0};
+			int64_t exponent{0};
+			size_t significantDigits{0};
+			bool haveDigits{false};
+			// More than 19 significant digits can't be held exactly in the mantissa
+			bool truncated{false};
+			// Accumulate the integer part of the number
+			for (; digit != end && isDigit(*digit); ++digit)
+			{
+				haveDigits = true;
+				if (!mantissa && *digit == '0')
+					continue;
+				if (++significantDigits > 19)
+					truncated = true;
+				else
+					mantissa = (mantissa * 10U) + uint8_t(*digit - '0');
+			}
+			// Then the fractional part, adjusting the exponent for each digit
+			if (digit != end && *digit == '.')
+			{
+				for (++digit; digit != end && isDigit(*digit); ++digit)
+				{
+					haveDigits = true;
+					--exponent;
+					if (!mantissa && *digit == '0')
+						continue;
+					if (++significantDigits > 19)
+						truncated = true;
+					else
+						mantissa = (mantissa * 10U) + uint8_t(*digit - '0');
+				}
+			}
+			if (!haveDigits)
+				return false;
+
+			// And finally the explicit exponent, if there is one
+			if (digit != end && (*digit == 'e' || *digit == 'E'))
+			{
+				++digit;
+				const bool negativeExponent = digit != end && *digit == '-';
+				if (digit != end && (*digit == '-' || *digit == '+'))
+					++digit;
+				if (digit == end || !isDigit(*digit))
+					return false;
+				int64_t power{0};
+				for (; digit != end && isDigit(*digit); ++digit)
+				{
+					// Anything this large is infinite or zero anyway, so stop accumulating before overflow
+					if (power < 100000)
+						power = (power * 10) + uint8_t(*digit - '0');
+				}
+				exponent += negativeExponent ? -power : power;
+			}
+			if (digit != end)
+				return false;
+			// Now the input is known to be well formed, hand any that have too many digits to the slow path
+			if (truncated)
+				return slowParse(str, len, negative, value);
+
+#if FLT_EVAL_METHOD == 0
+			// Clinger's fast path - when both the mantissa and the power of ten are exact, a single
+			// correctly rounded IEEE multiply or divide gives the correctly rounded result
+			if (exponent >= -format::maxFastPower && exponent <= format::maxFastPower &&
+				mantissa <= format::maxFastMantissa)
+			{
+				auto result = T(mantissa);
+				if (exponent < 0)
+					result /= powerOfTen(result, size_t(-exponent));
+				else
+					result *= powerOfTen(result, size_t(exponent));
+				value = negative ? -result : result;
+				return true;
+			}
+#endif
+
+			bits_t bits{};
+			if (!eiselLemire<T>(mantissa, exponent, bits))
+				return slowParse(str, len, negative, value);
+			if (negative)
+				bits |= bits_t{1U} << (sizeof(bits_t) * 8U - 1U);
+			memcpy(&value, &bits, sizeof(T));
+			return true;
+		}
+
+		bool parseFloat(const char *const str, const size_t len, float &value) noexcept
+			{ return parseFloating(str, len, value); }
+		bool parseDouble(const char *const str, const size_t len, double &value) noexcept
+			{ return parseFloating(str, len, value); }
+	} // namespace numeric
+} // namespace tmplORM
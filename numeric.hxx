@@ -0,0 +1,131 @@
+#ifndef NUMERIC_HXX
+#define NUMERIC_HXX
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+/*!
+ * @internal
+ * @file
+ * @author Rachel Mant
+ * @date 2026
+ * @brief Locale-independent decoding of the decimal text that database wire protocols hand back for numbers
+ */
+
+namespace tmplORM
+{
+	namespace numeric
+	{
+		/*! @internal @brief Returns a boolean indicating if the given character is a decimal digit or not */
+		inline bool isDigit(const char x) noexcept { return uint8_t(x - '0') <= 9U; }
+
+		/*!
+		 * @internal
+		 * @brief Loads 8 characters as a single integer such that the first character is in the lowest byte
+		 * @param str The string to load 8 characters from
+		 */
+		inline uint64_t loadChunk(const char *const str) noexcept
+		{
+			uint64_t chunk{};
+			memcpy(&chunk, str, sizeof(chunk));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+			chunk = __builtin_bswap64(chunk);
+#endif
+			return chunk;
+		}
+
+		/*!
+		 * @internal
+		 * @brief Checks all 8 characters of a chunk are decimal digits in one go
+		 * @details Digits are 0x30-0x39, so the top nibble of every byte must be 3, and adding 6 to
+		 *     the bottom nibble must not carry into the top nibble.
+		 */
+		inline bool isEightDigits(const uint64_t chunk) noexcept
+		{
+			return ((chunk & 0xF0F0F0F0F0F0F0F0U) |
+				(((chunk + 0x0606060606060606U) & 0xF0F0F0F0F0F0F0F0U) >> 4U)) == 0x3333333333333333U;
+		}
+
+		/*!
+		 * @internal
+		 * @brief Converts a chunk of 8 decimal digits into its value without a multiply per digit
+		 * @details This first combines adjacent digits into pairs, then combines the 4 pairs into a
+		 *     single 8 digit number using a pair of multiplies to perform the final weighting.
+		 */
+		inline uint32_t parseEightDigits(uint64_t chunk) noexcept
+		{
+			chunk -= 0x3030303030303030U;
+			chunk = (chunk * 10U) + (chunk >> 8U);
+			chunk = (((chunk & 0x000000FF000000FFU) * 0x000F424000000064U) +
+				(((chunk >> 16U) & 0x000000FF000000FFU) * 0x0000271000000001U)) >> 32U;
+			return uint32_t(chunk);
+		}
+
+		/*!
+		 * @internal
+		 * @brief Converts a string of decimal digits into an unsigned 64-bit integer
+		 * @param str The string of digits to convert
+		 * @param len The number of digits in the string
+		 * @param value The variable to store the converted value into
+		 * @returns true if the string was entirely digits and fits in 64 bits, false otherwise
+		 */
+		inline bool parseUint(const char *str, size_t len, uint64_t &value) noexcept
+		{
+			// Leading zeros carry no value and would otherwise count against the 20 digit limit
+			while (len > 1 && *str == '0')
+			{
+				++str;
+				--len;
+			}
+			if (!len || len > 20)
+				return false;
+
+			// The first 19 digits can never overflow, so accumulate those 8 at a time where possible
+			const size_t safeLen = len > 19 ? 19 : len;
+			uint64_t result{0};
+			size_t i{0};
+			for (; i + 8U <= safeLen; i += 8U)
+			{
+				const uint64_t chunk = loadChunk(str + i);
+				if (!isEightDigits(chunk))
+					return false;
+				result = (result * 100000000U) + parseEightDigits(chunk);
+			}
+			for (; i < safeLen; ++i)
+			{
+				if (!isDigit(str[i]))
+					return false;
+				result = (result * 10U) + uint8_t(str[i] - '0');
+			}
+
+			if (len == 20)
+			{
+				if (!isDigit(str[19]))
+					return false;
+				const auto digit = uint8_t(str[19] - '0');
+				if (result > (std::numeric_limits<uint64_t>::max() - digit) / 10U)
+					return false;
+				result = (result * 10U) + digit;
+			}
+			value = result;
+			return true;
+		}
+
+		/*!
+		 * @internal
+		 * @brief Converts a decimal floating point string into the correctly rounded nearest float
+		 * @returns true if the string was a valid number, false otherwise
+		 */
+		extern bool parseFloat(const char *str, size_t len, float &value) noexcept;
+		/*!
+		 * @internal
+		 * @brief Converts a decimal floating point string into the correctly rounded nearest double
+		 * @returns true if the string was a valid number, false otherwise
+		 */
+		extern bool parseDouble(const char *str, size_t len, double &value) noexcept;
+	} // namespace numeric
+} // namespace tmplORM
+
+#endif /*NUMERIC_HXX*/
@@ -1,4 +1,15 @@
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <algorithm>
+#include <array>
 #include <utility>
+#ifndef _WINDOWS
+#include <poll.h>
+#else
+#include <winsock2.h>
+#define poll WSAPoll
+#endif
 #include <substrate/index_sequence>
 #include <substrate/buffer_utils>
 // AAAAAAAAGGGGHHH.. this should be in the libpq headers, but no distro puts it where they should.
@@ -15,160 +26,1585 @@
 
 using namespace tmplORM::pgsql::driver;
 
-constexpr static int32_t postgresDateEpoch{2451545};
+// The number of days from 0000-03-01 to the Postgres epoch of 2000-01-01, plus a further 12 400-year
+// eras so that every date Postgres can represent (back to 4713BC) gives a non-negative day number
+constexpr static uint32_t civilDaysOffset{730425U + (12U * 146097U)};
+constexpr static int32_t civilYearsOffset{12 * 400};
+constexpr static int64_t microsecondsPerDay{INT64_C(86400000000)};
+// How many values the batch date decoders convert at a time, which keeps their scratch space on the stack
+constexpr static size_t dateBlockLength{256U};
+// These get bound to references, so need their definitions too
+constexpr size_t pgSQLPipeline_t::queryResult;
+constexpr size_t pgSQLCopyIn_t::chunkLength;
 
 pgSQLClient_t::pgSQLClient_t(pgSQLClient_t &&con) noexcept : pgSQLClient_t()
-	{ std::swap(connection, con.connection); }
-pgSQLClient_t::~pgSQLClient_t() noexcept { disconnect(); }
+{
+	std::swap(connection, con.connection);
+	std::swap(connectionID, con.connectionID);
+	std::swap(lastConnectionID, con.lastConnectionID);
+	preparedQueries.swap(con.preparedQueries);
+	paramCache.swap(con.paramCache);
+	parkedConnections.swap(con.parkedConnections);
+}
+pgSQLClient_t::~pgSQLClient_t() noexcept
+{
+	// Named queries use this client right up to their destruction, so none may outlive it
+	assert(!liveQueries);
+	disconnect();
+}
+
+void pgSQLClient_t::operator=(pgSQLClient_t &&con) noexcept
+{
+	std::swap(connection, con.connection);
+	std::swap(connectionID, con.connectionID);
+	std::swap(lastConnectionID, con.lastConnectionID);
+	std::swap(needsCommit, con.needsCommit);
+	preparedQueries.swap(con.preparedQueries);
+	paramCache.swap(con.paramCache);
+	parkedConnections.swap(con.parkedConnections);
+}
+
+bool pgSQLClient_t::connect(const char *const host, const char *const port, const char *const user,
+	const char *const passwd, const char *const db) noexcept
+{
+	if (valid())
+		return false;
+	connection = PQsetdbLogin(host, port, nullptr, nullptr, db, user, passwd);
+	if (PQstatus(connection) != CONNECTION_OK)
+		disconnect();
+	else
+		connectionID = ++lastConnectionID;
+	return valid();
+}
+
+void pgSQLClient_t::disconnect() noexcept
+{
+	if (connection)
+	{
+		if (needsCommit)
+			rollback();
+		PQfinish(connection);
+		connection = nullptr;
+		connectionID = 0;
+		// Named statements only live as long as the connection they were prepared on
+		preparedQueries.clear();
+	}
+	for (const auto &parked : parkedConnections)
+		PQfinish(parked.connection);
+	parkedConnections.clear();
+}
+
+/*!
+ * @brief Switches this client to another database on the same server
+ * @details The connection being switched away from is kept open, so switching back to its database later
+ *     hands it straight back along with its named statements, rather than connecting and authenticating anew.
+ *     At most maxParkedConnections connections are kept open this way, the least recently used being closed
+ *     to make room once there are that many. Switching is refused while a transaction is in progress,
+ *     as parking the connection would leave the transaction open on it.
+ * @returns true if the switch succeeded, false otherwise - in which case the client is still connected to
+ *     the database it was on before the switch was attempted
+ */
+bool pgSQLClient_t::switchDB(const char *const db) noexcept
+{
+	if (!valid() || needsCommit)
+		return false;
+	if (db && strcmp(PQdb(connection), db) == 0)
+		return true;
+	if (db && unpark(db))
+		return true;
+
+	auto *const settings{PQconninfo(connection)};
+	if (!settings)
+		return false;
+	const auto findSetting{[&](const char *const name) -> const char *
+	{
+		for (size_t i{}; settings[i].keyword != nullptr; ++i)
+		{
+			if (strcmp(settings[i].keyword, name) == 0)
+				return settings[i].val;
+		}
+		return nullptr;
+	}};
+	const auto *const host{findSetting("host")};
+	const auto *const port{findSetting("port")};
+	const auto *const user{findSetting("user")};
+	const auto *const passwd{findSetting("password")};
+	auto *const newConnection{PQsetdbLogin(host, port, nullptr, nullptr, db, user, passwd)};
+	PQconninfoFree(settings);
+	if (PQstatus(newConnection) != CONNECTION_OK)
+	{
+		PQfinish(newConnection);
+		return false;
+	}
+	park();
+	connection = newConnection;
+	connectionID = ++lastConnectionID;
+	return true;
+}
+
+/*!
+ * @internal
+ * @brief Swaps the current connection for the parked connection to the given database, if there is one
+ * @returns true if the switch was made, false if there is no usable parked connection to that database
+ */
+bool pgSQLClient_t::unpark(const char *const db) noexcept
+{
+	size_t index{0};
+	while (index < parkedConnections.size() && strcmp(PQdb(parkedConnections[index].connection), db) != 0)
+		++index;
+	if (index == parkedConnections.size())
+		return false;
+	// Move the match to the back, leaving the rest in least recently used order
+	for (; index + 1U < parkedConnections.size(); ++index)
+		std::swap(parkedConnections[index], parkedConnections[index + 1U]);
+	auto &parked{parkedConnections.back()};
+	// A connection the server has since dropped is no use to switch back to, so get rid of it
+	if (PQstatus(parked.connection) != CONNECTION_OK)
+	{
+		PQfinish(parked.connection);
+		parkedConnections.pop_back();
+		return false;
+	}
+	// The current connection takes the parked one's place as the most recently used
+	std::swap(connection, parked.connection);
+	std::swap(connectionID, parked.connectionID);
+	preparedQueries.swap(parked.preparedQueries);
+	return true;
+}
+
+/*!
+ * @internal
+ * @brief Parks the current connection for switchDB() to switch back to, leaving the client disconnected
+ * @details If the connection cannot be parked, it is closed instead
+ */
+void pgSQLClient_t::park() noexcept try
+{
+	if (parkedConnections.size() >= maxParkedConnections)
+	{
+		PQfinish(parkedConnections.front().connection);
+		parkedConnections.erase(parkedConnections.begin());
+	}
+	parkedConnections.push_back({connection, connectionID, std::move(preparedQueries)});
+	connection = nullptr;
+	connectionID = 0;
+	preparedQueries.clear();
+}
+catch (const std::bad_alloc &)
+{
+	PQfinish(connection);
+	connection = nullptr;
+	preparedQueries.clear();
+}
+
+bool pgSQLClient_t::beginTransact() noexcept
+{
+	if (!valid() || needsCommit)
+		return false;
+	const auto result{query("BEGIN")};
+	needsCommit = result.errorNum() == PGRES_COMMAND_OK;
+	return needsCommit;
+}
+
+bool pgSQLClient_t::endTransact(const bool commitSuccess) noexcept
+{
+	if (valid() && needsCommit)
+	{
+		const auto result{query(commitSuccess ? "COMMIT" : "ROLLBACK")};
+		needsCommit = result.errorNum() != PGRES_COMMAND_OK;
+	}
+	return !needsCommit;
+}
+
+pgSQLResult_t pgSQLClient_t::query(const char *const queryStmt) const noexcept
+	{ return {PQexecParams(connection, queryStmt, 0, nullptr, nullptr, nullptr, nullptr, 1)}; }
+
+/*!
+ * @param valuesLength The space needed to hold all the non-pointer parameter values in their binary forms,
+ *     which the prepare() overload without this argument sets to enough for any set of parameter types
+ */
+pgSQLQuery_t pgSQLClient_t::prepare(const char *const queryStmt, const size_t paramsCount,
+	const size_t valuesLength) const noexcept
+{
+	if (!valid() || !queryStmt)
+		return {};
+	return {connection, queryStmt, paramsCount, valuesLength};
+}
+
+/*!
+ * @brief Creates a prepared query that is turned into a named server-side statement the first time it is executed
+ * @details Once prepared on this connection, executing the query again skips parsing and planning entirely.
+ *     Statements are looked up by the address of the query text, so this must only be used with query
+ *     text of static storage duration that never changes, such as that generated by toString<>.
+ *     The query refers back to this client, so must not outlive it. It stays usable across switchDB() until its
+ *     connection is closed, either by disconnect() or to make room for another parked connection.
+ */
+pgSQLQuery_t pgSQLClient_t::prepareNamed(const char *const queryStmt, const size_t paramsCount,
+	const size_t valuesLength) noexcept
+{
+	if (!valid() || !queryStmt)
+		return {};
+	return {*this, queryStmt, paramsCount, valuesLength};
+}
+
+/*!
+ * @internal
+ * @brief Finds the named statements of one of this client's connections, be it the current or a parked one
+ * @returns the query texts prepared on the connection, or nullptr if this client no longer has it open
+ */
+std::vector<const char *> *pgSQLClient_t::preparedOn(const uint64_t connID) noexcept
+{
+	if (!connID)
+		return nullptr;
+	if (connID == connectionID)
+		return &preparedQueries;
+	for (auto &parked : parkedConnections)
+	{
+		if (parked.connectionID == connID)
+			return &parked.preparedQueries;
+	}
+	return nullptr;
+}
+
+bool pgSQLClient_t::findPrepared(const uint64_t connID, const char *const queryStmt, size_t &index) noexcept
+{
+	const auto *const prepared{preparedOn(connID)};
+	if (!prepared)
+		return false;
+	for (size_t i{0}; i < prepared->size(); ++i)
+	{
+		if ((*prepared)[i] == queryStmt)
+		{
+			index = i;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool pgSQLClient_t::addPrepared(const uint64_t connID, const char *const queryStmt, size_t &index) noexcept try
+{
+	auto *const prepared{preparedOn(connID)};
+	if (!prepared)
+		return false;
+	index = prepared->size();
+	prepared->push_back(queryStmt);
+	return true;
+}
+catch (const std::bad_alloc &)
+	{ return false; }
+
+// Names are never reused, so this just stops the query text matching the (now non-existent) statement
+void pgSQLClient_t::removePrepared(const uint64_t connID, const size_t index) noexcept
+{
+	auto *const prepared{preparedOn(connID)};
+	if (prepared && index < prepared->size())
+		(*prepared)[index] = nullptr;
+}
+
+/*!
+ * @internal
+ * @brief Hands out the cached parameter storage if it's big enough, allocating new storage if not
+ */
+fixedVector_t<char> pgSQLClient_t::borrowParamStorage(const size_t length) noexcept
+{
+	if (paramCache.valid() && paramCache.count() >= length)
+		return std::move(paramCache);
+	return fixedVector_t<char>{length};
+}
+
+// Keeps whichever of the cached and returned storage is bigger, so the cache settles on the widest query's size
+void pgSQLClient_t::releaseParamStorage(fixedVector_t<char> &&storage) noexcept
+{
+	if (storage.count() > paramCache.count())
+		paramCache = std::move(storage);
+}
+
+size_t pgSQLClient_t::preparedCount() const noexcept
+{
+	size_t count{0};
+	for (const auto *const queryStmt : preparedQueries)
+		count += queryStmt ? 1U : 0U;
+	return count;
+}
+
+/*!
+ * @brief Creates a pipeline for sending many queries on this connection before collecting any of their results
+ * @returns a pgSQLPipeline_t to add queries to and then execute
+ */
+pgSQLPipeline_t pgSQLClient_t::pipeline() noexcept
+	{ return valid() ? pgSQLPipeline_t{*this} : pgSQLPipeline_t{}; }
+
+/*!
+ * @brief Runs a query, handing back its rows a few at a time as they arrive rather than all at once
+ * @details This keeps memory use bounded for large result sets, and lets the first rows be processed
+ *     before the rest of the result has been transferred.
+ * @returns a pgSQLResultStream_t positioned on the first row, which is invalid if the query could not be sent
+ */
+pgSQLResultStream_t pgSQLClient_t::stream(const char *const queryStmt) const noexcept
+{
+	if (!valid() || !queryStmt ||
+		!PQsendQueryParams(connection, queryStmt, 0, nullptr, nullptr, nullptr, nullptr, 1))
+		return {};
+	return {connection};
+}
+
+/*!
+ * @brief Sends a query to the server, returning straight away rather than waiting on the result
+ * @details Only one query can be in flight on a connection at a time - to run many queries at once,
+ *     use one connection per query and a pgSQLEventLoop_t to drive them all.
+ * @returns a pgSQLAsyncQuery_t to drive to completion, which is invalid if the query could not be sent
+ */
+pgSQLAsyncQuery_t pgSQLClient_t::queryAsync(const char *const queryStmt) const noexcept
+{
+	if (!valid() || !queryStmt || PQtransactionStatus(connection) == PQTRANS_ACTIVE ||
+		PQsetnonblocking(connection, 1))
+		return {};
+	if (!PQsendQueryParams(connection, queryStmt, 0, nullptr, nullptr, nullptr, nullptr, 1))
+	{
+		PQsetnonblocking(connection, 0);
+		return {};
+	}
+	return {connection};
+}
+
+/*!
+ * @brief Gets the connection's socket, for waiting on alongside other I/O in an event loop
+ * @returns the socket's file descriptor, or -1 if the client is not connected
+ */
+int pgSQLClient_t::socket() const noexcept
+	{ return valid() ? PQsocket(connection) : -1; }
+
+const char *pgSQLClient_t::error() const noexcept
+	{ return valid() ? PQerrorMessage(connection) : nullptr; }
+
+/*!
+ * @internal
+ * @param valuesLength The number of bytes needed to hold every non-pointer parameter value in its binary form
+ */
+pgSQLQuery_t::pgSQLQuery_t(PGconn *const conn, const char *const queryStmt, const size_t paramsCount,
+	const size_t valuesLength) noexcept : connection{conn}, query{queryStmt}, numParams{paramsCount}
+{
+	if (numParams)
+		paramStorage = fixedVector_t<char>{storageLength(numParams, valuesLength)};
+	layoutStorage();
+}
+
+pgSQLQuery_t::pgSQLQuery_t(pgSQLClient_t &conn, const char *const queryStmt, const size_t paramsCount,
+	const size_t valuesLength) noexcept : connection{conn.connection}, client{&conn},
+	connectionID{conn.connectionID}, query{queryStmt}, numParams{paramsCount}
+{
+	++conn.liveQueries;
+	if (numParams)
+		paramStorage = conn.borrowParamStorage(storageLength(numParams, valuesLength));
+	layoutStorage();
+}
+
+/*!
+ * @details A named query refers back to the client it was prepared on right up to its destruction,
+ *     so it must be destroyed before that client is - the client asserts that none are left.
+ */
+pgSQLQuery_t::~pgSQLQuery_t() noexcept
+{
+	if (!client)
+		return;
+	--client->liveQueries;
+	// Named queries hand their storage back to the client so the next one doesn't have to allocate any,
+	// so long as they're still on the client's current connection
+	if (paramStorage.valid() && connectionID == client->connectionID)
+		client->releaseParamStorage(std::move(paramStorage));
+}
+
+size_t pgSQLQuery_t::storageLength(const size_t paramsCount, const size_t valuesLength) noexcept
+{
+	return (paramsCount * (sizeof(const char *) + sizeof(valueSlot_t) + sizeof(Oid) + (sizeof(int) * 2U))) +
+		valuesLength;
+}
+
+/*!
+ * @internal
+ * @brief Carves the parameter storage up into the arrays libpq wants, all parameters starting out NULL
+ * @details The pointers go first as they have the strictest alignment requirements, with the value space last
+ */
+void pgSQLQuery_t::layoutStorage() noexcept
+{
+	if (!paramStorage.valid())
+		return;
+	params = static_cast<const char **>(static_cast<void *>(paramStorage.data()));
+	valueSlots = static_cast<valueSlot_t *>(static_cast<void *>(params + numParams));
+	paramTypes = static_cast<Oid *>(static_cast<void *>(valueSlots + numParams));
+	dataLengths = static_cast<int *>(static_cast<void *>(paramTypes + numParams));
+	paramFormats = dataLengths + numParams;
+	values = static_cast<char *>(static_cast<void *>(paramFormats + numParams));
+	valuesLength = paramStorage.count() - storageLength(numParams, 0U);
+	valuesUsed = 0;
+	bindFailed = false;
+	for (size_t i{0}; i < numParams; ++i)
+	{
+		params[i] = nullptr;
+		valueSlots[i] = {0U, 0U};
+		paramTypes[i] = InvalidOid;
+		dataLengths[i] = 0;
+		// Postgres uses 1 to indicate binary, and 0 for string.
+		paramFormats[i] = 1;
+	}
+}
+
+/*!
+ * @internal
+ * @brief Finds space for a parameter's value to be encoded into
+ * @details Each parameter is given its own slot the first time it is bound, which every later bind reuses
+ *     no matter whether the parameter was bound NULL in between. A slot is only replaced when a wider value
+ *     than it can hold is bound, so rebinding a query row after row never uses up the value space.
+ * @returns the space for the value, or nullptr if the query's value storage is exhausted
+ */
+char *pgSQLQuery_t::valueStorage(const size_t index, const size_t length) noexcept
+{
+	auto &slot{valueSlots[index]};
+	if (slot.length && slot.length >= length)
+		return values + slot.offset;
+	if (valuesLength - valuesUsed < length)
+		return nullptr;
+	slot = {valuesUsed, length};
+	valuesUsed += length;
+	return values + slot.offset;
+}
+
+// Statement names are "tmplORM_" followed by the statement's index in the client's prepared query list
+using statementName_t = std::array<char, 32>;
+
+static statementName_t preparedName(const size_t index) noexcept
+{
+	statementName_t name{};
+	snprintf(name.data(), name.size(), "tmplORM_%zu", index);
+	return name;
+}
+
+/*!
+ * @internal
+ * @brief Checks that a named query's connection is still open on its client
+ * @details switchDB() keeps the connections it switches away from open, each with its own named statements,
+ *     so a named query keeps working on its own connection until that is closed to make room for another.
+ *     Connections are told apart by ID rather than by PGconn, as a closed connection's PGconn can be reused.
+ */
+bool pgSQLQuery_t::connectionOpen() const noexcept
+	{ return !client || client->preparedOn(connectionID); }
+
+/*!
+ * @internal
+ * @brief Looks up the named statement for this query on its connection, reserving a new name if it is yet to be prepared
+ * @returns false if a new name could not be reserved, true otherwise
+ */
+bool pgSQLQuery_t::statementName(size_t &index, bool &needsPrepare) const noexcept
+{
+	needsPrepare = !client->findPrepared(connectionID, query, index);
+	return !needsPrepare || client->addPrepared(connectionID, query, index);
+}
+
+pgSQLResult_t pgSQLQuery_t::execute() const noexcept
+{
+	if (!valid() || !connectionOpen() || numParams > static_cast<size_t>(std::numeric_limits<int>::max()))
+		return {};
+	if (!client)
+		return {PQexecParams(connection, query, static_cast<int>(numParams), paramTypes,
+			params, dataLengths, paramFormats, 1)};
+
+	size_t index{};
+	bool needsPrepare{false};
+	if (!statementName(index, needsPrepare))
+		return {};
+	const auto name{preparedName(index)};
+	if (needsPrepare)
+	{
+		auto result{prepareStatement(name.data(), index)};
+		if (!result.valid() || result.errorNum() != PGRES_COMMAND_OK)
+			return result;
+	}
+	return {PQexecPrepared(connection, name.data(), static_cast<int>(numParams), params,
+		dataLengths, paramFormats, 1)};
+}
+
+/*!
+ * @internal
+ * @brief Prepares this query as the named statement given, forgetting the name again if that fails
+ */
+pgSQLResult_t pgSQLQuery_t::prepareStatement(const char *const name, const size_t index) const noexcept
+{
+	// The parameter types are fixed at this point as they're dictated by the fields that generated the query
+	pgSQLResult_t result{PQprepare(connection, name, query, static_cast<int>(numParams), paramTypes)};
+	if (!result.valid() || result.errorNum() != PGRES_COMMAND_OK)
+		client->removePrepared(connectionID, index);
+	return result;
+}
+
+/*!
+ * @internal
+ * @brief Sends the query to the server without waiting on its result
+ * @param canPrepare Whether a named query not yet prepared may be prepared first, which waits on the server
+ * @returns true if the query was sent, false otherwise
+ */
+bool pgSQLQuery_t::send(const bool canPrepare) const noexcept
+{
+	if (!valid() || !connectionOpen() || numParams > static_cast<size_t>(std::numeric_limits<int>::max()))
+		return false;
+
+	size_t index{};
+	bool usePrepared{false};
+	if (client && canPrepare)
+	{
+		bool needsPrepare{false};
+		if (!statementName(index, needsPrepare))
+			return false;
+		if (needsPrepare)
+		{
+			const auto result{prepareStatement(preparedName(index).data(), index)};
+			if (!result.valid() || result.errorNum() != PGRES_COMMAND_OK)
+				return false;
+		}
+		usePrepared = true;
+	}
+	else if (client)
+		usePrepared = client->findPrepared(connectionID, query, index);
+
+	if (!usePrepared)
+		return PQsendQueryParams(connection, query, static_cast<int>(numParams), paramTypes,
+			params, dataLengths, paramFormats, 1);
+	const auto name{preparedName(index)};
+	return PQsendQueryPrepared(connection, name.data(), static_cast<int>(numParams), params,
+		dataLengths, paramFormats, 1);
+}
+
+/*!
+ * @brief Executes the query, handing back its rows a few at a time as they arrive rather than all at once
+ * @returns a pgSQLResultStream_t positioned on the first row, which is invalid if the query could not be sent
+ */
+pgSQLResultStream_t pgSQLQuery_t::stream() const noexcept
+	{ return send(true) ? pgSQLResultStream_t{connection} : pgSQLResultStream_t{}; }
+
+/*!
+ * @brief Sends the query to the server, returning straight away rather than waiting on the result
+ * @details Preparing a named statement would mean waiting on the server, so a named query that is yet to be
+ *     prepared on this connection is instead run unnamed - it gets prepared the next time it is executed.
+ * @returns a pgSQLAsyncQuery_t to drive to completion, which is invalid if the query could not be sent
+ */
+pgSQLAsyncQuery_t pgSQLQuery_t::executeAsync() const noexcept
+{
+	if (!valid() || !connectionOpen() || PQtransactionStatus(connection) == PQTRANS_ACTIVE || PQsetnonblocking(connection, 1))
+		return {};
+	if (!send(false))
+	{
+		PQsetnonblocking(connection, 0);
+		return {};
+	}
+	return {connection};
+}
+
+Oid pgSQLQuery_t::typeToOID(pgSQLType_t type) noexcept
+{
+	switch (type)
+	{
+		case pgSQLType_t::boolean:
+			return BOOLOID;
+		case pgSQLType_t::int2:
+			return INT2OID;
+		case pgSQLType_t::int4:
+			return INT4OID;
+		case pgSQLType_t::int8:
+			return INT8OID;
+		case pgSQLType_t::float4:
+			return FLOAT4OID;
+		case pgSQLType_t::float8:
+			return FLOAT8OID;
+		case pgSQLType_t::unicode:
+			return VARCHAROID;
+		case pgSQLType_t::unicodeText:
+			return TEXTOID;
+		case pgSQLType_t::binary:
+			return BYTEAOID;
+		case pgSQLType_t::date:
+			return DATEOID;
+		case pgSQLType_t::time:
+			return TIMEOID;
+		case pgSQLType_t::dateTime:
+			return TIMESTAMPOID;
+		case pgSQLType_t::uuid:
+			return UUIDOID;
+		default:
+			return InvalidOid;
+	}
+}
+
+/*!
+ * @brief Binds an array as the value of a parameter. The array must outlive the query's execution
+ */
+void pgSQLQuery_t::bind(const size_t index, const pgSQLArray_t &array) noexcept
+{
+	if (index >= numParams || !params)
+		return;
+	paramTypes[index] = array.arrayType;
+	params[index] = array.data();
+	dataLengths[index] = static_cast<int>(array.length());
+}
+
+void pgSQLQuery_t::swap(pgSQLQuery_t &qry) noexcept
+{
+	std::swap(connection, qry.connection);
+	std::swap(client, qry.client);
+	std::swap(connectionID, qry.connectionID);
+	std::swap(query, qry.query);
+	std::swap(numParams, qry.numParams);
+	paramStorage.swap(qry.paramStorage);
+	std::swap(params, qry.params);
+	std::swap(valueSlots, qry.valueSlots);
+	std::swap(paramTypes, qry.paramTypes);
+	std::swap(dataLengths, qry.dataLengths);
+	std::swap(paramFormats, qry.paramFormats);
+	std::swap(values, qry.values);
+	std::swap(valuesLength, qry.valuesLength);
+	std::swap(valuesUsed, qry.valuesUsed);
+	std::swap(bindFailed, qry.bindFailed);
+}
+
+pgSQLPipeline_t::~pgSQLPipeline_t() noexcept { finish(); }
+
+/*!
+ * @internal
+ * @brief Puts the connection into pipeline mode ready for the first statement to be sent
+ * @details The connection is also made non-blocking so that sending the pipeline can never deadlock
+ *     against the server blocking on sending us results we are not yet reading.
+ */
+bool pgSQLPipeline_t::begin() noexcept
+{
+	auto *const connection{client->connection};
+	if (!pending.empty())
+		return PQpipelineStatus(connection) == PQ_PIPELINE_ON;
+	if (PQpipelineStatus(connection) != PQ_PIPELINE_OFF || !PQenterPipelineMode(connection))
+		return false;
+	if (PQsetnonblocking(connection, 1))
+	{
+		leave();
+		return false;
+	}
+	return true;
+}
+
+/*!
+ * @internal
+ * @brief Takes the connection back out of pipeline mode and puts it back to blocking
+ * @returns false if either could not be done, in which case the client's error() says why
+ */
+bool pgSQLPipeline_t::leave() const noexcept
+{
+	auto *const connection{client->connection};
+	const bool exited{PQexitPipelineMode(connection) == 1};
+	const bool blocking{PQsetnonblocking(connection, 0) == 0};
+	return exited && blocking;
+}
+
+/*!
+ * @internal
+ * @brief Sends everything queued on the connection, reading in results as they arrive so the server never stalls
+ */
+bool pgSQLPipeline_t::flush() const noexcept
+{
+	auto *const connection{client->connection};
+	while (true)
+	{
+		const auto result{PQflush(connection)};
+		if (result <= 0)
+			return !result;
+		pollfd socket{PQsocket(connection), POLLIN | POLLOUT, 0};
+		if (poll(&socket, 1, -1) == -1)
+		{
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+		if ((socket.revents & POLLIN) && !PQconsumeInput(connection))
+			return false;
+	}
+}
+
+// Each statement's result is followed by a nullptr to mark the end of that statement's results
+static PGresult *nextResult(PGconn *const connection) noexcept
+{
+	auto *const result{PQgetResult(connection)};
+	if (result)
+	{
+		auto *const terminator{PQgetResult(connection)};
+		if (terminator)
+			PQclear(terminator);
+	}
+	return result;
+}
+
+/*!
+ * @internal
+ * @brief Syncs the pipeline and reads back the results of every statement in the order they were added
+ * @param status Where to put the results - if this is too short, the remaining results are thrown away
+ * @returns true if every statement succeeded, false otherwise
+ */
+bool pgSQLPipeline_t::collect(fixedVector_t<pgSQLResult_t> &status) noexcept
+{
+	auto *const connection{client->connection};
+	bool ok{PQpipelineSync(connection) && flush()};
+	size_t statement{0};
+	for (const auto expected : pending)
+	{
+		pgSQLResult_t result{nextResult(connection)};
+		if (expected != queryResult)
+		{
+			if (!result.valid() || result.errorNum() != PGRES_COMMAND_OK)
+				client->removePrepared(client->connectionID, expected);
+			continue;
+		}
+		ok &= result.valid() && result.successful();
+		if (statement < status.count())
+			status.data()[statement] = std::move(result);
+		++statement;
+	}
+	const pgSQLResult_t sync{PQgetResult(connection)};
+	ok &= sync.errorNum() == PGRES_PIPELINE_SYNC;
+	// Failing to get the connection back to normal has to fail the pipeline, as it leaves the connection unusable
+	ok &= leave();
+	pending.clear();
+	statements = 0;
+	return ok;
+}
+
+// Statements are executed by the server as they arrive, so any left over still have to be seen through
+void pgSQLPipeline_t::finish() noexcept
+{
+	if (!valid() || pending.empty())
+		return;
+	else if (!client->valid())
+	{
+		// The connection went away, taking the pipeline with it
+		pending.clear();
+		statements = 0;
+		return;
+	}
+	fixedVector_t<pgSQLResult_t> discard{};
+	collect(discard);
+}
+
+/*!
+ * @brief Sends a bound query down the pipeline without waiting for its result
+ * @param query The query to send, which must have all of its parameters bound
+ * @returns true if the query was sent, false otherwise
+ */
+bool pgSQLPipeline_t::add(const pgSQLQuery_t &query) noexcept try
+{
+	if (!valid() || !client->valid() || !query.valid() || query.connection != client->connection ||
+		!query.connectionOpen() || query.numParams > static_cast<size_t>(std::numeric_limits<int>::max()))
+		return false;
+	// Reserve now so that recording what was sent can't fail
+	pending.reserve(pending.size() + 2U);
+	if (!begin())
+		return false;
+
+	auto *const connection{client->connection};
+	const auto numParams{static_cast<int>(query.numParams)};
+	// Statement names come from this pipeline's client, so only use them for queries named on it
+	if (query.client != client)
+	{
+		if (!PQsendQueryParams(connection, query.query, numParams, query.paramTypes,
+				query.params, query.dataLengths, query.paramFormats, 1))
+			return false;
+		pending.push_back(queryResult);
+		++statements;
+		return true;
+	}
+
+	size_t index{};
+	bool needsPrepare{false};
+	if (!query.statementName(index, needsPrepare))
+		return false;
+	const auto name{preparedName(index)};
+	if (needsPrepare)
+	{
+		if (!PQsendPrepare(connection, name.data(), query.query, numParams, query.paramTypes))
+		{
+			client->removePrepared(client->connectionID, index);
+			return false;
+		}
+		pending.push_back(index);
+	}
+	if (!PQsendQueryPrepared(connection, name.data(), numParams, query.params,
+			query.dataLengths, query.paramFormats, 1))
+		return false;
+	pending.push_back(queryResult);
+	++statements;
+	return true;
+}
+catch (const std::bad_alloc &)
+	{ return false; }
+
+/*!
+ * @brief Sends everything added to the pipeline to the server and collects the results, in order
+ * @details Outside of an explicit transaction, the server runs everything in the pipeline as a single
+ *     implicit transaction, and the first statement to fail causes all those after it to be skipped.
+ *     This also fails if the connection can't be taken back out of pipeline mode afterwards, in which
+ *     case the client's error() says why.
+ * @returns true if every statement in the pipeline succeeded, false otherwise
+ */
+bool pgSQLPipeline_t::execute() noexcept
+{
+	if (!valid() || !statements || !client->valid())
+	{
+		finish();
+		return false;
+	}
+	fixedVector_t<pgSQLResult_t> status{statements};
+	numResults = status.count();
+	const auto result{collect(status)};
+	results.swap(status);
+	return result && results.valid();
+}
+
+/*!
+ * @brief Call to determine if a given statement succeeded when the pipeline was last executed
+ * @param index The index of the statement in the order it was added to the pipeline
+ * @returns true if the statement succeeded, false if it failed or was not run
+ */
+bool pgSQLPipeline_t::succeeded(const size_t index) const noexcept
+{
+	if (index >= numResults)
+		return false;
+	const auto &result{results.data()[index]};
+	return result.valid() && result.successful();
+}
+
+/*!
+ * @brief Gets the result of a given statement from when the pipeline was last executed
+ * @param index The index of the statement in the order it was added to the pipeline
+ * @returns the statement's result, which is invalid if the statement was not run
+ */
+const pgSQLResult_t &pgSQLPipeline_t::operator [](const size_t index) const noexcept
+{
+	static const pgSQLResult_t invalid{};
+	return index < numResults ? results.data()[index] : invalid;
+}
+
+void pgSQLPipeline_t::swap(pgSQLPipeline_t &pipeline) noexcept
+{
+	std::swap(client, pipeline.client);
+	pending.swap(pipeline.pending);
+	std::swap(statements, pipeline.statements);
+	results.swap(pipeline.results);
+	std::swap(numResults, pipeline.numResults);
+}
+
+/*!
+ * @brief Starts a COPY ... FROM STDIN on this connection
+ * @param queryStmt The COPY statement to run
+ * @returns a pgSQLCopyIn_t to write the data to, which is invalid if the COPY could not be started
+ */
+pgSQLCopyIn_t pgSQLClient_t::copyIn(const char *const queryStmt) const noexcept
+{
+	if (!valid() || !queryStmt)
+		return {};
+	const pgSQLResult_t result{PQexec(connection, queryStmt)};
+	if (!result.valid() || result.errorNum() != PGRES_COPY_IN)
+		return {};
+	return {connection};
+}
+
+// Finishes off a COPY, draining its results so the connection is ready for the next query
+static bool endCopy(PGconn *const connection, const char *const error) noexcept
+{
+	bool ok{PQputCopyEnd(connection, error) == 1};
+	while (PGresult *const result = PQgetResult(connection))
+	{
+		ok &= PQresultStatus(result) == PGRES_COMMAND_OK;
+		PQclear(result);
+	}
+	return ok && !error;
+}
+
+pgSQLCopyIn_t::pgSQLCopyIn_t(PGconn *const conn) noexcept : connection{conn}, buffer{chunkLength}
+{
+	if (!buffer.valid())
+	{
+		endCopy(connection, "Out of memory");
+		connection = nullptr;
+	}
+}
+
+// Abandoning a COPY without end() being called aborts it, so none of the data gets committed
+pgSQLCopyIn_t::~pgSQLCopyIn_t() noexcept
+{
+	if (valid())
+		end("COPY abandoned");
+}
+
+bool pgSQLCopyIn_t::flush() noexcept
+{
+	if (!used)
+		return true;
+	const auto result{PQputCopyData(connection, buffer.data(), static_cast<int>(used))};
+	used = 0;
+	return result == 1;
+}
+
+/*!
+ * @brief Reserves space for length bytes of data at the end of the COPY data
+ * @returns a pointer to the space to write the data into, or nullptr if it could not be reserved
+ */
+void *pgSQLCopyIn_t::reserve(const size_t length) noexcept
+{
+	if (!valid() || length > chunkLength || (used + length > chunkLength && !flush()))
+		return nullptr;
+	auto *const data{buffer.data() + used};
+	used += length;
+	return data;
+}
+
+/*!
+ * @brief Appends data to the COPY data, handing it to libpq in chunkLength sized pieces
+ * @returns true if the data could be written, false otherwise
+ */
+bool pgSQLCopyIn_t::write(const void *const data, const size_t length) noexcept
+{
+	if (!valid())
+		return false;
+	if (used + length > chunkLength)
+	{
+		if (!flush())
+			return false;
+		// Data too big to be buffered goes straight through
+		if (length > chunkLength)
+		{
+			const auto *const bytes{static_cast<const char *>(data)};
+			for (size_t offset{0}; offset < length; offset += chunkLength)
+			{
+				const size_t amount{length - offset > chunkLength ? chunkLength : length - offset};
+				if (PQputCopyData(connection, bytes + offset, static_cast<int>(amount)) != 1)
+					return false;
+			}
+			return true;
+		}
+	}
+	std::memcpy(buffer.data() + used, data, length);
+	used += length;
+	return true;
+}
+
+/*!
+ * @brief Completes the COPY, making the data written available in the table
+ * @param error If not nullptr, aborts the COPY with this as the reason instead
+ * @returns true if the COPY completed successfully, false otherwise
+ */
+bool pgSQLCopyIn_t::end(const char *const error) noexcept
+{
+	if (!valid())
+		return false;
+	const auto flushed{error || flush()};
+	const auto result{endCopy(connection, flushed ? error : "Failed to send COPY data")};
+	connection = nullptr;
+	used = 0;
+	return result;
+}
+
+void pgSQLCopyIn_t::swap(pgSQLCopyIn_t &copy) noexcept
+{
+	std::swap(connection, copy.connection);
+	buffer.swap(copy.buffer);
+	std::swap(used, copy.used);
+}
+
+// The array types to bind arrays of each of the types we know about as
+static Oid arrayTypeToOID(const pgSQLType_t type) noexcept
+{
+	switch (type)
+	{
+		case pgSQLType_t::boolean:
+			return BOOLARRAYOID;
+		case pgSQLType_t::int2:
+			return INT2ARRAYOID;
+		case pgSQLType_t::int4:
+			return INT4ARRAYOID;
+		case pgSQLType_t::int8:
+			return INT8ARRAYOID;
+		case pgSQLType_t::float4:
+			return FLOAT4ARRAYOID;
+		case pgSQLType_t::float8:
+			return FLOAT8ARRAYOID;
+		case pgSQLType_t::unicode:
+			return VARCHARARRAYOID;
+		case pgSQLType_t::unicodeText:
+			return TEXTARRAYOID;
+		case pgSQLType_t::binary:
+			return BYTEAARRAYOID;
+		case pgSQLType_t::date:
+			return DATEARRAYOID;
+		case pgSQLType_t::time:
+			return TIMEARRAYOID;
+		case pgSQLType_t::dateTime:
+			return TIMESTAMPARRAYOID;
+		case pgSQLType_t::uuid:
+			return UUIDARRAYOID;
+		default:
+			return InvalidOid;
+	}
+}
+
+/*!
+ * @brief Starts a one dimensional array of count elements of the given type in Postgres's binary array format
+ * @details The elements must then be written in order as a binary COPY writes fields - each as its length
+ *     followed by its binary encoding, or a length of -1 for NULL - after which the array can be bound to a query.
+ */
+pgSQLArray_t::pgSQLArray_t(const pgSQLType_t type, const size_t count) noexcept : arrayType{arrayTypeToOID(type)}
+{
+	// The header is the number of dimensions, a flag for whether there are NULLs, which Postgres works out
+	// for itself from the element lengths so is always left 0, the element type, and then the length and
+	// lower bound of the one dimension. Most elements are at most 8 bytes, so size the array for that to start.
+	constexpr size_t headerLength{sizeof(int32_t) * 5U};
+	if (arrayType == InvalidOid || count > size_t(std::numeric_limits<int32_t>::max()) ||
+		!grow(headerLength + (count * (sizeof(int32_t) + sizeof(int64_t)))))
+		return;
+	auto *const header{buffer.data()};
+	substrate::buffer_utils::writeBE(int32_t{1}, header);
+	substrate::buffer_utils::writeBE(int32_t{0}, header + 4);
+	substrate::buffer_utils::writeBE(pgSQLQuery_t::typeToOID(type), header + 8);
+	substrate::buffer_utils::writeBE(static_cast<int32_t>(count), header + 12);
+	substrate::buffer_utils::writeBE(int32_t{1}, header + 16);
+	used = headerLength;
+}
+
+/*!
+ * @internal
+ * @brief Moves the array into a new buffer of at least length bytes, preserving the data written so far
+ */
+bool pgSQLArray_t::grow(const size_t length) noexcept try
+{
+	fixedVector_t<char> storage{length};
+	if (!storage.valid())
+		return false;
+	if (used)
+		std::memcpy(storage.data(), buffer.data(), used);
+	buffer.swap(storage);
+	return true;
+}
+catch (const std::bad_alloc &)
+	{ return false; }
+
+/*!
+ * @brief Finds space for length bytes at the end of the array, growing it as necessary
+ * @returns the space for the data, or nullptr if the array could not be grown or would be too large to bind
+ */
+void *pgSQLArray_t::reserve(const size_t length) noexcept
+{
+	const auto maximumLength{static_cast<size_t>(std::numeric_limits<int>::max())};
+	if (!valid() || length > maximumLength - used)
+		return nullptr;
+	if (used + length > buffer.count())
+	{
+		const auto capacity{buffer.count() * 2U};
+		if (!grow(std::max(std::min(capacity, maximumLength), used + length)))
+			return nullptr;
+	}
+	auto *const data{buffer.data() + used};
+	used += length;
+	return data;
+}
+
+/*!
+ * @brief Appends data to the end of the array
+ * @returns true if the data could be written, false otherwise
+ */
+bool pgSQLArray_t::write(const void *const data, const size_t length) noexcept
+{
+	auto *const buffer{reserve(length)};
+	if (!buffer)
+		return false;
+	std::memcpy(buffer, data, length);
+	return true;
+}
+
+void pgSQLArray_t::swap(pgSQLArray_t &array) noexcept
+{
+	buffer.swap(array.buffer);
+	std::swap(used, array.used);
+	std::swap(arrayType, array.arrayType);
+}
+
+/*!
+ * @brief Starts a binary COPY ... TO STDOUT on this connection
+ * @param queryStmt The COPY statement to run, which must specify (FORMAT binary)
+ * @param types The types of each of the fields in the tuples the COPY produces
+ * @param typesCount How many fields there are in each tuple
+ * @returns a pgSQLCopyOut_t to read the tuples from, which is invalid if the COPY could not be started
+ */
+pgSQLCopyOut_t pgSQLClient_t::copyOut(const char *const queryStmt, const pgSQLType_t *const types,
+	const size_t typesCount) const noexcept
+{
+	if (!valid() || !queryStmt || !types || !typesCount)
+		return {};
+	fixedVector_t<Oid> fieldTypes{typesCount};
+	if (!fieldTypes.valid())
+		return {};
+	for (size_t i{0}; i < typesCount; ++i)
+		fieldTypes.data()[i] = pgSQLQuery_t::typeToOID(types[i]);
+	const pgSQLResult_t result{PQexec(connection, queryStmt)};
+	if (!result.valid() || result.errorNum() != PGRES_COPY_OUT)
+		return {};
+	return {connection, std::move(fieldTypes)};
+}
+
+pgSQLCopyOut_t::pgSQLCopyOut_t(PGconn *const conn, fixedVector_t<Oid> &&types) noexcept :
+	connection{conn}, fieldTypes{std::move(types)}, fields{fieldTypes.count()}
+{
+	if (!fields.valid())
+		finish(true);
+}
+
+pgSQLCopyOut_t::~pgSQLCopyOut_t() noexcept
+{
+	if (valid())
+		finish(true);
+}
+
+// libpq hands back one CopyData message at a time, each of which holds a whole tuple
+bool pgSQLCopyOut_t::nextMessage() noexcept
+{
+	if (data)
+		PQfreemem(data);
+	data = nullptr;
+	const auto length{PQgetCopyData(connection, &data, 0)};
+	dataLength = length > 0 ? static_cast<size_t>(length) : 0U;
+	offset = 0;
+	return length > 0;
+}
+
+template<typename T> bool pgSQLCopyOut_t::read(T &value) noexcept
+{
+	if (dataLength - offset < sizeof(T))
+		return false;
+	value = substrate::buffer_utils::readBE<T>(data + offset);
+	offset += sizeof(T);
+	return true;
+}
+
+// The PGCOPY header comes in the same message as the first tuple
+bool pgSQLCopyOut_t::readHeader() noexcept
+{
+	constexpr static std::array<char, 11> signature{{'P', 'G', 'C', 'O', 'P', 'Y', '\n', '\xFF', '\r', '\n', '\0'}};
+	uint32_t flags{};
+	uint32_t extensionLength{};
+	if (dataLength < signature.size() || memcmp(data, signature.data(), signature.size()) != 0)
+		return false;
+	offset = signature.size();
+	if (!read(flags) || !read(extensionLength) || dataLength - offset < extensionLength)
+		return false;
+	offset += extensionLength;
+	headerRead = true;
+	return true;
+}
+
+/*!
+ * @internal
+ * @brief Finds space for length bytes of tuple data, moving on to the next storage block if this one is full
+ */
+char *pgSQLCopyOut_t::storage(const size_t length) noexcept try
+{
+	if (!blocks.empty() && blocks[block].count() - blockOffset >= length)
+	{
+		auto *const data{blocks[block].data() + blockOffset};
+		blockOffset += length;
+		return data;
+	}
+	const size_t nextBlock{blocks.empty() ? 0U : block + 1U};
+	if (nextBlock == blocks.size())
+		blocks.emplace_back();
+	auto &storage{blocks[nextBlock]};
+	if (storage.count() < length)
+	{
+		storage = {length > blockLength ? length : blockLength};
+		if (!storage.valid())
+			return nullptr;
+	}
+	block = nextBlock;
+	blockOffset = length;
+	return storage.data();
+}
+catch (const std::bad_alloc &)
+	{ return nullptr; }
+
+/*!
+ * @brief Reads the next tuple from the COPY
+ * @param retain If true, the strings of the tuples read before this one are kept valid too, rather than
+ *     this tuple's data replacing theirs. They remain valid until the next call to next() without retain set.
+ * @returns true if a tuple was read, false if the COPY is over or failed, which successful() then tells apart
+ */
+bool pgSQLCopyOut_t::next(const bool retain) noexcept
+{
+	if (!valid())
+		return false;
+	if (!retain)
+	{
+		block = 0;
+		blockOffset = 0;
+	}
+	if ((offset == dataLength && !nextMessage()) || (!headerRead && !readHeader()))
+	{
+		finish(true);
+		return false;
+	}
 
-void pgSQLClient_t::operator=(pgSQLClient_t &&con) noexcept
+	int16_t fieldCount{};
+	if (!read(fieldCount))
+	{
+		finish(true);
+		return false;
+	}
+	// A field count of -1 is the trailer that marks the end of the data
+	else if (fieldCount == -1)
+	{
+		finish(false);
+		return false;
+	}
+	else if (static_cast<size_t>(fieldCount) != fields.count())
+	{
+		finish(true);
+		return false;
+	}
+
+	// Worst case, the tuple's data plus a NUL for each field
+	auto *const row{storage(dataLength - offset + fields.count())};
+	if (!row)
+	{
+		finish(true);
+		return false;
+	}
+	size_t rowOffset{0};
+	for (auto &field : fields)
+	{
+		int32_t length{};
+		if (!read(length) || length < -1 || (length > 0 && dataLength - offset < static_cast<size_t>(length)))
+		{
+			finish(true);
+			return false;
+		}
+		else if (length == -1)
+		{
+			field = nullptr;
+			continue;
+		}
+		const auto fieldLength{static_cast<size_t>(length)};
+		auto *const value{row + rowOffset};
+		std::memcpy(value, data + offset, fieldLength);
+		value[fieldLength] = '\0';
+		field = value;
+		offset += fieldLength;
+		rowOffset += fieldLength + 1U;
+	}
+	return true;
+}
+
+pgSQLValue_t pgSQLCopyOut_t::operator [](const uint32_t idx) const noexcept
 {
-	std::swap(connection, con.connection);
-	std::swap(needsCommit, con.needsCommit);
+	if (!valid() || idx >= fields.count())
+		return {};
+	// This would use fields[idx] but that can throw.
+	const auto *const value{fields.data()[idx]};
+	if (!value)
+		return {nullptr};
+	return {value, fieldTypes.data()[idx]};
 }
 
-bool pgSQLClient_t::connect(const char *const host, const char *const port, const char *const user,
-	const char *const passwd, const char *const db) noexcept
+// Asks the server to stop running whatever query is in progress on the connection
+static void cancelQuery(PGconn *const connection) noexcept
 {
-	if (valid())
-		return false;
-	connection = PQsetdbLogin(host, port, nullptr, nullptr, db, user, passwd);
-	if (PQstatus(connection) != CONNECTION_OK)
-		disconnect();
-	return valid();
+	auto *const request{PQgetCancel(connection)};
+	if (request)
+	{
+		std::array<char, 256> error{};
+		PQcancel(request, error.data(), static_cast<int>(error.size()));
+		PQfreeCancel(request);
+	}
 }
 
-void pgSQLClient_t::disconnect() noexcept
+/*!
+ * @internal
+ * @brief Finishes off the COPY, cancelling it on the server if it has not run to completion
+ */
+void pgSQLCopyOut_t::finish(const bool cancel) noexcept
 {
-	if (connection)
+	if (data)
+		PQfreemem(data);
+	data = nullptr;
+	dataLength = 0;
+	offset = 0;
+	if (cancel)
+		cancelQuery(connection);
+	// Drain whatever's left so the connection is ready for the next query
+	char *buffer{nullptr};
+	while (PQgetCopyData(connection, &buffer, 0) > 0)
+		PQfreemem(buffer);
+	bool ok{!cancel};
+	while (PGresult *const result = PQgetResult(connection))
 	{
-		if (needsCommit)
-			rollback();
-		PQfinish(connection);
-		connection = nullptr;
+		ok &= PQresultStatus(result) == PGRES_COMMAND_OK;
+		PQclear(result);
 	}
+	completed = ok;
+	connection = nullptr;
 }
 
-bool pgSQLClient_t::switchDB(const char *const db) noexcept
+void pgSQLCopyOut_t::swap(pgSQLCopyOut_t &copy) noexcept
 {
-	if (!valid())
-		return false;
-	auto *const settings{PQconninfo(connection)};
-	if (!settings)
-		return false;
-	disconnect();
-	const auto findSetting{[&](const char *const name) -> const char *
+	std::swap(connection, copy.connection);
+	fieldTypes.swap(copy.fieldTypes);
+	std::swap(data, copy.data);
+	std::swap(dataLength, copy.dataLength);
+	std::swap(offset, copy.offset);
+	std::swap(headerRead, copy.headerRead);
+	std::swap(completed, copy.completed);
+	blocks.swap(copy.blocks);
+	std::swap(block, copy.block);
+	std::swap(blockOffset, copy.blockOffset);
+	fields.swap(copy.fields);
+}
+
+#ifdef LIBPQ_HAS_CHUNK_MODE
+// The number of rows to ask for at a time now libpq is able to hand us more than one
+constexpr static int streamChunkRows{256};
+#endif
+
+pgSQLResultStream_t::pgSQLResultStream_t(PGconn *const conn) noexcept : connection{conn}
+{
+	// If neither mode can be set, we get the whole result in one go - which still streams correctly
+#ifdef LIBPQ_HAS_CHUNK_MODE
+	PQsetChunkedRowsMode(connection, streamChunkRows);
+#else
+	PQsetSingleRowMode(connection);
+#endif
+	fetch();
+}
+
+pgSQLResultStream_t::~pgSQLResultStream_t() noexcept
+{
+	if (valid())
+		finish();
+}
+
+/*!
+ * @internal
+ * @brief Grabs the next batch of rows from libpq, skipping over any empty results
+ * @returns true if there is a new row to look at, false if the query has finished
+ */
+bool pgSQLResultStream_t::fetch() noexcept
+{
+	while (PGresult *const nextResult = PQgetResult(connection))
 	{
-		for (size_t i{}; settings[i].keyword != nullptr; ++i)
+		result = {nextResult};
+		if (!result.valid())
 		{
-			if (strcmp(settings[i].keyword, name) == 0)
-				return settings[i].val;
+			finish();
+			return false;
 		}
-		return nullptr;
-	}};
-	const auto *const host{findSetting("host")};
-	const auto *const port{findSetting("port")};
-	const auto *const user{findSetting("user")};
-	const auto *const passwd{findSetting("password")};
-	const auto result{connect(host, port, user, passwd, db)};
-	PQconninfoFree(settings);
-	return result;
+		// The rows are followed by an empty PGRES_TUPLES_OK result that says the query completed
+		const auto status{result.errorNum()};
+		completed = status == PGRES_TUPLES_OK || status == PGRES_COMMAND_OK;
+		if (result.hasData() && result.numRows())
+			return true;
+	}
+	// We only keep the final result once we get here so that any error it holds can be looked at
+	connection = nullptr;
+	return false;
 }
 
-bool pgSQLClient_t::beginTransact() noexcept
+/*!
+ * @brief Moves on to the next row of the result
+ * @returns true if there is another row, false once the result is exhausted
+ * @note Any values taken from the previous row are invalidated by this call
+ */
+bool pgSQLResultStream_t::next() noexcept
 {
-	if (!valid() || needsCommit)
+	if (!valid())
 		return false;
-	const auto result{query("BEGIN")};
-	needsCommit = result.errorNum() == PGRES_COMMAND_OK;
-	return needsCommit;
+	return result.next() || fetch();
 }
 
-bool pgSQLClient_t::endTransact(const bool commitSuccess) noexcept
+/*!
+ * @internal
+ * @brief Abandons the rest of the rows, cancelling the query and draining the connection so it can be reused
+ */
+void pgSQLResultStream_t::finish() noexcept
 {
-	if (valid() && needsCommit)
+	cancelQuery(connection);
+	while (PGresult *const nextResult = PQgetResult(connection))
+		PQclear(nextResult);
+	completed = false;
+	connection = nullptr;
+}
+
+void pgSQLResultStream_t::swap(pgSQLResultStream_t &stream) noexcept
+{
+	std::swap(connection, stream.connection);
+	result.swap(stream.result);
+	std::swap(completed, stream.completed);
+}
+
+pgSQLAsyncQuery_t::pgSQLAsyncQuery_t(PGconn *const conn) noexcept : connection{conn} { flush(); }
+
+pgSQLAsyncQuery_t::~pgSQLAsyncQuery_t() noexcept
+{
+	if (!valid())
+		return;
+	// Abandon the query, restoring blocking mode first so the drain waits on the server
+	PQsetnonblocking(connection, 0);
+	cancelQuery(connection);
+	while (PGresult *const nextResult = PQgetResult(connection))
+		PQclear(nextResult);
+}
+
+int pgSQLAsyncQuery_t::socket() const noexcept
+	{ return valid() ? PQsocket(connection) : -1; }
+
+/*!
+ * @internal
+ * @brief Writes out as much of the query as the socket will take without blocking
+ * @returns false if the connection failed, true otherwise
+ */
+bool pgSQLAsyncQuery_t::flush() noexcept
+{
+	const auto result{PQflush(connection)};
+	if (result == -1)
 	{
-		const auto result{query(commitSuccess ? "COMMIT" : "ROLLBACK")};
-		needsCommit = result.errorNum() != PGRES_COMMAND_OK;
+		fail();
+		return false;
 	}
-	return !needsCommit;
+	flushing = result == 1;
+	return true;
 }
 
-pgSQLResult_t pgSQLClient_t::query(const char *const queryStmt) const noexcept
-	{ return {PQexecParams(connection, queryStmt, 0, nullptr, nullptr, nullptr, nullptr, 1)}; }
+/*!
+ * @internal
+ * @brief Finishes the query off with an error result carrying the connection's error message
+ */
+void pgSQLAsyncQuery_t::fail() noexcept
+{
+	while (PGresult *const nextResult = PQgetResult(connection))
+		PQclear(nextResult);
+	queryResult = {PQmakeEmptyPGresult(connection, PGRES_FATAL_ERROR)};
+	finish();
+}
 
-pgSQLQuery_t pgSQLClient_t::prepare(const char *const queryStmt, const size_t paramsCount) const noexcept
+void pgSQLAsyncQuery_t::finish() noexcept
 {
-	if (!valid() || !queryStmt)
-		return {};
-	return {connection, queryStmt, paramsCount};
+	PQsetnonblocking(connection, 0);
+	connection = nullptr;
+	flushing = false;
+	completed = true;
 }
 
-const char *pgSQLClient_t::error() const noexcept
-	{ return valid() ? PQerrorMessage(connection) : nullptr; }
+/*!
+ * @brief Makes as much progress on the query as can be made without blocking
+ * @details This should be called whenever the socket becomes readable, or writable if wantsWrite() is true.
+ *     Once done() returns true, the query's result is available from result().
+ * @returns false if the query is not in flight or the connection failed, true otherwise
+ */
+bool pgSQLAsyncQuery_t::process() noexcept
+{
+	if (!valid() || (flushing && !flush()))
+		return false;
+	if (!PQconsumeInput(connection))
+	{
+		fail();
+		return false;
+	}
+	while (!PQisBusy(connection))
+	{
+		PGresult *const nextResult{PQgetResult(connection)};
+		if (!nextResult)
+		{
+			finish();
+			break;
+		}
+		// Like PQexec(), if the query holds several statements then the last one's result is the one kept
+		queryResult = {nextResult};
+	}
+	return true;
+}
 
-pgSQLQuery_t::pgSQLQuery_t(PGconn *const conn, const char *const queryStmt, const size_t paramsCount) noexcept :
-	connection{conn}, query{queryStmt}, numParams{paramsCount}, paramTypes{paramsCount},
-	params{paramsCount}, paramStorage{paramsCount}, dataLengths{paramsCount} { }
+void pgSQLAsyncQuery_t::swap(pgSQLAsyncQuery_t &query) noexcept
+{
+	std::swap(connection, query.connection);
+	queryResult.swap(query.queryResult);
+	std::swap(flushing, query.flushing);
+	std::swap(completed, query.completed);
+}
 
-pgSQLResult_t pgSQLQuery_t::execute() const noexcept
+/*!
+ * @brief Adds an in-flight query to the loop, along with what to do with its result once it completes
+ * @returns false if the query was not in flight or could not be added, true otherwise
+ */
+bool pgSQLEventLoop_t::add(pgSQLAsyncQuery_t &&query, std::unique_ptr<pgSQLCompletion_t> &&completion) noexcept try
 {
-	if (!valid() || numParams > static_cast<size_t>(std::numeric_limits<int>::max()))
-		return {};
-	fixedVector_t<int> paramFormats{numParams};
-	if (!paramFormats)
-		return {};
-	// Postgres uses 1 to indicate binary, and 0 for string.
-	for (auto &format : paramFormats)
-		format = 1;
-	return {PQexecParams(connection, query, static_cast<int>(numParams), paramTypes.data(),
-		params.data(), dataLengths.data(), paramFormats.data(), 1)};
+	if (!query.valid() || !completion)
+		return false;
+	queries.push_back({std::move(query), std::move(completion)});
+	return true;
 }
+catch (const std::bad_alloc &)
+	{ return false; }
 
-Oid pgSQLQuery_t::typeToOID(pgSQLType_t type) noexcept
+/*!
+ * @brief Waits up to timeout milliseconds for any of the queries to make progress, running the completions
+ *     of those that finish
+ * @details Completions are free to add new queries to the loop.
+ * @returns false if waiting on the queries failed, true otherwise
+ */
+bool pgSQLEventLoop_t::poll(const int timeout) noexcept try
 {
-	switch (type)
+	if (queries.empty())
+		return true;
+	std::vector<pollfd> sockets(queries.size());
+	for (size_t i{0}; i < queries.size(); ++i)
 	{
-		case pgSQLType_t::boolean:
-			return BOOLOID;
-		case pgSQLType_t::int2:
-			return INT2OID;
-		case pgSQLType_t::int4:
-			return INT4OID;
-		case pgSQLType_t::int8:
-			return INT8OID;
-		case pgSQLType_t::float4:
-			return FLOAT4OID;
-		case pgSQLType_t::float8:
-			return FLOAT8OID;
-		case pgSQLType_t::unicode:
-			return VARCHAROID;
-		case pgSQLType_t::unicodeText:
-			return TEXTOID;
-		case pgSQLType_t::binary:
-			return BYTEAOID;
-		case pgSQLType_t::date:
-			return DATEOID;
-		case pgSQLType_t::time:
-			return TIMEOID;
-		case pgSQLType_t::dateTime:
-			return TIMESTAMPOID;
-		case pgSQLType_t::uuid:
-			return UUIDOID;
-		default:
-			return InvalidOid;
+		const auto &query{queries[i].query};
+		sockets[i].fd = query.socket();
+		sockets[i].events = static_cast<short>(query.wantsWrite() ? POLLIN | POLLOUT : POLLIN);
 	}
+	if (::poll(sockets.data(), sockets.size(), timeout) == -1)
+		return errno == EINTR;
+
+	// Completed queries get pulled out before running any completions, in case those add more queries
+	std::vector<pending_t> finished{};
+	finished.reserve(queries.size());
+	for (size_t i{sockets.size()}; i-- > 0;)
+	{
+		if (!sockets[i].revents)
+			continue;
+		auto &pending{queries[i]};
+		pending.query.process();
+		if (!pending.query.done())
+			continue;
+		finished.push_back(std::move(pending));
+		if (&pending != &queries.back())
+			pending = std::move(queries.back());
+		queries.pop_back();
+	}
+	for (auto &pending : finished)
+		pending.completion->complete(pending.query.result());
+	return true;
 }
+catch (const std::bad_alloc &)
+	{ return false; }
 
-void pgSQLQuery_t::swap(pgSQLQuery_t &qry) noexcept
+/*!
+ * @brief Runs the loop until every query on it, including any added by completions, has completed
+ * @returns false if waiting on the queries failed, true otherwise
+ */
+bool pgSQLEventLoop_t::run() noexcept
 {
-	std::swap(connection, qry.connection);
-	std::swap(query, qry.query);
-	std::swap(numParams, qry.numParams);
-	paramTypes.swap(qry.paramTypes);
-	params.swap(qry.params);
-	paramStorage.swap(qry.paramStorage);
-	dataLengths.swap(qry.dataLengths);
+	while (!queries.empty())
+	{
+		if (!poll(-1))
+			return false;
+	}
+	return true;
 }
 
 pgSQLResult_t::pgSQLResult_t(PGresult *res) noexcept : result{res}
@@ -205,13 +1641,21 @@ const char *pgSQLResult_t::error() const noexcept
 bool pgSQLResult_t::successful() const noexcept
 {
 	const auto result{errorNum()};
-	return result == PGRES_COMMAND_OK || result == PGRES_TUPLES_OK || result == PGRES_SINGLE_TUPLE;
+	return result == PGRES_COMMAND_OK || result == PGRES_TUPLES_OK || result == PGRES_SINGLE_TUPLE
+#ifdef LIBPQ_HAS_CHUNK_MODE
+		|| result == PGRES_TUPLES_CHUNK
+#endif
+		;
 }
 
 bool pgSQLResult_t::hasData() const noexcept
 {
 	const auto result{errorNum()};
-	return result == PGRES_TUPLES_OK || result == PGRES_SINGLE_TUPLE;
+	return result == PGRES_TUPLES_OK || result == PGRES_SINGLE_TUPLE
+#ifdef LIBPQ_HAS_CHUNK_MODE
+		|| result == PGRES_TUPLES_CHUNK
+#endif
+		;
 }
 
 bool pgSQLResult_t::next() noexcept
@@ -222,16 +1666,148 @@ bool pgSQLResult_t::next() noexcept
 }
 
 pgSQLValue_t pgSQLResult_t::operator [](const uint32_t idx) const noexcept
+	{ return value(row, idx); }
+
+/*!
+ * @brief Gets the value of a field in any row of the result, irrespective of which row next() is on
+ */
+pgSQLValue_t pgSQLResult_t::value(const uint32_t rowIndex, const uint32_t idx) const noexcept
 {
-	if (!valid() || row >= rows || idx > fields)
+	if (!valid() || rowIndex >= rows || idx >= fields)
 		return {};
-	else if (PQgetisnull(result, static_cast<int>(row), static_cast<int>(idx)) == 1)
+	else if (PQgetisnull(result, static_cast<int>(rowIndex), static_cast<int>(idx)) == 1)
 		return {nullptr};
 	else
 		// This would use fieldInfo[i] but that can throw.
-		return {PQgetvalue(result, static_cast<int>(row), static_cast<int>(idx)), fieldInfo.data()[idx]};
+		return {PQgetvalue(result, static_cast<int>(rowIndex), static_cast<int>(idx)), fieldInfo.data()[idx]};
+}
+
+// The column type each type decodeColumn() supports must come from, and the type to byte swap it as
+template<typename> struct columnType_t { };
+template<> struct columnType_t<bool> { constexpr static Oid oid{BOOLOID}; using raw_t = uint8_t; };
+template<> struct columnType_t<int16_t> { constexpr static Oid oid{INT2OID}; using raw_t = uint16_t; };
+template<> struct columnType_t<int32_t> { constexpr static Oid oid{INT4OID}; using raw_t = uint32_t; };
+template<> struct columnType_t<int64_t> { constexpr static Oid oid{INT8OID}; using raw_t = uint64_t; };
+template<> struct columnType_t<float> { constexpr static Oid oid{FLOAT4OID}; using raw_t = uint32_t; };
+template<> struct columnType_t<double> { constexpr static Oid oid{FLOAT8OID}; using raw_t = uint64_t; };
+template<> struct columnType_t<ormDate_t> { constexpr static Oid oid{DATEOID}; using raw_t = int32_t; };
+template<> struct columnType_t<ormDateTime_t> { constexpr static Oid oid{TIMESTAMPOID}; using raw_t = int64_t; };
+
+template<typename T> inline void storeValue(T &value, const char *const data) noexcept
+	{ std::memcpy(&value, data, sizeof(T)); }
+inline void storeValue(bool &value, const char *const data) noexcept { value = *data != 0; }
+
+// Swapping the whole column in its own pass keeps the loop simple enough for the compiler to vectorise
+template<typename raw_t, typename T> inline void swapColumn(T *const values, const size_t count) noexcept
+{
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	for (size_t i{0}; i < count; ++i)
+	{
+		raw_t rawValue{};
+		std::memcpy(&rawValue, values + i, sizeof(raw_t));
+		swapBytes(rawValue);
+		std::memcpy(values + i, &rawValue, sizeof(raw_t));
+	}
+#endif
+}
+template<> inline void swapColumn<uint8_t, bool>(bool *const, const size_t) noexcept { }
+
+// Copies count rows of a column starting at first out of the result as-is, checking each is the expected length
+template<typename T> bool gatherColumn(const PGresult *const result, const int column, const uint32_t first,
+	const uint32_t count, T *const values, bool *const nulls) noexcept
+{
+	for (uint32_t i{0}; i < count; ++i)
+	{
+		const auto rowIndex{static_cast<int>(first + i)};
+		const bool isNull{PQgetisnull(result, rowIndex, column) == 1};
+		if (nulls)
+			nulls[i] = isNull;
+		else if (isNull)
+			return false;
+		if (isNull)
+			values[i] = T{};
+		else if (PQgetlength(result, rowIndex, column) != static_cast<int>(sizeof(T)))
+			return false;
+		else
+			storeValue(values[i], PQgetvalue(result, rowIndex, column));
+	}
+	return true;
+}
+
+template<typename T> bool decodeValues(const PGresult *const result, const int column, const uint32_t rows,
+	T *const values, bool *const nulls) noexcept
+{
+	using raw_t = typename columnType_t<T>::raw_t;
+	static_assert(sizeof(raw_t) == sizeof(T), "Column value type and its raw type are not the same size");
+	if (!gatherColumn(result, column, 0, rows, values, nulls))
+		return false;
+	// Postgres guarantees "network byte order" (big endian)
+	swapColumn<raw_t>(values, rows);
+	return true;
+}
+
+inline void decodeRaw(const int32_t *const rawDates, ormDate_t *const dates, const size_t count) noexcept
+	{ decodeDates(rawDates, dates, count); }
+inline void decodeRaw(const int64_t *const rawDateTimes, ormDateTime_t *const dateTimes, const size_t count) noexcept
+	{ decodeDateTimes(rawDateTimes, dateTimes, count); }
+
+// Dates and timestamps are gathered raw a block at a time and handed to the batch decoders
+template<typename T> bool decodeDateValues(const PGresult *const result, const int column, const uint32_t rows,
+	T *const values, bool *const nulls) noexcept
+{
+	constexpr uint32_t blockLength{dateBlockLength};
+	std::array<typename columnType_t<T>::raw_t, dateBlockLength> rawValues{};
+	for (uint32_t offset{0}; offset < rows; offset += blockLength)
+	{
+		const auto length{std::min(rows - offset, blockLength)};
+		bool *const blockNulls{nulls ? nulls + offset : nullptr};
+		if (!gatherColumn(result, column, offset, length, rawValues.data(), blockNulls))
+			return false;
+		decodeRaw(rawValues.data(), values + offset, length);
+		for (uint32_t i{0}; blockNulls && i < length; ++i)
+		{
+			if (blockNulls[i])
+				values[offset + i] = T{};
+		}
+	}
+	return true;
 }
 
+inline bool decodeValues(const PGresult *const result, const int column, const uint32_t rows,
+	ormDate_t *const values, bool *const nulls) noexcept
+	{ return decodeDateValues(result, column, rows, values, nulls); }
+inline bool decodeValues(const PGresult *const result, const int column, const uint32_t rows,
+	ormDateTime_t *const values, bool *const nulls) noexcept
+	{ return decodeDateValues(result, column, rows, values, nulls); }
+
+/*!
+ * @brief Decodes every row of a column into an array in one go, which is far cheaper than going value by value
+ * @details This is supported for bool, int16_t, int32_t, int64_t, float, double, date and date-time columns.
+ * @param column The index of the column to decode
+ * @param values The array to decode into, which must be at least numRows() long
+ * @param count The length of the values array
+ * @param nulls Optionally, an array at least numRows() long to mark which rows are NULL in.
+ *     NULL rows are decoded as a default-constructed value
+ * @returns true if the column was decoded, false if it is the wrong type, or there is a NULL and no nulls array
+ */
+template<typename T> bool pgSQLResult_t::decodeColumn(const uint32_t column, T *const values, const size_t count,
+	bool *const nulls) const noexcept
+{
+	// This would use fieldInfo[column] but that can throw.
+	if (!valid() || column >= fields || !values || count < rows || fieldInfo.data()[column] != columnType_t<T>::oid)
+		return false;
+	return decodeValues(result, static_cast<int>(column), rows, values, nulls);
+}
+
+template bool pgSQLResult_t::decodeColumn<bool>(uint32_t, bool *, size_t, bool *) const noexcept;
+template bool pgSQLResult_t::decodeColumn<int16_t>(uint32_t, int16_t *, size_t, bool *) const noexcept;
+template bool pgSQLResult_t::decodeColumn<int32_t>(uint32_t, int32_t *, size_t, bool *) const noexcept;
+template bool pgSQLResult_t::decodeColumn<int64_t>(uint32_t, int64_t *, size_t, bool *) const noexcept;
+template bool pgSQLResult_t::decodeColumn<float>(uint32_t, float *, size_t, bool *) const noexcept;
+template bool pgSQLResult_t::decodeColumn<double>(uint32_t, double *, size_t, bool *) const noexcept;
+template bool pgSQLResult_t::decodeColumn<ormDate_t>(uint32_t, ormDate_t *, size_t, bool *) const noexcept;
+template bool pgSQLResult_t::decodeColumn<ormDateTime_t>(uint32_t, ormDateTime_t *, size_t, bool *) const noexcept;
+
 void pgSQLResult_t::swap(pgSQLResult_t &res) noexcept
 {
 	std::swap(result, res.result);
@@ -316,41 +1892,127 @@ double pgSQLValue_t::asDouble() const
 	return value;
 }
 
-// The conversion code here is ripped off wholesale from
-// https://en.wikipedia.org/wiki/Julian_day#Julian_or_Gregorian_calendar_from_Julian_day_number
-// It is insane. This code stinks. The naming is even ?? but there's no way around this.
-// Postgres dug us into this mess
-ormDate_t pgSQLValue_t::julianDateToDate(const int64_t date) noexcept
+// Reads a single big endian value out of a raw array
+template<typename T> inline T readRaw(const T *const value) noexcept
+{
+	typename std::make_unsigned<T>::type rawValue{};
+	std::memcpy(&rawValue, value, sizeof(T));
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	swapBytes(rawValue);
+#endif
+	return static_cast<T>(rawValue);
+}
+
+// This is Howard Hinnant's civil_from_days() (http://howardhinnant.github.io/date_algorithms.html#civil_from_days)
+// rebased onto the Postgres epoch. Keeping it to unsigned arithmetic and selects with no branches is
+// what lets the compiler vectorise it when run over a block of dates.
+inline void civilFromDays(const int32_t date, int32_t &year, uint32_t &month, uint32_t &day) noexcept
+{
+	const uint32_t dayNumber{static_cast<uint32_t>(date) + civilDaysOffset};
+	const uint32_t era{dayNumber / 146097U};
+	const uint32_t dayOfEra{dayNumber - (era * 146097U)};
+	const uint32_t yearOfEra{(dayOfEra - (dayOfEra / 1460U) + (dayOfEra / 36524U) - (dayOfEra / 146096U)) / 365U};
+	const uint32_t dayOfYear{dayOfEra - ((365U * yearOfEra) + (yearOfEra / 4U) - (yearOfEra / 100U))};
+	const uint32_t shiftedMonth{((5U * dayOfYear) + 2U) / 153U};
+	day = dayOfYear - (((153U * shiftedMonth) + 2U) / 5U) + 1U;
+	month = shiftedMonth < 10U ? shiftedMonth + 3U : shiftedMonth - 9U;
+	year = static_cast<int32_t>((era * 400U) + yearOfEra + (month <= 2U ? 1U : 0U)) - civilYearsOffset;
+}
+
+// Splits a timestamp into its day and time of day. This floors rather than truncates so
+// times before the epoch still land on the right day with a time of day that is in range.
+inline void splitTimestamp(const int64_t timestamp, int32_t &date, uint64_t &time) noexcept
+{
+	const auto timeOfDay{timestamp % microsecondsPerDay};
+	const int64_t borrow{timeOfDay < 0 ? 1 : 0};
+	date = static_cast<int32_t>((timestamp / microsecondsPerDay) - borrow);
+	time = static_cast<uint64_t>(timeOfDay + (borrow * microsecondsPerDay));
+}
+
+inline ormDate_t makeDate(const int32_t year, const uint32_t month, const uint32_t day) noexcept
+	{ return {static_cast<int16_t>(year), static_cast<uint8_t>(month), static_cast<uint8_t>(day)}; }
+
+inline ormDateTime_t makeDateTime(const int32_t year, const uint32_t month, const uint32_t day,
+	const uint64_t time) noexcept
 {
-	const auto f{date + 1401 + (((4 * date + 274277) / 146097) * 3) / 4 - 38};
-	const auto e{4 * f + 3};
-	const auto g{(e % 1461) / 4};
-	const auto h{5 * g + 2};
-	const auto day{(h % 153) / 5 + 1};
-	const auto month{((h / 153 + 2) % 12) + 1};
-	const auto year{(e / 1461) - 4716 + (14 - month) / 12};
-	return {static_cast<int16_t>(year), static_cast<uint8_t>(month), static_cast<uint8_t>(day)};
+	const auto seconds{time / 1000000U};
+	const auto microseconds{static_cast<uint32_t>(time % 1000000U)};
+	return {static_cast<int16_t>(year), static_cast<uint8_t>(month), static_cast<uint8_t>(day),
+		static_cast<uint8_t>(seconds / 3600U), static_cast<uint8_t>((seconds / 60U) % 60U),
+		static_cast<uint8_t>(seconds % 60U), microseconds * 1000U};
 }
 
 ormDate_t pgSQLValue_t::asDate() const
 {
 	const auto date{asInt<int32_t, DATEOID, pgSQLErrorType_t::dateError>()};
-	return julianDateToDate(date +  postgresDateEpoch);
+	int32_t year{};
+	uint32_t month{}, day{};
+	civilFromDays(date, year, month, day);
+	return makeDate(year, month, day);
 }
 
 ormDateTime_t pgSQLValue_t::asDateTime() const
 {
-	auto timestamp{asInt<int64_t, TIMESTAMPOID, pgSQLErrorType_t::dateTimeError>()};
-	const auto microseconds{static_cast<uint32_t>(timestamp % 1000000)};
-	timestamp /= 1000000;
-	const auto seconds{static_cast<uint8_t>(timestamp % 60)};
-	timestamp /= 60;
-	const auto minutes{static_cast<uint8_t>(timestamp % 60)};
-	timestamp /= 60;
-	const auto hours{static_cast<uint8_t>(timestamp % 24)};
-	timestamp /= 24;
-	const auto date{julianDateToDate(timestamp + postgresDateEpoch)};
-	return {date.year(), date.month(), date.day(), hours, minutes, seconds, microseconds * 1000U};
+	const auto timestamp{asInt<int64_t, TIMESTAMPOID, pgSQLErrorType_t::dateTimeError>()};
+	int32_t date{}, year{};
+	uint64_t time{};
+	uint32_t month{}, day{};
+	splitTimestamp(timestamp, date, time);
+	civilFromDays(date, year, month, day);
+	return makeDateTime(year, month, day, time);
+}
+
+/*!
+ * @brief Decodes an array of raw DATE values, as they come out of a binary result or COPY, in one go
+ * @details The dates are converted a block at a time in separate passes so the conversion vectorises.
+ * @param rawDates The big endian day numbers to decode
+ * @param dates The array to decode into, which must be at least count long
+ * @param count The number of dates to decode
+ */
+void tmplORM::pgsql::driver::decodeDates(const int32_t *const rawDates, ormDate_t *const dates,
+	const size_t count) noexcept
+{
+	std::array<int32_t, dateBlockLength> dayNumbers{};
+	std::array<int32_t, dateBlockLength> years{};
+	std::array<uint32_t, dateBlockLength> months{};
+	std::array<uint32_t, dateBlockLength> days{};
+	for (size_t offset{0}; offset < count; offset += dateBlockLength)
+	{
+		const auto length{std::min(count - offset, dateBlockLength)};
+		for (size_t i{0}; i < length; ++i)
+			dayNumbers[i] = readRaw(rawDates + offset + i);
+		for (size_t i{0}; i < length; ++i)
+			civilFromDays(dayNumbers[i], years[i], months[i], days[i]);
+		for (size_t i{0}; i < length; ++i)
+			dates[offset + i] = makeDate(years[i], months[i], days[i]);
+	}
+}
+
+/*!
+ * @brief Decodes an array of raw TIMESTAMP values, as they come out of a binary result or COPY, in one go
+ * @details The timestamps are converted a block at a time in separate passes so the date conversion vectorises.
+ * @param rawDateTimes The big endian microsecond counts to decode
+ * @param dateTimes The array to decode into, which must be at least count long
+ * @param count The number of timestamps to decode
+ */
+void tmplORM::pgsql::driver::decodeDateTimes(const int64_t *const rawDateTimes, ormDateTime_t *const dateTimes,
+	const size_t count) noexcept
+{
+	std::array<int32_t, dateBlockLength> dates{};
+	std::array<uint64_t, dateBlockLength> times{};
+	std::array<int32_t, dateBlockLength> years{};
+	std::array<uint32_t, dateBlockLength> months{};
+	std::array<uint32_t, dateBlockLength> days{};
+	for (size_t offset{0}; offset < count; offset += dateBlockLength)
+	{
+		const auto length{std::min(count - offset, dateBlockLength)};
+		for (size_t i{0}; i < length; ++i)
+			splitTimestamp(readRaw(rawDateTimes + offset + i), dates[i], times[i]);
+		for (size_t i{0}; i < length; ++i)
+			civilFromDays(dates[i], years[i], months[i], days[i]);
+		for (size_t i{0}; i < length; ++i)
+			dateTimes[offset + i] = makeDateTime(years[i], months[i], days[i], times[i]);
+	}
 }
 
 ormUUID_t pgSQLValue_t::asUUID() const
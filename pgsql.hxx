@@ -2,6 +2,9 @@
 #define PGSQL_HXX
 
 #include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
 #include <libpq-fe.h>
 #include <substrate/managed_ptr>
 #include "tmplORM.hxx"
@@ -20,6 +23,10 @@ namespace tmplORM
 		namespace driver
 		{
 struct pgSQLClient_t;
+struct pgSQLPipeline_t;
+struct pgSQLResultStream_t;
+struct pgSQLAsyncQuery_t;
+template<bool> struct bindValue_t;
 using namespace tmplORM::types::baseTypes;
 using tmplORM::common::fieldLength_t;
 
@@ -61,7 +68,6 @@ private:
 
 	template<typename T> inline T reinterpret() const noexcept;
 	template<typename T, Oid, pgSQLErrorType_t> inline T asInt() const;
-	static ormDate_t julianDateToDate(const int64_t date) noexcept;
 
 public:
 	/*! @brief Default constructor for value objects, constructing the invalid value by default */
@@ -75,6 +81,8 @@ public:
 
 	bool valid() const noexcept { return data || type != InvalidOid; }
 	bool isNull() const noexcept { return !data; }
+	/*! @brief Returns the value's raw, still big endian, bytes as they came off the wire */
+	const void *rawData() const noexcept { return data; }
 	const char *asString() const;
 	bool asBool() const;
 	uint8_t asUint8() const;
@@ -128,6 +136,9 @@ public:
 	pgSQLValue_t &operator =(const pgSQLValue_t &) = delete;
 };
 
+tmplORM_FNAPI void decodeDates(const int32_t *rawDates, ormDate_t *dates, size_t count) noexcept;
+tmplORM_FNAPI void decodeDateTimes(const int64_t *rawDateTimes, ormDateTime_t *dateTimes, size_t count) noexcept;
+
 struct tmplORM_API pgSQLResult_t final
 {
 private:
@@ -158,6 +169,9 @@ public:
 	uint32_t numFields() const noexcept { return fields; }
 	bool next() noexcept;
 	pgSQLValue_t operator [](const uint32_t idx) const noexcept;
+	pgSQLValue_t value(uint32_t rowIndex, uint32_t idx) const noexcept;
+	template<typename T> bool decodeColumn(uint32_t column, T *values, size_t count,
+		bool *nulls = nullptr) const noexcept;
 
 	void swap(pgSQLResult_t &res) noexcept;
 
@@ -167,39 +181,110 @@ public:
 	pgSQLResult_t &operator =(const pgSQLResult_t &) = delete;
 };
 
+struct tmplORM_API pgSQLArray_t final
+{
+private:
+	fixedVector_t<char> buffer{};
+	size_t used{0};
+	Oid arrayType{InvalidOid};
+
+	bool grow(size_t length) noexcept;
+	friend struct pgSQLQuery_t;
+
+public:
+	/*! @brief Default constructor for array objects, constructing an invalid array by default */
+	pgSQLArray_t() noexcept = default;
+	pgSQLArray_t(pgSQLType_t type, size_t count) noexcept;
+	pgSQLArray_t(pgSQLArray_t &&array) noexcept : pgSQLArray_t{} { swap(array); }
+	~pgSQLArray_t() noexcept = default;
+	void operator =(pgSQLArray_t &&array) noexcept { swap(array); }
+	/*!
+	 * @brief Call to determine if this array object is valid
+	 * @returns true if the object is valid, false otherwise
+	 */
+	bool valid() const noexcept { return buffer.valid(); }
+	void *reserve(size_t length) noexcept;
+	bool write(const void *data, size_t length) noexcept;
+	const char *data() const noexcept { return buffer.data(); }
+	size_t length() const noexcept { return used; }
+	void swap(pgSQLArray_t &array) noexcept;
+
+	/*! @brief Deleted copy constructor for pgSQLArray_t as arrays are not copyable */
+	pgSQLArray_t(const pgSQLArray_t &) = delete;
+	/*! @brief Deleted copy assignment operator for pgSQLArray_t as arrays are not copyable */
+	pgSQLArray_t &operator =(const pgSQLArray_t &) = delete;
+};
+
 struct tmplORM_API pgSQLQuery_t final
 {
 private:
 	PGconn *connection{nullptr};
+	pgSQLClient_t *client{nullptr};
+	// Which of the client's connections this named query belongs to, as the PGconn may have been freed and reused
+	uint64_t connectionID{0};
 	const char *query{nullptr};
 	size_t numParams{0};
-	fixedVector_t<Oid> paramTypes{};
-	fixedVector_t<const char *> params{};
-	fixedVector_t<substrate::managedPtr_t<void>> paramStorage{};
+	// Where in the value space a parameter's binary form lives, fixed the first time the parameter is bound
+	struct valueSlot_t final
+	{
+		size_t offset;
+		size_t length;
+	};
+
+	// A single allocation holding the parameter value pointers, value slots, types, lengths and formats,
+	// followed by the space the non-pointer parameter values get encoded into
+	fixedVector_t<char> paramStorage{};
+	const char **params{nullptr};
+	valueSlot_t *valueSlots{nullptr};
+	Oid *paramTypes{nullptr};
 	// Postgres did a stupid and assumed 'int' was 32-bit at least and that that was big enough. The API
 	// also has no sense to it re signed vs unsigned so everything is signed, even when it shouldn't be
-	fixedVector_t<int> dataLengths{};
+	int *dataLengths{nullptr};
+	int *paramFormats{nullptr};
+	char *values{nullptr};
+	size_t valuesLength{0};
+	size_t valuesUsed{0};
+	// Set when a value could not be bound for want of value space, which leaves the query unusable
+	bool bindFailed{false};
 
 	static Oid typeToOID(pgSQLType_t type) noexcept;
+	static size_t storageLength(size_t paramsCount, size_t valuesLength) noexcept;
+	void layoutStorage() noexcept;
+	char *valueStorage(size_t index, size_t length) noexcept;
+	bool connectionOpen() const noexcept;
+	bool statementName(size_t &index, bool &needsPrepare) const noexcept;
+	pgSQLResult_t prepareStatement(const char *name, size_t index) const noexcept;
+	bool send(bool canPrepare) const noexcept;
 
 protected:
-	pgSQLQuery_t(PGconn *conn, const char *queryStmt, size_t paramsCount) noexcept;
+	pgSQLQuery_t(PGconn *conn, const char *queryStmt, size_t paramsCount, size_t valuesLength) noexcept;
+	pgSQLQuery_t(pgSQLClient_t &conn, const char *queryStmt, size_t paramsCount, size_t valuesLength) noexcept;
 	friend struct pgSQLClient_t;
+	friend struct pgSQLPipeline_t;
+	friend struct pgSQLCopyOut_t;
+	friend struct pgSQLArray_t;
+	template<bool> friend struct bindValue_t;
 
 public:
+	// The widest value that gets encoded into a query's own storage, a UUID
+	constexpr static size_t maxValueLength{16U};
+
 	/*! @brief Default constructor for prepared query objects, constructing an invalid query by default */
 	constexpr pgSQLQuery_t() noexcept = default;
 	pgSQLQuery_t(pgSQLQuery_t &&qry) noexcept : pgSQLQuery_t{} { swap(qry); }
-	~pgSQLQuery_t() noexcept = default;
+	~pgSQLQuery_t() noexcept;
 	void operator =(pgSQLQuery_t &&qry) noexcept { swap(qry); }
 	/*!
 	 * @brief Call to determine if this prepared query object is valid
 	 * @returns true if the object is valid, false otherwise
 	 */
-	bool valid() const noexcept { return connection && query; }
+	bool valid() const noexcept { return connection && query && (!numParams || params) && !bindFailed; }
 	pgSQLResult_t execute() const noexcept;
+	pgSQLResultStream_t stream() const noexcept;
+	pgSQLAsyncQuery_t executeAsync() const noexcept;
 	template<typename T> void bind(const size_t index, const T &value, const fieldLength_t length) noexcept;
 	template<typename T> void bind(const size_t index, const std::nullptr_t, const fieldLength_t length) noexcept;
+	void bind(size_t index, const pgSQLArray_t &array) noexcept;
 	void swap(pgSQLQuery_t &qry) noexcept;
 
 	/*! @brief Deleted copy constructor for pgSQLQuery_t as prepared queries are not copyable */
@@ -208,11 +293,346 @@ public:
 	pgSQLQuery_t &operator =(const pgSQLQuery_t &) = delete;
 };
 
+struct tmplORM_API pgSQLPipeline_t final
+{
+private:
+	pgSQLClient_t *client{nullptr};
+	// The results to expect back, in order - either queryResult or the index of a named statement being prepared
+	std::vector<size_t> pending{};
+	size_t statements{0};
+	fixedVector_t<pgSQLResult_t> results{};
+	size_t numResults{0};
+
+	constexpr static size_t queryResult{SIZE_MAX};
+	bool begin() noexcept;
+	bool leave() const noexcept;
+	bool flush() const noexcept;
+	bool collect(fixedVector_t<pgSQLResult_t> &status) noexcept;
+	void finish() noexcept;
+
+protected:
+	pgSQLPipeline_t(pgSQLClient_t &conn) noexcept : client{&conn} { }
+	friend struct pgSQLClient_t;
+
+public:
+	/*! @brief Default constructor for pipeline objects, constructing an invalid pipeline by default */
+	pgSQLPipeline_t() noexcept = default;
+	pgSQLPipeline_t(pgSQLPipeline_t &&pipeline) noexcept : pgSQLPipeline_t{} { swap(pipeline); }
+	~pgSQLPipeline_t() noexcept;
+	void operator =(pgSQLPipeline_t &&pipeline) noexcept { swap(pipeline); }
+	/*!
+	 * @brief Call to determine if this pipeline object is valid
+	 * @returns true if the object is valid, false otherwise
+	 */
+	bool valid() const noexcept { return client; }
+	bool add(const pgSQLQuery_t &query) noexcept;
+	bool execute() noexcept;
+	/*! @brief Returns the number of statements sent down this pipeline since it was last executed */
+	size_t count() const noexcept { return statements; }
+	bool succeeded(const size_t index) const noexcept;
+	const pgSQLResult_t &operator [](const size_t index) const noexcept;
+	void swap(pgSQLPipeline_t &pipeline) noexcept;
+
+	/*! @brief Deleted copy constructor for pgSQLPipeline_t as pipelines are not copyable */
+	pgSQLPipeline_t(const pgSQLPipeline_t &) = delete;
+	/*! @brief Deleted copy assignment operator for pgSQLPipeline_t as pipelines are not copyable */
+	pgSQLPipeline_t &operator =(const pgSQLPipeline_t &) = delete;
+};
+
+struct tmplORM_API pgSQLCopyIn_t final
+{
+private:
+	PGconn *connection{nullptr};
+	fixedVector_t<char> buffer{};
+	size_t used{0};
+
+	bool flush() noexcept;
+
+protected:
+	pgSQLCopyIn_t(PGconn *conn) noexcept;
+	friend struct pgSQLClient_t;
+
+public:
+	/*! @brief The number of bytes of COPY data accumulated before it is handed to libpq */
+	constexpr static size_t chunkLength{1024U * 1024U};
+
+	/*! @brief Default constructor for COPY objects, constructing an invalid COPY by default */
+	pgSQLCopyIn_t() noexcept = default;
+	pgSQLCopyIn_t(pgSQLCopyIn_t &&copy) noexcept : pgSQLCopyIn_t{} { swap(copy); }
+	~pgSQLCopyIn_t() noexcept;
+	void operator =(pgSQLCopyIn_t &&copy) noexcept { swap(copy); }
+	/*!
+	 * @brief Call to determine if this COPY object is valid
+	 * @returns true if the object is valid, false otherwise
+	 */
+	bool valid() const noexcept { return connection && buffer.valid(); }
+	void *reserve(size_t length) noexcept;
+	bool write(const void *data, size_t length) noexcept;
+	bool end(const char *error = nullptr) noexcept;
+	void swap(pgSQLCopyIn_t &copy) noexcept;
+
+	/*! @brief Deleted copy constructor for pgSQLCopyIn_t as COPY operations are not copyable */
+	pgSQLCopyIn_t(const pgSQLCopyIn_t &) = delete;
+	/*! @brief Deleted copy assignment operator for pgSQLCopyIn_t as COPY operations are not copyable */
+	pgSQLCopyIn_t &operator =(const pgSQLCopyIn_t &) = delete;
+};
+
+struct tmplORM_API pgSQLCopyOut_t final
+{
+private:
+	PGconn *connection{nullptr};
+	fixedVector_t<Oid> fieldTypes{};
+	// The CopyData message currently being decoded, as handed to us by libpq
+	char *data{nullptr};
+	size_t dataLength{0};
+	size_t offset{0};
+	bool headerRead{false};
+	bool completed{false};
+	// Field data for the tuples read, copied out of the messages and NUL terminated so strings can be used as-is
+	std::vector<fixedVector_t<char>> blocks{};
+	size_t block{0};
+	size_t blockOffset{0};
+	fixedVector_t<const char *> fields{};
+
+	constexpr static size_t blockLength{65536U};
+	char *storage(size_t length) noexcept;
+	bool nextMessage() noexcept;
+	bool readHeader() noexcept;
+	template<typename T> bool read(T &value) noexcept;
+	void finish(bool cancel) noexcept;
+
+protected:
+	pgSQLCopyOut_t(PGconn *conn, fixedVector_t<Oid> &&types) noexcept;
+	friend struct pgSQLClient_t;
+
+public:
+	/*! @brief Default constructor for COPY objects, constructing an invalid COPY by default */
+	pgSQLCopyOut_t() noexcept = default;
+	pgSQLCopyOut_t(pgSQLCopyOut_t &&copy) noexcept : pgSQLCopyOut_t{} { swap(copy); }
+	~pgSQLCopyOut_t() noexcept;
+	void operator =(pgSQLCopyOut_t &&copy) noexcept { swap(copy); }
+	/*!
+	 * @brief Call to determine if this COPY object is valid and still has tuples to read
+	 * @returns true if the object is valid, false otherwise
+	 */
+	bool valid() const noexcept { return connection; }
+	/*!
+	 * @brief Call to determine if the COPY ran to completion once next() has returned false
+	 * @returns true if every tuple was read successfully, false otherwise
+	 */
+	bool successful() const noexcept { return completed; }
+	bool next(bool retain = false) noexcept;
+	uint32_t numFields() const noexcept { return static_cast<uint32_t>(fieldTypes.count()); }
+	pgSQLValue_t operator [](const uint32_t idx) const noexcept;
+	void swap(pgSQLCopyOut_t &copy) noexcept;
+
+	/*! @brief Deleted copy constructor for pgSQLCopyOut_t as COPY operations are not copyable */
+	pgSQLCopyOut_t(const pgSQLCopyOut_t &) = delete;
+	/*! @brief Deleted copy assignment operator for pgSQLCopyOut_t as COPY operations are not copyable */
+	pgSQLCopyOut_t &operator =(const pgSQLCopyOut_t &) = delete;
+};
+
+struct tmplORM_API pgSQLResultStream_t final
+{
+private:
+	PGconn *connection{nullptr};
+	// The batch of rows currently being walked, or the final status result once the stream is done
+	pgSQLResult_t result{};
+	bool completed{false};
+
+	bool fetch() noexcept;
+	void finish() noexcept;
+
+protected:
+	pgSQLResultStream_t(PGconn *conn) noexcept;
+	friend struct pgSQLClient_t;
+	friend struct pgSQLQuery_t;
+
+public:
+	struct iterator_t final
+	{
+	private:
+		pgSQLResultStream_t *stream;
+
+	public:
+		// Rows are consumed as they are read, so this can only ever be walked once
+		using iterator_category = std::input_iterator_tag;
+		using value_type = pgSQLResult_t;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const pgSQLResult_t *;
+		using reference = const pgSQLResult_t &;
+
+		iterator_t(pgSQLResultStream_t *const _stream) noexcept :
+			stream{_stream && _stream->valid() ? _stream : nullptr} { }
+		reference operator *() const noexcept { return stream->result; }
+		pointer operator ->() const noexcept { return &stream->result; }
+		iterator_t &operator ++() noexcept
+		{
+			if (!stream->next())
+				stream = nullptr;
+			return *this;
+		}
+		bool operator ==(const iterator_t &other) const noexcept { return stream == other.stream; }
+		bool operator !=(const iterator_t &other) const noexcept { return stream != other.stream; }
+	};
+
+	/*! @brief Default constructor for result streams, constructing an invalid stream by default */
+	pgSQLResultStream_t() noexcept = default;
+	pgSQLResultStream_t(pgSQLResultStream_t &&stream) noexcept : pgSQLResultStream_t{} { swap(stream); }
+	~pgSQLResultStream_t() noexcept;
+	void operator =(pgSQLResultStream_t &&stream) noexcept { swap(stream); }
+	/*!
+	 * @brief Call to determine if this stream is valid and positioned on a row
+	 * @returns true if the object is valid, false otherwise
+	 */
+	bool valid() const noexcept { return connection; }
+	/*!
+	 * @brief Call to determine if the query ran to completion once next() has returned false
+	 * @returns true if every row was read successfully, false otherwise
+	 */
+	bool successful() const noexcept { return completed; }
+	const char *error() const noexcept { return result.error(); }
+	uint32_t numFields() const noexcept { return result.numFields(); }
+	bool next() noexcept;
+	pgSQLValue_t operator [](const uint32_t idx) const noexcept { return result[idx]; }
+	iterator_t begin() noexcept { return {this}; }
+	iterator_t end() noexcept { return {nullptr}; }
+	void swap(pgSQLResultStream_t &stream) noexcept;
+
+	/*! @brief Deleted copy constructor for pgSQLResultStream_t as result streams are not copyable */
+	pgSQLResultStream_t(const pgSQLResultStream_t &) = delete;
+	/*! @brief Deleted copy assignment operator for pgSQLResultStream_t as result streams are not copyable */
+	pgSQLResultStream_t &operator =(const pgSQLResultStream_t &) = delete;
+};
+
+struct tmplORM_API pgSQLAsyncQuery_t final
+{
+private:
+	PGconn *connection{nullptr};
+	pgSQLResult_t queryResult{};
+	// true while some of the query is still waiting to be written out to the server
+	bool flushing{false};
+	bool completed{false};
+
+	bool flush() noexcept;
+	void fail() noexcept;
+	void finish() noexcept;
+
+protected:
+	pgSQLAsyncQuery_t(PGconn *conn) noexcept;
+	friend struct pgSQLClient_t;
+	friend struct pgSQLQuery_t;
+
+public:
+	/*! @brief Default constructor for asynchronous queries, constructing an invalid query by default */
+	pgSQLAsyncQuery_t() noexcept = default;
+	pgSQLAsyncQuery_t(pgSQLAsyncQuery_t &&query) noexcept : pgSQLAsyncQuery_t{} { swap(query); }
+	~pgSQLAsyncQuery_t() noexcept;
+	void operator =(pgSQLAsyncQuery_t &&query) noexcept { swap(query); }
+	/*!
+	 * @brief Call to determine if this query is valid and still in flight
+	 * @returns true if the object is valid, false otherwise
+	 */
+	bool valid() const noexcept { return connection; }
+	/*!
+	 * @brief Call to determine if the query has finished, after which its result can be looked at
+	 * @returns true if the query has finished, false otherwise
+	 */
+	bool done() const noexcept { return completed; }
+	int socket() const noexcept;
+	/*!
+	 * @brief Call to determine if the query needs the socket to become writable to make progress,
+	 *     as well as the socket becoming readable
+	 */
+	bool wantsWrite() const noexcept { return flushing; }
+	bool process() noexcept;
+	pgSQLResult_t &result() noexcept { return queryResult; }
+	void swap(pgSQLAsyncQuery_t &query) noexcept;
+
+	/*! @brief Deleted copy constructor for pgSQLAsyncQuery_t as queries are not copyable */
+	pgSQLAsyncQuery_t(const pgSQLAsyncQuery_t &) = delete;
+	/*! @brief Deleted copy assignment operator for pgSQLAsyncQuery_t as queries are not copyable */
+	pgSQLAsyncQuery_t &operator =(const pgSQLAsyncQuery_t &) = delete;
+};
+
+/*! @brief Interface for the work to do when an asynchronous query run by a pgSQLEventLoop_t completes */
+struct tmplORM_API pgSQLCompletion_t
+{
+	pgSQLCompletion_t() noexcept = default;
+	virtual ~pgSQLCompletion_t() noexcept = default;
+	virtual void complete(pgSQLResult_t &result) noexcept = 0;
+
+	/*! @brief Deleted copy constructor for pgSQLCompletion_t as completions are not copyable */
+	pgSQLCompletion_t(const pgSQLCompletion_t &) = delete;
+	/*! @brief Deleted copy assignment operator for pgSQLCompletion_t as completions are not copyable */
+	pgSQLCompletion_t &operator =(const pgSQLCompletion_t &) = delete;
+};
+
+struct tmplORM_API pgSQLEventLoop_t final
+{
+private:
+	struct pending_t final
+	{
+		pgSQLAsyncQuery_t query;
+		std::unique_ptr<pgSQLCompletion_t> completion;
+	};
+
+	std::vector<pending_t> queries{};
+
+public:
+	pgSQLEventLoop_t() noexcept = default;
+	pgSQLEventLoop_t(pgSQLEventLoop_t &&loop) noexcept : pgSQLEventLoop_t{} { swap(loop); }
+	~pgSQLEventLoop_t() noexcept = default;
+	void operator =(pgSQLEventLoop_t &&loop) noexcept { swap(loop); }
+	bool add(pgSQLAsyncQuery_t &&query, std::unique_ptr<pgSQLCompletion_t> &&completion) noexcept;
+	/*! @brief Returns the number of queries still in flight on this event loop */
+	size_t pending() const noexcept { return queries.size(); }
+	bool poll(int timeout) noexcept;
+	bool run() noexcept;
+	void swap(pgSQLEventLoop_t &loop) noexcept { queries.swap(loop.queries); }
+
+	/*! @brief Deleted copy constructor for pgSQLEventLoop_t as event loops are not copyable */
+	pgSQLEventLoop_t(const pgSQLEventLoop_t &) = delete;
+	/*! @brief Deleted copy assignment operator for pgSQLEventLoop_t as event loops are not copyable */
+	pgSQLEventLoop_t &operator =(const pgSQLEventLoop_t &) = delete;
+};
+
 struct tmplORM_API pgSQLClient_t final
 {
 private:
 	PGconn *connection{nullptr};
+	// Identifies the current connection, every connection this client makes getting a new ID
+	uint64_t connectionID{0};
+	uint64_t lastConnectionID{0};
 	bool needsCommit{false};
+	// Query texts prepared as named statements on this connection, the index being the statement's name
+	std::vector<const char *> preparedQueries{};
+	// Parameter storage handed back by the last named query to be done with it, for the next to reuse
+	fixedVector_t<char> paramCache{};
+	// How many named queries refer back to this client - these must all be gone before the client is
+	size_t liveQueries{0};
+
+	// A connection switchDB() switched away from, kept open along with the statements prepared on it
+	struct parkedConnection_t final
+	{
+		PGconn *connection;
+		uint64_t connectionID;
+		std::vector<const char *> preparedQueries;
+	};
+	// The connections to switch back to, least recently used first, each to a different database
+	std::vector<parkedConnection_t> parkedConnections{};
+	constexpr static size_t maxParkedConnections{8};
+
+	std::vector<const char *> *preparedOn(uint64_t connID) noexcept;
+	bool findPrepared(uint64_t connID, const char *queryStmt, size_t &index) noexcept;
+	bool addPrepared(uint64_t connID, const char *queryStmt, size_t &index) noexcept;
+	void removePrepared(uint64_t connID, size_t index) noexcept;
+	fixedVector_t<char> borrowParamStorage(size_t length) noexcept;
+	void releaseParamStorage(fixedVector_t<char> &&storage) noexcept;
+	bool unpark(const char *db) noexcept;
+	void park() noexcept;
+	friend struct pgSQLQuery_t;
+	friend struct pgSQLPipeline_t;
 
 public:
 	pgSQLClient_t() noexcept = default;
@@ -232,7 +652,19 @@ public:
 	bool commit() noexcept { return endTransact(true); }
 	bool rollback() noexcept { return endTransact(false); }
 	pgSQLResult_t query(const char *queryStmt) const noexcept;
-	pgSQLQuery_t prepare(const char *queryStmt, const size_t paramsCount) const noexcept;
+	pgSQLQuery_t prepare(const char *queryStmt, const size_t paramsCount) const noexcept
+		{ return prepare(queryStmt, paramsCount, paramsCount * pgSQLQuery_t::maxValueLength); }
+	pgSQLQuery_t prepare(const char *queryStmt, size_t paramsCount, size_t valuesLength) const noexcept;
+	pgSQLQuery_t prepareNamed(const char *queryStmt, const size_t paramsCount) noexcept
+		{ return prepareNamed(queryStmt, paramsCount, paramsCount * pgSQLQuery_t::maxValueLength); }
+	pgSQLQuery_t prepareNamed(const char *queryStmt, size_t paramsCount, size_t valuesLength) noexcept;
+	size_t preparedCount() const noexcept;
+	pgSQLPipeline_t pipeline() noexcept;
+	pgSQLCopyIn_t copyIn(const char *queryStmt) const noexcept;
+	pgSQLCopyOut_t copyOut(const char *queryStmt, const pgSQLType_t *types, size_t typesCount) const noexcept;
+	pgSQLResultStream_t stream(const char *queryStmt) const noexcept;
+	pgSQLAsyncQuery_t queryAsync(const char *queryStmt) const noexcept;
+	int socket() const noexcept;
 	const char *error() const noexcept;
 
 	/*! @brief Deleted move constructor for pgSQLClient_t as client connections are not movable */
@@ -99,6 +99,8 @@ namespace tmplORM
 				setter(*this, _value);
 			}
 		};
+
+		template<typename T> struct unwrapField_t<jsonNullable_t<T>> : unwrapField_t<T> { };
 	}
 }
 
@@ -1,4 +1,5 @@
 #include <memory>
+#include <array>
 #include <string>
 #include <chrono>
 #include <type_traits>
@@ -100,9 +101,25 @@ private:
 		assertFalse(testClient.valid());
 		assertFalse(testClient.query("").valid());
 		assertFalse(testClient.prepare("", 0).valid());
+		assertFalse(testClient.prepareCached("", 0).valid());
+		assertFalse(testClient.query(u"").valid());
+		assertFalse(testClient.prepare(u"", 0).valid());
+		assertFalse(testClient.prepareCached(u"", 0).valid());
+		assertEqual(testClient.cachedCount(), 0);
+		assertFalse(testClient.queryAsync("").valid());
+		assertFalse(testClient.queryAsync(u"").valid());
 		tSQLQuery_t testQuery{};
 		assertFalse(testQuery.valid());
 		assertFalse(testQuery.execute().valid());
+		assertFalse(testQuery.executeAsync().valid());
+		tSQLAsyncQuery_t testAsync{};
+		assertFalse(testAsync.valid());
+		assertFalse(testAsync.done());
+		assertFalse(testAsync.process());
+		assertFalse(testAsync.result().valid());
+		assertFalse(testQuery.paramSets(1));
+		assertEqual(testQuery.paramSetsCount(), 0);
+		assertFalse(testQuery.paramSetSucceeded(0));
 		tSQLResult_t testResult{};
 		assertFalse(testResult.valid());
 		assertEqual(testResult.numRows(), 0);
@@ -259,6 +276,18 @@ private:
 		testData[1].entryID = result[0];
 		assertEqual(testData[1].entryID, 2);
 		assertFalse(result.next());
+
+		// The result of an uncached query must stay usable after the query it came from is gone
+		result = []() -> tSQLResult_t
+		{
+			auto selectQuery{testClient->prepare("SELECT [Name] FROM [tmplORM] WHERE [EntryID] = ?;", 1)};
+			selectQuery.bind(0, testData[0].entryID.value(), fieldLength(testData[0].entryID));
+			return selectQuery.execute();
+		}();
+		assertTrue(result.valid());
+		assertTrue(result.hasData());
+		assertEqual(result[0].asString().get(), testData[0].name);
+		assertFalse(result.next());
 	}
 	catch (const tSQLValueError_t &error)
 	{
@@ -476,6 +505,222 @@ private:
 		fail("Exception thrown while converting value");
 	}
 
+	void testBlockFetch() try
+	{
+		assertNotNull(testClient);
+		assertTrue(testClient->valid());
+		// Enough rows that the result has to be fetched in several blocks
+		constexpr int32_t rows{1000};
+		auto result{testClient->query(R"(
+			WITH [Numbers] ([N]) AS (SELECT 1 UNION ALL SELECT [N] + 1 FROM [Numbers] WHERE [N] < 1000)
+			SELECT [N], CAST([N] AS NVARCHAR(10)), CASE WHEN [N] % 2 = 0 THEN NULL ELSE [N] END
+			FROM [Numbers] OPTION (MAXRECURSION 1000);
+		)")};
+		if (testClient->error() != tSQLExecErrorType_t::ok)
+			printError("Query", testClient->error());
+		assertTrue(result.valid());
+		assertEqual(result.numFields(), 3);
+
+		for (int32_t i{1}; i <= rows; ++i)
+		{
+			assertEqual(result[0].asInt32(), i);
+			assertEqual(result[1].asString().get(), std::to_string(i).c_str());
+			if (i % 2)
+				assertEqual(result[2].asInt32(), i);
+			else
+				assertTrue(result[2].isNull());
+			assertEqual(result.next(), i != rows);
+		}
+	}
+	catch (const tSQLValueError_t &error)
+	{
+		puts(error.error());
+		fail("Exception thrown while converting value");
+	}
+
+	void testLongString() try
+	{
+		assertNotNull(testClient);
+		assertTrue(testClient->valid());
+		// (MAX) columns can't be block fetched, and values this long take several reads to get all of
+		auto result{testClient->query(R"(
+			SELECT REPLICATE(CAST(N'x' AS NVARCHAR(MAX)), 20000), REPLICATE(CAST('y' AS VARCHAR(MAX)), 10000)
+			UNION ALL SELECT N'z', 'w'
+			UNION ALL SELECT REPLICATE(CAST(N'v' AS NVARCHAR(MAX)), 30000), NULL;
+		)")};
+		if (testClient->error() != tSQLExecErrorType_t::ok)
+			printError("Query", testClient->error());
+		assertTrue(result.valid());
+		assertEqual(result.numFields(), 2);
+
+		assertEqual(result[0].asString().get(), std::string(20000, 'x').c_str());
+		assertEqual(result[1].asString().get(), std::string(10000, 'y').c_str());
+		assertTrue(result.next());
+		assertEqual(result[0].asString().get(), "z");
+		assertEqual(result[1].asString().get(), "w");
+		assertTrue(result.next());
+		assertEqual(result[0].asString().get(), std::string(30000, 'v').c_str());
+		assertTrue(result[1].isNull());
+		assertFalse(result.next());
+	}
+	catch (const tSQLValueError_t &error)
+	{
+		puts(error.error());
+		fail("Exception thrown while converting value");
+	}
+
+	void testParamSets() try
+	{
+		assertNotNull(testClient);
+		assertTrue(testClient->valid());
+		const std::array<const char *, 4> names{{"Alpha", "Beta", "Gamma Delta Epsilon", ""}};
+		auto query{testClient->prepare("INSERT INTO [tmplORM] ([Name], [Value]) VALUES (?, ?);", 2)};
+		assertTrue(query.valid());
+		assertFalse(query.paramSets(0));
+		assertTrue(query.paramSets(names.size()));
+		assertEqual(query.paramSetsCount(), names.size());
+
+		for (size_t i{0}; i < names.size(); ++i)
+		{
+			query.paramSet(i);
+			query.bind(0, names[i], fieldLength_t{50, 0});
+			if (i % 2)
+				query.bind<int32_t>(1, nullptr, fieldLength_t{0, 0});
+			else
+				query.bind(1, int32_t(i * 100), fieldLength_t{0, 0});
+		}
+		auto result{query.execute()};
+		if (testClient->error() != tSQLExecErrorType_t::ok)
+			printError("Prepared exec", testClient->error());
+		assertTrue(result.valid());
+		for (size_t i{0}; i < names.size(); ++i)
+			assertTrue(query.paramSetSucceeded(i));
+		assertFalse(query.paramSetSucceeded(names.size()));
+
+		result = testClient->query("SELECT [Name], [Value] FROM [tmplORM] "
+			"WHERE [Name] IN (N'Alpha', N'Beta', N'Gamma Delta Epsilon', N'') ORDER BY [EntryID];");
+		if (testClient->error() != tSQLExecErrorType_t::ok)
+			printError("Query", testClient->error());
+		assertTrue(result.valid());
+		assertEqual(result.numFields(), 2);
+		for (size_t i{0}; i < names.size(); ++i)
+		{
+			assertEqual(result[0].asString().get(), names[i]);
+			if (i % 2)
+				assertTrue(result[1].isNull());
+			else
+				assertEqual(result[1].asInt32(), int32_t(i * 100));
+			assertEqual(result.next(), i + 1 != names.size());
+		}
+	}
+	catch (const tSQLValueError_t &error)
+	{
+		puts(error.error());
+		fail("Exception thrown while converting value");
+	}
+
+	void testCachedQuery() try
+	{
+		assertNotNull(testClient);
+		assertTrue(testClient->valid());
+		static const char *const insertStmt{"INSERT INTO [tmplORM] ([Name], [Value]) VALUES (?, ?);"};
+		static const char *const selectStmt{"SELECT [Value] FROM [tmplORM] WHERE [Name] = ? ORDER BY [EntryID];"};
+		const char *const name{"Cached"};
+		assertEqual(testClient->cachedCount(), 0);
+
+		for (int32_t i{0}; i < 3; ++i)
+		{
+			auto query{testClient->prepareCached(insertStmt, 2)};
+			assertTrue(query.valid());
+			query.bind(0, name, fieldLength_t{50, 0});
+			query.bind(1, i, fieldLength_t{0, 0});
+			const auto result{query.execute()};
+			if (testClient->error() != tSQLExecErrorType_t::ok)
+				printError("Prepared exec", testClient->error());
+			assertTrue(result.valid());
+			// Each time around, the statement prepared the first time should be handed back out
+			assertEqual(testClient->cachedCount(), 1);
+		}
+
+		// While one query holds the cached statement, another for the same text gets its own uncached one
+		auto query{testClient->prepareCached(selectStmt, 1)};
+		assertTrue(query.valid());
+		assertEqual(testClient->cachedCount(), 2);
+		auto otherQuery{testClient->prepareCached(selectStmt, 1)};
+		assertTrue(otherQuery.valid());
+		assertEqual(testClient->cachedCount(), 2);
+		otherQuery = {};
+
+		// Prepared queries can be run again, the previous result being closed off first
+		query.bind(0, name, fieldLength_t{50, 0});
+		for (size_t run{0}; run < 2; ++run)
+		{
+			const auto result{query.execute()};
+			if (testClient->error() != tSQLExecErrorType_t::ok)
+				printError("Prepared exec", testClient->error());
+			assertTrue(result.valid());
+			for (int32_t i{0}; i < 3; ++i)
+			{
+				assertEqual(result[0].asInt32(), i);
+				assertEqual(result.next(), i != 2);
+			}
+		}
+	}
+	catch (const tSQLValueError_t &error)
+	{
+		puts(error.error());
+		fail("Exception thrown while converting value");
+	}
+
+	void testAsync() try
+	{
+		assertNotNull(testClient);
+		assertTrue(testClient->valid());
+		auto query{testClient->queryAsync("SELECT COUNT(*) FROM [tmplORM] WHERE [Name] = 'Cached';")};
+		assertTrue(query.valid() || query.done());
+		while (!query.done())
+			assertTrue(query.process());
+		assertFalse(query.valid());
+		assertFalse(query.process());
+		if (testClient->error() != tSQLExecErrorType_t::ok)
+			printError("Async query", testClient->error());
+		assertTrue(query.result().valid());
+		assertEqual(query.result()[0].asInt32(), 3);
+
+		auto prepared{testClient->prepare("SELECT [Value] FROM [tmplORM] WHERE [Name] = ? ORDER BY [EntryID];", 1)};
+		const char *const name{"Cached"};
+		prepared.bind(0, name, fieldLength_t{50, 0});
+		query = prepared.executeAsync();
+		while (!query.done())
+			assertTrue(query.process());
+		auto &result{query.result()};
+		assertTrue(result.valid());
+		for (int32_t i{0}; i < 3; ++i)
+		{
+			assertEqual(result[0].asInt32(), i);
+			assertEqual(result.next(), i != 2);
+		}
+
+		// Errors come back through the client, just as they do for blocking queries
+		query = testClient->queryAsync("SELECT [Nonexistent] FROM [tmplORM];");
+		while (!query.done())
+			assertTrue(query.process());
+		assertFalse(query.result().valid());
+		assertFalse(testClient->error() == tSQLExecErrorType_t::ok);
+
+		// Giving up on a query in flight must leave the connection usable
+		query = testClient->queryAsync("WAITFOR DELAY '00:00:10';");
+		query = {};
+		const auto blockingResult{testClient->query("SELECT 1;")};
+		assertTrue(blockingResult.valid());
+		assertEqual(blockingResult[0].asInt32(), 1);
+	}
+	catch (const tSQLValueError_t &error)
+	{
+		puts(error.error());
+		fail("Exception thrown while converting value");
+	}
+
 	void testBadQuery()
 	{
 		assertNotNull(testClient);
@@ -551,6 +796,11 @@ public:
 		CXX_TEST(testResult)
 		CXX_TEST(testTransact)
 		CXX_TEST(testBind)
+		CXX_TEST(testBlockFetch)
+		CXX_TEST(testLongString)
+		CXX_TEST(testParamSets)
+		CXX_TEST(testCachedQuery)
+		CXX_TEST(testAsync)
 		CXX_TEST(testBadQuery)
 		CXX_TEST(testDestroyDB)
 		CXX_TEST(testDisconnect)
@@ -1,7 +1,23 @@
+#include <string>
 #include <crunch++.h>
 #include <tmplORM.mssql.hxx>
 #include "models.hxx"
 
+using namespace models;
+using tmplORM::common::toString16;
+using tmplORM::mssql::add_;
+using tmplORM::mssql::update_;
+using tmplORM::mssql::del_;
+
+template<typename tableName, typename... fields> std::u16string add(const model_t<tableName, fields...> &)
+	{ return toString16<add_<tableName, fields...>>::value; }
+template<typename tableName, typename... fields> std::u16string update(const model_t<tableName, fields...> &)
+	{ return toString16<update_<tableName, fields...>>::value; }
+template<typename tableName, typename... fields> std::u16string del(const model_t<tableName, fields...> &)
+	{ return toString16<del_<tableName, fields...>>::value; }
+
+region_t region;
+
 class testMSSQLMapper final : public testsuite
 {
 public:
@@ -13,10 +29,19 @@ public:
 	{
 	}
 
+	void testUTF16Gen()
+	{
+		assertTrue(add(region) == u"INSERT INTO [Regions] ([RegionDescription]) OUTPUT INSERTED.[RegionID] VALUES (?);");
+		assertTrue(update(region) == u"UPDATE [Regions] SET [RegionDescription] = ? WHERE [RegionID] = ?;");
+		assertTrue(del(region) == u"DELETE FROM [Regions] WHERE [RegionID] = ?;");
+		assertTrue(toString16<typestring<>>::value[0] == u'\0');
+	}
+
 	void registerTests() final
 	{
 		CXX_TEST(testInsertGen)
 		CXX_TEST(testUpdateGen)
+		CXX_TEST(testUTF16Gen)
 	}
 };
 
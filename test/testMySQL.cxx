@@ -1,7 +1,11 @@
 #include <sys/types.h>
 #include <dirent.h>
 #include <unistd.h>
+#include <poll.h>
 #include <chrono>
+#include <clocale>
+#include <limits>
+#include <string>
 #include <substrate/utility>
 #include <crunch++.h>
 #include <mysql.hxx>
@@ -19,6 +23,7 @@
 using namespace tmplORM::mysql::driver;
 using irqus::typestring;
 using tmplORM::mysql::fieldLength;
+using tmplORM::mysql::driver::bindLiteral_t;
 using tmplORM::types::baseTypes::ormDateTime_t;
 
 using systemClock_t = std::chrono::system_clock;
@@ -104,6 +109,7 @@ private:
 		mySQLClient_t testClient;
 		assertFalse(testClient.valid());
 		assertFalse(testClient.queryResult().valid());
+		assertFalse(testClient.reset());
 		assertEqual(testClient.errorNum(), 0);
 		assertEqual(testClient.error(), "");
 		mySQLPreparedQuery_t testQuery = testClient.prepare("", 0);
@@ -126,6 +132,19 @@ private:
 		assertTrue(testBind.valid());
 		assertFalse(testBind.haveData());
 		assertNull(testBind.data());
+		mySQLBindSlab_t<2> testSlab{};
+		mySQLBind_t testSlabBind = testSlab.binds();
+		assertTrue(testSlabBind.valid());
+		assertTrue(testSlabBind.haveData());
+		assertNotNull(testSlabBind.data());
+		assertEqual(testSlabBind.count(), 2);
+		assertFalse(testQuery.reset());
+		mySQLBatch_t testBatch = testClient.batch();
+		assertFalse(testBatch.valid());
+		assertFalse(testBatch.prepare("", 0).valid());
+		assertFalse(testBatch.add(""));
+		assertFalse(testBatch.execute());
+		assertFalse(testBatch.succeeded(0));
 	}
 
 	void testClientType()
@@ -270,6 +289,38 @@ private:
 		assertFalse(query.valid());
 	}
 
+	void testPreparedReuse()
+	{
+		assertNotNull(testClient);
+		assertTrue(testClient->valid());
+		mySQLBindSlab_t<2> slab{};
+		mySQLPreparedQuery_t query = testClient->prepare("UPDATE `tmplORM` SET `Value` = ? WHERE `EntryID` = ?;", slab.binds());
+		assertTrue(query.valid());
+
+		// Execute the same statement several times, rebinding into the slab each time
+		for (const int32_t value : {10, 20, 50})
+		{
+			query.bind(0, value, fieldLength(testData[0].value));
+			query.bind(1, testData[0].entryID.value(), fieldLength(testData[0].entryID));
+			const bool result = query.execute();
+			if (!result)
+				printError("Prepared exec", query);
+			assertTrue(result);
+			assertFalse(query.execute());
+			assertTrue(query.reset());
+		}
+
+		const bool result = testClient->query("SELECT `Value` FROM `tmplORM` WHERE `EntryID` = 1;");
+		if (!result)
+			printError("Query", *testClient);
+		assertTrue(result);
+		const mySQLResult_t check = testClient->queryResult();
+		assertTrue(check.valid());
+		const mySQLRow_t row = check.resultRows();
+		assertTrue(row.valid());
+		assertEqual(row[0].asInt32(), 50);
+	}
+
 	void testResult() try
 	{
 		assertNotNull(testClient);
@@ -316,6 +367,61 @@ private:
 		fail("Exception thrown while converting value");
 	}
 
+	void testStreamCancel()
+	{
+		assertNotNull(testClient);
+		assertTrue(testClient->valid());
+		// Cross joining the digits 6 times over gives a result set of a million rows to scan through
+		const char *const digits = "(SELECT 0 AS `N` UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 "
+			"UNION ALL SELECT 4 UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 "
+			"UNION ALL SELECT 9)";
+		const bool query = testClient->query("SELECT `A`.`N` FROM %s AS `A`, %s AS `B`, %s AS `C`, %s AS `D`, "
+			"%s AS `E`, %s AS `F`;", digits, digits, digits, digits, digits, digits);
+		if (!query)
+			printError("Query", *testClient);
+		assertTrue(query);
+		mySQLResult_t result = testClient->streamResult();
+		assertTrue(result.valid());
+		mySQLRow_t row = result.resultRows();
+		assertTrue(row.valid());
+		assertEqual(row.numFields(), 1);
+		for (size_t i = 0; i < 10; ++i)
+			assertTrue(row.next());
+		assertTrue(row.cancel(16));
+		assertFalse(row.valid());
+		assertFalse(row.next());
+		assertTrue(result.numRows() < 1000000);
+
+		// Check the connection is still usable after the cancellation
+		assertTrue(testClient->query("SELECT 1;"));
+		mySQLResult_t check = testClient->queryResult();
+		assertTrue(check.valid());
+		assertEqual(check.numRows(), 1);
+	}
+
+	void testReset()
+	{
+		assertNotNull(testClient);
+		assertTrue(testClient->valid());
+		assertTrue(testClient->query("SET @tmplORM = 42;"));
+		assertTrue(testClient->query("CREATE TEMPORARY TABLE `resetTest` (`ID` INT NOT NULL);"));
+		const bool reset = testClient->reset();
+		if (!reset)
+			printError("Reset", *testClient);
+		assertTrue(reset);
+		assertTrue(testClient->valid());
+
+		// User variables and temporary tables should be gone, while the selected database should remain
+		assertTrue(testClient->query("SELECT @tmplORM, DATABASE();"));
+		mySQLResult_t result = testClient->queryResult();
+		assertTrue(result.valid());
+		mySQLRow_t row = result.resultRows();
+		assertTrue(row.valid());
+		assertTrue(row[0].isNull());
+		assertEqual(row[1].asString().get(), "tmplORM");
+		assertFalse(testClient->query("SELECT * FROM `resetTest`;"));
+	}
+
 	template<typename field_t> void bind(mySQLPreparedResult_t &result, const size_t index, field_t &value) noexcept
 		{ result.template bind<typename field_t::type>(index, fieldLength(value)); }
 
@@ -443,6 +549,130 @@ private:
 		fail("Exception thrown while converting value");
 	}
 
+	void testBatch() try
+	{
+		assertNotNull(testClient);
+		assertTrue(testClient->valid());
+		mySQLBatch_t batch = testClient->batch();
+		assertTrue(batch.valid());
+
+		const char *const name{"O'Brien"};
+		mySQLBatchStatement_t statement = batch.prepare("UPDATE `tmplORM` SET `Name` = ?, `Value` = ? WHERE `EntryID` = ?;", 3);
+		assertTrue(statement.valid());
+		statement.bind(0, name, fieldLength(testData[0].name));
+		statement.bind<int32_t>(1, nullptr, fieldLength(testData[0].value));
+		// A statement with unbound parameters must not be accepted into the batch
+		assertFalse(batch.add(statement));
+		statement.bind(2, testData[0].entryID.value(), fieldLength(testData[0].entryID));
+		assertTrue(batch.add(statement));
+		assertTrue(batch.add("DELETE FROM `tmplORM` WHERE `EntryID` = 0;"));
+		assertTrue(batch.add("SELECT COUNT(*) FROM `tmplORM`"));
+		assertEqual(batch.count(), 3);
+
+		bool result = batch.execute();
+		if (!result)
+			printf("Batch exec failed (%u): %s\n", batch.errorNum(), batch.error());
+		assertTrue(result);
+		assertTrue(batch.succeeded(0));
+		assertTrue(batch.succeeded(1));
+		assertTrue(batch.succeeded(2));
+		assertFalse(batch.succeeded(3));
+		assertEqual(batch.errorNum(), 0);
+
+		result = testClient->query("SELECT `Name`, `Value` FROM `tmplORM` WHERE `EntryID` = 1;");
+		if (!result)
+			printError("Query", *testClient);
+		assertTrue(result);
+		const mySQLResult_t check = testClient->queryResult();
+		assertTrue(check.valid());
+		mySQLRow_t row = check.resultRows();
+		assertTrue(row.valid());
+		assertEqual(row[0].asString().get(), name);
+		assertTrue(row[1].isNull());
+		assertFalse(row.next());
+
+		// MySQL stops at the first failing statement, so everything after it must be reported as failed too
+		batch.clear();
+		assertEqual(batch.count(), 0);
+		assertTrue(batch.add("UPDATE `tmplORM` SET `Name` = 'kevin', `Value` = 50 WHERE `EntryID` = 1;"));
+		assertTrue(batch.add("UPDATE `tmplORMMissing` SET `Value` = 0;"));
+		assertTrue(batch.add("UPDATE `tmplORM` SET `Value` = 0 WHERE `EntryID` = 1;"));
+		assertFalse(batch.execute());
+		assertTrue(batch.succeeded(0));
+		assertFalse(batch.succeeded(1));
+		assertFalse(batch.succeeded(2));
+		assertNotEqual(batch.errorNum(), 0);
+		assertNotNull(batch.error());
+		// And the connection must be usable (and back to single statements) afterwards
+		assertTrue(testClient->query("SELECT 1;"));
+		assertTrue(testClient->queryResult().valid());
+		assertFalse(testClient->query("SELECT 1; SELECT 2;"));
+	}
+	catch (const mySQLValueError_t &error)
+	{
+		puts(error.error());
+		fail("Exception thrown while converting value");
+	}
+
+#ifdef tmplORM_MYSQL_NONBLOCKING
+	void waitFor(mySQLAsyncClient_t &client)
+	{
+		while (client.pending())
+		{
+			pollfd fd{client.socket(), client.pollEvents(), 0};
+			const int timeout = client.waitEvents() & MYSQL_WAIT_TIMEOUT ? int(client.timeout()) : -1;
+			assertNotEqual(poll(&fd, 1, timeout), -1);
+			client.resumeFromPoll(fd.revents);
+		}
+	}
+
+	void testAsync()
+	{
+		mySQLAsyncClient_t client{};
+		assertFalse(client.valid());
+		assertFalse(client.pending());
+		assertFalse(client.query("SELECT 1;"));
+		assertFalse(client.resume(MYSQL_WAIT_READ));
+
+		assertTrue(client.connect(host, port, username, password));
+		waitFor(client);
+		if (!client.successful())
+			printf("Connection failed (%u): %s\n", client.errorNum(), client.error());
+		assertTrue(client.successful());
+		assertTrue(client.valid());
+		assertNotEqual(client.socket(), -1);
+
+		assertTrue(client.selectDB("tmplORM"));
+		waitFor(client);
+		assertTrue(client.successful());
+		assertTrue(client.query("SELECT `EntryID`, `Name` FROM `tmplORM` ORDER BY `EntryID`;"));
+		// Only one operation may be in flight on a connection at a time
+		if (client.pending())
+			assertFalse(client.query("SELECT 1;"));
+		waitFor(client);
+		assertTrue(client.successful());
+		assertTrue(client.storeResult());
+		waitFor(client);
+		assertTrue(client.successful());
+
+		mySQLResult_t result = client.queryResult();
+		assertTrue(result.valid());
+		assertEqual(result.numRows(), 2);
+		mySQLRow_t row = result.resultRows();
+		assertTrue(row.valid());
+		assertEqual(row[0], testData[0].entryID);
+		assertTrue(row.next());
+		assertEqual(row[0], testData[1].entryID);
+		assertFalse(row.next());
+		assertFalse(client.queryResult().valid());
+
+		assertTrue(client.disconnect());
+		waitFor(client);
+		assertTrue(client.successful());
+		assertFalse(client.valid());
+	}
+#endif
+
 	void testDestroyDB()
 	{
 		assertNotNull(testClient);
@@ -479,9 +709,16 @@ public:
 		CXX_TEST(testSelectDB)
 		CXX_TEST(testCreateTable)
 		CXX_TEST(testPreparedQuery)
+		CXX_TEST(testPreparedReuse)
 		CXX_TEST(testResult)
+		CXX_TEST(testStreamCancel)
+		CXX_TEST(testReset)
 		CXX_TEST(testPreparedResult)
 		CXX_TEST(testBind)
+		CXX_TEST(testBatch)
+#ifdef tmplORM_MYSQL_NONBLOCKING
+		CXX_TEST(testAsync)
+#endif
 		CXX_TEST(testDestroyDB)
 		CXX_TEST(testDisconnect)
 	}
@@ -622,7 +859,7 @@ public:
 		tryOk<int8_t>({"-128", 5, MYSQL_TYPE_TINY}, -128);
 		tryShouldFail<int8_t>({"a", 2, MYSQL_TYPE_TINY});
 		tryShouldFail<int8_t>({"256", 4, MYSQL_TYPE_TINY});
-		//tryShouldFail<int8_t>({"-129", 5, MYSQL_TYPE_TINY});
+		tryShouldFail<int8_t>({"-129", 5, MYSQL_TYPE_TINY});
 		tryShouldFail<int8_t>({"1023", 5, MYSQL_TYPE_TINY});
 		tryShouldFail<int8_t>({"1-27", 5, MYSQL_TYPE_TINY});
 	}
@@ -674,7 +911,7 @@ public:
 		tryOk<int16_t>({"-32768", 7, MYSQL_TYPE_SHORT}, -32768);
 		tryShouldFail<int16_t>({"a", 2, MYSQL_TYPE_SHORT});
 		tryShouldFail<int16_t>({"65536", 6, MYSQL_TYPE_SHORT});
-		//tryShouldFail<int16_t>({"-32769", 5, MYSQL_TYPE_SHORT});
+		tryShouldFail<int16_t>({"-32769", 7, MYSQL_TYPE_SHORT});
 		tryShouldFail<int16_t>({"262144", 7, MYSQL_TYPE_SHORT});
 		tryShouldFail<int16_t>({"1-27", 5, MYSQL_TYPE_SHORT});
 	}
@@ -729,7 +966,7 @@ public:
 		tryOk<int32_t>({"-2147483648", 12, MYSQL_TYPE_LONG}, -2147483648);
 		tryShouldFail<int32_t>({"a", 2, MYSQL_TYPE_LONG});
 		tryShouldFail<int32_t>({"4294967296", 11, MYSQL_TYPE_LONG});
-		//tryShouldFail<int32_t>({"-2147483649", 5, MYSQL_TYPE_LONG});
+		tryShouldFail<int32_t>({"-2147483649", 12, MYSQL_TYPE_LONG});
 		tryShouldFail<int32_t>({"17179869184", 12, MYSQL_TYPE_LONG});
 		tryShouldFail<int32_t>({"1-27", 5, MYSQL_TYPE_LONG});
 	}
@@ -788,11 +1025,70 @@ public:
 		//tryShouldFail<int64_t>({"-9223372036854775808", 21, MYSQL_TYPE_LONGLONG});
 		tryShouldFail<int64_t>({"a", 2, MYSQL_TYPE_LONGLONG});
 		tryShouldFail<int64_t>({"18446744073709551616", 21, MYSQL_TYPE_LONGLONG});
-		//tryShouldFail<int64_t>({"-9223372036854775809", 5, MYSQL_TYPE_LONGLONG});
+		tryShouldFail<int64_t>({"-9223372036854775809", 21, MYSQL_TYPE_LONGLONG});
 		tryShouldFail<int64_t>({"73786976294838206464", 21, MYSQL_TYPE_LONGLONG});
 		tryShouldFail<int64_t>({"1-27", 5, MYSQL_TYPE_LONGLONG});
 	}
 
+	void testFloat()
+	{
+		tryIsNull<float>({nullptr, 0, MYSQL_TYPE_FLOAT});
+		tryIsNull<float>({"", 0, MYSQL_TYPE_NULL});
+		tryShouldFail<float>({"", 0, MYSQL_TYPE_VARCHAR});
+		tryShouldFail<float>({"", 0, MYSQL_TYPE_LONG});
+		tryShouldFail<float>({"", 0, MYSQL_TYPE_DOUBLE});
+		tryShouldFail<float>({"", 0, MYSQL_TYPE_STRING});
+		tryOk<float>({"0", 2, MYSQL_TYPE_FLOAT}, 0.0F);
+		tryOk<float>({"", 1, MYSQL_TYPE_FLOAT}, 0.0F);
+		tryOk<float>({"", 0, MYSQL_TYPE_FLOAT}, 0.0F);
+		tryOk<float>({"0.5", 4, MYSQL_TYPE_FLOAT}, 0.5F);
+		tryOk<float>({"-1.25", 6, MYSQL_TYPE_FLOAT}, -1.25F);
+		tryOk<float>({"3.14159", 8, MYSQL_TYPE_FLOAT}, 3.14159F);
+		tryOk<float>({"1e-5", 5, MYSQL_TYPE_FLOAT}, 1e-5F);
+		tryOk<float>({"3.40282e38", 11, MYSQL_TYPE_FLOAT}, 3.40282e38F);
+		tryOk<float>({"1.17549e-38", 12, MYSQL_TYPE_FLOAT}, 1.17549e-38F);
+		tryShouldFail<float>({"a", 2, MYSQL_TYPE_FLOAT});
+		tryShouldFail<float>({"1.2.3", 6, MYSQL_TYPE_FLOAT});
+		tryShouldFail<float>({"1e", 3, MYSQL_TYPE_FLOAT});
+		tryShouldFail<float>({"-", 2, MYSQL_TYPE_FLOAT});
+		// Out of range values must come out the same whether or not the mantissa fits the fast paths
+		tryOk<float>({"1e39", 5, MYSQL_TYPE_FLOAT}, std::numeric_limits<float>::infinity());
+		tryOk<float>({"123456789012345678901e39", 25, MYSQL_TYPE_FLOAT}, std::numeric_limits<float>::infinity());
+		tryOk<float>({"1e-70", 6, MYSQL_TYPE_FLOAT}, 0.0F);
+		tryOk<float>({"123456789012345678901e-70", 26, MYSQL_TYPE_FLOAT}, 0.0F);
+	}
+
+	void testDouble()
+	{
+		tryIsNull<double>({nullptr, 0, MYSQL_TYPE_DOUBLE});
+		tryIsNull<double>({"", 0, MYSQL_TYPE_NULL});
+		tryShouldFail<double>({"", 0, MYSQL_TYPE_VARCHAR});
+		tryShouldFail<double>({"", 0, MYSQL_TYPE_LONGLONG});
+		tryShouldFail<double>({"", 0, MYSQL_TYPE_FLOAT});
+		tryShouldFail<double>({"", 0, MYSQL_TYPE_STRING});
+		tryOk<double>({"0", 2, MYSQL_TYPE_DOUBLE}, 0.0);
+		tryOk<double>({"", 1, MYSQL_TYPE_DOUBLE}, 0.0);
+		tryOk<double>({"", 0, MYSQL_TYPE_DOUBLE}, 0.0);
+		tryOk<double>({"0.1", 4, MYSQL_TYPE_DOUBLE}, 0.1);
+		tryOk<double>({"-2.5", 5, MYSQL_TYPE_DOUBLE}, -2.5);
+		tryOk<double>({"3.141592653589793", 18, MYSQL_TYPE_DOUBLE}, 3.141592653589793);
+		tryOk<double>({"1.7976931348623157e308", 23, MYSQL_TYPE_DOUBLE}, 1.7976931348623157e308);
+		tryOk<double>({"2.2250738585072014e-308", 24, MYSQL_TYPE_DOUBLE}, 2.2250738585072014e-308);
+		tryOk<double>({"4.9406564584124654e-324", 24, MYSQL_TYPE_DOUBLE}, 4.9406564584124654e-324);
+		tryOk<double>({"9007199254740993", 17, MYSQL_TYPE_DOUBLE}, 9007199254740992.0);
+		tryOk<double>({"123456789012345678901234", 25, MYSQL_TYPE_DOUBLE}, 1.2345678901234568e23);
+		tryShouldFail<double>({"a", 2, MYSQL_TYPE_DOUBLE});
+		tryShouldFail<double>({"1.2.3", 6, MYSQL_TYPE_DOUBLE});
+		tryShouldFail<double>({"1e+", 4, MYSQL_TYPE_DOUBLE});
+		tryShouldFail<double>({".", 2, MYSQL_TYPE_DOUBLE});
+		tryShouldFail<double>({"12345678901234567890123.5x", 27, MYSQL_TYPE_DOUBLE});
+		tryOk<double>({"1e400", 6, MYSQL_TYPE_DOUBLE}, std::numeric_limits<double>::infinity());
+		tryOk<double>({"12345678901234567890123e400", 28, MYSQL_TYPE_DOUBLE}, std::numeric_limits<double>::infinity());
+		tryOk<double>({"-12345678901234567890123e400", 29, MYSQL_TYPE_DOUBLE}, -std::numeric_limits<double>::infinity());
+		tryOk<double>({"1e-400", 7, MYSQL_TYPE_DOUBLE}, 0.0);
+		tryOk<double>({"1234567890123456789012e-400", 28, MYSQL_TYPE_DOUBLE}, 0.0);
+	}
+
 	void testBool()
 	{
 		tryIsNull<bool>({nullptr, 0, MYSQL_TYPE_BIT});
@@ -885,11 +1181,41 @@ public:
 		tryOk<ormUUID_t>({"00000000000000000000000000000000", 32, MYSQL_TYPE_STRING}, {});
 		tryOk<ormUUID_t>({"FFFFFFFF000000000000000000000000", 32, MYSQL_TYPE_STRING}, {0xFFFFFFFF, 0, 0, 0, 0});
 		tryOk<ormUUID_t>({uuidString.get(), 32, MYSQL_TYPE_STRING}, uuid);
+		tryOk<ormUUID_t>({"\xFF\xFF\xFF\xFF\0\0\0\0\0\0\0\0\0\0\0\0", 16, MYSQL_TYPE_STRING}, {0xFFFFFFFF, 0, 0, 0, 0});
+		tryOk<ormUUID_t>({reinterpret_cast<const char *>(uuid.asPointer()), 16, MYSQL_TYPE_STRING}, uuid);
 		tryShouldFail<ormUUID_t>({"", 0, MYSQL_TYPE_STRING});
 		tryShouldFail<ormUUID_t>({"", 1, MYSQL_TYPE_STRING});
 		tryShouldFail<ormUUID_t>({"G0000000000000000000000000000000", 32, MYSQL_TYPE_STRING});
 	}
 
+	void checkFloatLiterals()
+	{
+		assertEqual(bindLiteral_t{}(0.5).get(), "0.5");
+		assertEqual(bindLiteral_t{}(-1.25e-300).get(), "-1.25e-300");
+		assertEqual(bindLiteral_t{}(1.5F).get(), "1.5");
+		assertEqual(bindLiteral_t{}(100.0).get(), "100");
+	}
+
+	void testFloatLiteral()
+	{
+		checkFloatLiterals();
+		// SQL has no literals for these, so they must not make it into a batch
+		assertNull(bindLiteral_t{}(std::numeric_limits<double>::infinity()).get());
+		assertNull(bindLiteral_t{}(-std::numeric_limits<float>::infinity()).get());
+		assertNull(bindLiteral_t{}(std::numeric_limits<double>::quiet_NaN()).get());
+
+		// The literals must not pick up the decimal comma of locales that use one
+		const std::string oldLocale{setlocale(LC_NUMERIC, nullptr)};
+		for (const char *const locale : {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8"})
+		{
+			if (!setlocale(LC_NUMERIC, locale))
+				continue;
+			checkFloatLiterals();
+			break;
+		}
+		setlocale(LC_NUMERIC, oldLocale.c_str());
+	}
+
 	void testError()
 	{
 		const char *const unknownError = "An unknown error occured";
@@ -925,10 +1251,13 @@ public:
 		CXX_TEST(testInt32)
 		CXX_TEST(testUint64)
 		CXX_TEST(testInt64)
+		CXX_TEST(testFloat)
+		CXX_TEST(testDouble)
 		CXX_TEST(testBool)
 		CXX_TEST(testDate)
 		CXX_TEST(testDateTime)
 		CXX_TEST(testUUID)
+		CXX_TEST(testFloatLiteral)
 		CXX_TEST(testError)
 	}
 };
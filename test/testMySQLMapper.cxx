@@ -9,6 +9,10 @@ using tmplORM::mysql::add_;
 using tmplORM::mysql::update_;
 using tmplORM::mysql::del_;
 using tmplORM::mysql::deleteTable_;
+using tmplORM::mysql::bindInsertAll;
+using tmplORM::mysql::fieldLength_t;
+using tmplORM::mysql::rawUUID_t;
+using tmplORM::types::ormUUID_t;
 
 template<typename tableName, typename... fields> const char *createTable(const model_t<tableName, fields...> &) noexcept
 	{ return createTable_<tableName, fields...>::value; }
@@ -21,6 +25,8 @@ template<typename tableName, typename... fields> const char *del(const model_t<t
 	{ return del_<tableName, fields...>::value; }
 template<typename tableName, typename... fields> const char *deleteTable(const model_t<tableName, fields...> &) noexcept
 	{ return deleteTable_<tableName>::value; }
+template<typename tableName, typename... fields_t, typename query_t> void bindAll(const model_t<tableName, fields_t...> &model,
+	query_t &query) noexcept { bindInsertAll<fields_t...>::bind(model.fields(), query); }
 
 category_t category;
 supplier_t supplier;
@@ -34,6 +40,29 @@ order_t order;
 demographic_t demographic;
 customerDemographic_t customerDemographic;
 
+struct uuidKeyed_t : public model_t<ts("UUIDKeyed"),
+	types::primary_t<types::binaryUUID_t<ts("ID")>>, types::nullable_t<types::binaryUUID_t<ts("ParentID")>>,
+	types::uuid_t<ts("Token")>
+> { };
+
+// Records which bind indices got handed raw UUID bytes rather than the plain field value
+struct uuidBindRecorder_t final
+{
+	std::array<bool, 3> bound{{}};
+	std::array<bool, 3> raw{{}};
+	std::array<ormUUID_t, 3> uuids{{}};
+
+	template<typename T> void bind(const size_t index, const T &, const fieldLength_t) noexcept
+		{ bound[index] = true; }
+	void bind(const size_t index, const rawUUID_t &value, const fieldLength_t) noexcept
+	{
+		bound[index] = raw[index] = true;
+		uuids[index] = value.uuid;
+	}
+	template<typename T> void bind(const size_t index, const std::nullptr_t, const fieldLength_t) noexcept
+		{ bound[index] = true; }
+};
+
 class testMySQLMapper final : public testsuite
 {
 public:
@@ -148,6 +177,37 @@ public:
 		assertEqual(deleteTable(customerDemographic), "DROP TABLE IF EXISTS `CustomerCustDemographics`;");
 	}
 
+	void testBinaryUUIDBind()
+	{
+		uuidKeyed_t model{};
+		assertEqual(createTable(model), "CREATE TABLE IF NOT EXISTS `UUIDKeyed` (`ID` BINARY(16) PRIMARY KEY NOT NULL, "
+			"`ParentID` BINARY(16) NULL, `Token` CHAR(32) NOT NULL) CHARACTER SET utf8;");
+
+		const ormUUID_t key{0x01234567U, 0x89abU, 0xcdefU, 0x0123U, 0x456789abcdefU};
+		const ormUUID_t parent{0xfedcba98U, 0x7654U, 0x3210U, 0xfedcU, 0xba9876543210U};
+		std::get<0>(model.fields()) = key;
+		std::get<2>(model.fields()) = key;
+
+		uuidBindRecorder_t nullParent{};
+		bindAll(model, nullParent);
+		assertTrue(nullParent.bound[0] && nullParent.bound[1] && nullParent.bound[2]);
+		// A primary key binaryUUID_t must still go in as raw bytes
+		assertTrue(nullParent.raw[0]);
+		assertTrue(nullParent.uuids[0] == key);
+		assertFalse(nullParent.raw[1]);
+		// Whereas a plain UUID field is bound as its value for the hex encoding
+		assertFalse(nullParent.raw[2]);
+
+		std::get<1>(model.fields()) = parent;
+		uuidBindRecorder_t withParent{};
+		bindAll(model, withParent);
+		assertTrue(withParent.raw[0]);
+		// As must a nullable one that holds a value
+		assertTrue(withParent.raw[1]);
+		assertTrue(withParent.uuids[1] == parent);
+		assertFalse(withParent.raw[2]);
+	}
+
 	void registerTests() final
 	{
 		CXX_TEST(testCreateTableGen)
@@ -155,6 +215,7 @@ public:
 		CXX_TEST(testUpdateGen)
 		CXX_TEST(testDeleteGen)
 		CXX_TEST(testDropTableGen)
+		CXX_TEST(testBinaryUUIDBind)
 	}
 };
 
@@ -1,7 +1,9 @@
 #include <chrono>
+#include <cstring>
 // AAAAAAAAGGGGHHH.. this should be in the libpq headers, but no distro puts it where they should.
 #include <catalog/pg_type_d.h>
 #include <substrate/buffer_utils>
+#include <substrate/utility>
 #include <crunch++.h>
 #include "pgsql.hxx"
 #include "tmplORM.pgsql.hxx"
@@ -19,6 +21,7 @@ using namespace tmplORM::pgsql::driver;
 using irqus::typestring;
 using tmplORM::pgsql::fieldLength;
 using tmplORM::types::baseTypes::ormDateTime_t;
+using substrate::fixedVector_t;
 
 using systemClock_t = std::chrono::system_clock;
 #define u64(n)		UINT64_C(n)
@@ -52,6 +55,12 @@ struct type_t final
 	tmplORM::types::uuid_t<typestring<>> uuid;
 };
 
+// A model with string fields, for checking the mapper can SELECT them back out
+struct mapperEntry_t final : public tmplORM::model_t<ts("MapperTest"),
+	tmplORM::types::autoInc_t<tmplORM::types::primary_t<tmplORM::types::int32_t<ts("EntryID")>>>,
+	tmplORM::types::unicode_t<ts("Name"), 50>, tmplORM::types::nullable_t<tmplORM::types::unicodeText_t<ts("Notes")>>
+> { };
+
 static std::array<data_t, 2> testData
 {{
 	{0, "kevin", 50, {}},
@@ -67,6 +76,17 @@ static type_t typeData
 	ormUUID_t{0xbf052777, 0x89b7, 0x4ed6, 0xbc04, 0x8732d6e9364e} // 0x4e36e9d63287
 };
 
+// Stashes the result of an asynchronous query away so the test can check it once the event loop is done
+struct resultCompletion_t final : pgSQLCompletion_t
+{
+private:
+	pgSQLResult_t &target;
+
+public:
+	resultCompletion_t(pgSQLResult_t &result) noexcept : target{result} { }
+	void complete(pgSQLResult_t &result) noexcept final { target = std::move(result); }
+};
+
 class testPgSQL_t final : public testsuite
 {
 	constString_t host{}, username{}, password{};
@@ -99,6 +119,8 @@ class testPgSQL_t final : public testsuite
 		assertFalse(testClient.switchDB(nullptr));
 		assertFalse(testClient.query("").valid());
 		assertFalse(testClient.prepare("", 0).valid());
+		assertFalse(testClient.prepareNamed("", 0).valid());
+		assertEqual(testClient.preparedCount(), 0);
 		assertFalse(testClient.beginTransact());
 		assertTrue(testClient.commit());
 		assertTrue(testClient.rollback());
@@ -106,6 +128,47 @@ class testPgSQL_t final : public testsuite
 		pgSQLQuery_t testQuery{};
 		assertFalse(testQuery.valid());
 		assertFalse(testQuery.execute().valid());
+		pgSQLPipeline_t testPipeline{testClient.pipeline()};
+		assertFalse(testPipeline.valid());
+		assertFalse(testPipeline.add(testQuery));
+		assertFalse(testPipeline.execute());
+		assertEqual(testPipeline.count(), 0);
+		assertFalse(testPipeline.succeeded(0));
+		assertFalse(testPipeline[0].valid());
+		pgSQLCopyIn_t testCopy{testClient.copyIn("")};
+		assertFalse(testCopy.valid());
+		assertNull(testCopy.reserve(1));
+		assertFalse(testCopy.write("", 0));
+		assertFalse(testCopy.end());
+		constexpr static std::array<pgSQLType_t, 1> testTypes{{pgSQLType_t::int4}};
+		pgSQLCopyOut_t testCopyOut{testClient.copyOut("", testTypes.data(), testTypes.size())};
+		assertFalse(testCopyOut.valid());
+		assertFalse(testCopyOut.next());
+		assertFalse(testCopyOut.successful());
+		assertFalse(testCopyOut[0].valid());
+		pgSQLArray_t testArray{};
+		assertFalse(testArray.valid());
+		assertNull(testArray.reserve(1));
+		assertFalse(testArray.write("", 0));
+		pgSQLResultStream_t testStream{testClient.stream("")};
+		assertFalse(testStream.valid());
+		assertFalse(testStream.next());
+		assertFalse(testStream.successful());
+		assertFalse(testStream[0].valid());
+		assertTrue(testStream.begin() == testStream.end());
+		assertFalse(testQuery.stream().valid());
+		assertEqual(testClient.socket(), -1);
+		assertFalse(testClient.queryAsync("").valid());
+		assertFalse(testQuery.executeAsync().valid());
+		pgSQLAsyncQuery_t testAsync{};
+		assertFalse(testAsync.valid());
+		assertFalse(testAsync.done());
+		assertEqual(testAsync.socket(), -1);
+		assertFalse(testAsync.process());
+		pgSQLEventLoop_t testLoop{};
+		assertFalse(testLoop.add(std::move(testAsync), nullptr));
+		assertEqual(testLoop.pending(), 0);
+		assertTrue(testLoop.run());
 		pgSQLResult_t testResult{};
 		assertFalse(testResult.valid());
 		assertEqual(testResult.errorNum(), static_cast<uint32_t>(PGRES_COMMAND_OK));
@@ -161,6 +224,48 @@ class testPgSQL_t final : public testsuite
 		assertTrue(testClient.connect(host, port, username, password, "postgres"));
 		assertTrue(testClient.switchDB(nullptr));
 		assertTrue(testClient.valid());
+
+		const auto currentDB{[&]() -> std::string
+		{
+			auto result{testClient.query("SELECT current_database();")};
+			assertTrue(result.valid());
+			assertTrue(result.hasData());
+			return result[0].asString();
+		}};
+		constexpr static const char *const selectStmt{"SELECT 1;"};
+		assertTrue(testClient.switchDB("postgres"));
+		assertTrue(testClient.switchDB("postgres"));
+		const auto liveQuery{testClient.prepareNamed(selectStmt, 0)};
+		assertTrue(liveQuery.execute().successful());
+		assertEqual(testClient.preparedCount(), 1);
+		assertTrue(testClient.switchDB("template1"));
+		assertTrue(currentDB() == "template1");
+		assertEqual(testClient.preparedCount(), 0);
+		// A query prepared before the switch keeps running on its own, now parked, connection
+		assertTrue(liveQuery.execute().successful());
+		assertEqual(testClient.preparedCount(), 0);
+		// Switching back must hand back the original connection, complete with its named statements
+		assertTrue(testClient.switchDB("postgres"));
+		assertTrue(currentDB() == "postgres");
+		assertEqual(testClient.preparedCount(), 1);
+		assertTrue(liveQuery.execute().successful());
+		assertEqual(testClient.preparedCount(), 1);
+		assertTrue(testClient.prepareNamed(selectStmt, 0).execute().successful());
+		// A failed switch must leave the client on the database it was already on
+		assertFalse(testClient.switchDB("tmplORMNonExistent"));
+		assertTrue(testClient.valid());
+		assertTrue(currentDB() == "postgres");
+		// Switching mid-transaction would leave the transaction open on the parked connection, so is refused
+		assertTrue(testClient.beginTransact());
+		assertFalse(testClient.switchDB("template1"));
+		assertTrue(currentDB() == "postgres");
+		assertTrue(testClient.rollback());
+		// A query whose connection has been closed must not run on a new one, even one reusing the same PGconn
+		testClient.disconnect();
+		assertTrue(testClient.connect(host, port, username, password, "postgres"));
+		assertFalse(liveQuery.execute().valid());
+		testClient.disconnect();
+		assertFalse(testClient.valid());
 	}
 
 	void testCreateTable()
@@ -267,6 +372,82 @@ class testPgSQL_t final : public testsuite
 		fail("Exception throw while converting value");
 	}
 
+	void testPreparedNamed() try
+	{
+		assertTrue(client.valid());
+		assertEqual(client.preparedCount(), 0);
+		constexpr static const char *const updateStmt
+			{R"(UPDATE "tmplORM" SET "Value" = $1 WHERE "EntryID" = $2;)"};
+
+		for (const auto value : {int32_t{25}, testData[0].value.value()})
+		{
+			auto query{client.prepareNamed(updateStmt, 2)};
+			assertTrue(query.valid());
+			query.bind(0, value, fieldLength(testData[0].value));
+			query.bind(1, testData[0].entryID.value(), fieldLength(testData[0].entryID));
+			const auto result{query.execute()};
+			assertTrue(result.valid());
+			if (!result.successful())
+				printError(result);
+			assertTrue(result.successful());
+			assertFalse(result.hasData());
+			assertEqual(client.preparedCount(), 1);
+		}
+
+		// Rebinding a query reuses the space its values were encoded into, so exactly enough for one set is fine
+		auto query{client.prepareNamed(updateStmt, 2, sizeof(int32_t) * 2U)};
+		assertTrue(query.valid());
+		query.bind(1, testData[0].entryID.value(), fieldLength(testData[0].entryID));
+		for (const auto value : {int32_t{25}, testData[0].value.value()})
+		{
+			query.bind(0, value, fieldLength(testData[0].value));
+			const auto result{query.execute()};
+			assertTrue(result.valid());
+			if (!result.successful())
+				printError(result);
+			assertTrue(result.successful());
+			assertEqual(client.preparedCount(), 1);
+		}
+
+		// Binding NULL in between values must not cost the parameter the space its values get encoded into
+		auto echo{client.prepare("SELECT $1::INT4;", 1, sizeof(int32_t))};
+		assertTrue(echo.valid());
+		for (const auto value : {int32_t{25}, int32_t{50}})
+		{
+			echo.bind(0, value, fieldLength(testData[0].value));
+			auto result{echo.execute()};
+			assertTrue(result.valid());
+			assertTrue(result.hasData());
+			assertFalse(result[0].isNull());
+			assertEqual(result[0].asInt32(), value);
+			echo.bind<int32_t>(0, nullptr, fieldLength(testData[0].value));
+			result = echo.execute();
+			assertTrue(result.valid());
+			assertTrue(result.hasData());
+			assertTrue(result[0].isNull());
+		}
+		// A value that does not fit must fail the query rather than quietly going out as NULL
+		auto noSpace{client.prepare("SELECT $1::INT4;", 1, 0)};
+		assertTrue(noSpace.valid());
+		noSpace.bind(0, int32_t{25}, fieldLength(testData[0].value));
+		assertFalse(noSpace.valid());
+		assertFalse(noSpace.execute().valid());
+
+		auto result{client.query(R"(SELECT "name" FROM "pg_prepared_statements";)")};
+		assertTrue(result.valid());
+		if (!result.successful())
+			printError(result);
+		assertTrue(result.hasData());
+		assertEqual(result.numRows(), 1);
+		assertEqual(result[0].asString(), "tmplORM_0");
+		assertFalse(result.next());
+	}
+	catch (const pgSQLValueError_t &error)
+	{
+		puts(error.error());
+		fail("Exception thrown while converting value");
+	}
+
 	void testResult() try
 	{
 		assertTrue(client.valid());
@@ -301,6 +482,26 @@ class testPgSQL_t final : public testsuite
 		}
 		assertTrue(result[3].asDateTime() == now);
 		assertFalse(result.next());
+
+		std::array<int32_t, 2> values{};
+		std::array<bool, 2> nulls{};
+		assertTrue(result.decodeColumn(0, values.data(), values.size()));
+		assertEqual(values[0], testData[0].entryID);
+		assertEqual(values[1], testData[1].entryID);
+		// NULLs can only be decoded when there's somewhere to mark them
+		assertFalse(result.decodeColumn(2, values.data(), values.size()));
+		assertTrue(result.decodeColumn(2, values.data(), values.size(), nulls.data()));
+		assertFalse(nulls[0]);
+		assertEqual(values[0], testData[0].value);
+		assertTrue(nulls[1]);
+		assertFalse(result.decodeColumn(0, values.data(), 1));
+		std::array<int64_t, 2> wrongValues{};
+		assertFalse(result.decodeColumn(0, wrongValues.data(), wrongValues.size()));
+		assertFalse(result.decodeColumn(4, values.data(), values.size()));
+		std::array<ormDateTime_t, 2> whens{};
+		assertTrue(result.decodeColumn(3, whens.data(), whens.size()));
+		assertTrue(whens[0] == when);
+		assertTrue(whens[1] == now);
 	}
 	catch (const pgSQLValueError_t &error)
 	{
@@ -461,6 +662,385 @@ class testPgSQL_t final : public testsuite
 		fail("Exception thrown while converting value");
 	}
 
+	void testArray() try
+	{
+		assertTrue(client.valid());
+		pgSQLArray_t array{pgSQLType_t::int4, 3};
+		assertTrue(array.valid());
+		for (const int32_t value : {1, 2})
+		{
+			auto *const buffer{static_cast<uint8_t *>(array.reserve(4 + 4))};
+			assertNotNull(buffer);
+			substrate::buffer_utils::writeBE(int32_t{4}, buffer);
+			substrate::buffer_utils::writeBE(value, buffer + 4);
+		}
+		// NULL elements are a length of -1 with no data
+		auto *const null{array.reserve(4)};
+		assertNotNull(null);
+		substrate::buffer_utils::writeBE(int32_t{-1}, null);
+
+		auto query{client.prepare("SELECT unnest($1);", 1)};
+		assertTrue(query.valid());
+		query.bind(0, array);
+		auto result{query.execute()};
+		assertTrue(result.valid());
+		if (!result.successful())
+			printError(result);
+		assertTrue(result.successful());
+		assertTrue(result.hasData());
+		assertEqual(result.numRows(), 3);
+		assertEqual(int32_t{result[0]}, 1);
+		assertTrue(result.next());
+		assertEqual(int32_t{result[0]}, 2);
+		assertTrue(result.next());
+		assertTrue(result[0].isNull());
+		assertFalse(result.next());
+	}
+	catch (const pgSQLValueError_t &error)
+	{
+		puts(error.error());
+		fail("Exception thrown while converting value");
+	}
+
+	void testPipeline() try
+	{
+		assertTrue(client.valid());
+		constexpr static const char *const insertStmt
+			{R"(INSERT INTO "tmplORM" ("Name", "Value") VALUES ($1, $2) RETURNING "EntryID";)"};
+		auto pipeline{client.pipeline()};
+		assertTrue(pipeline.valid());
+
+		for (const auto &data : testData)
+		{
+			auto query{client.prepareNamed(insertStmt, 2)};
+			assertTrue(query.valid());
+			query.bind(0, data.name.value(), fieldLength(data.name));
+			if (data.value.isNull())
+				query.bind<int32_t>(1, nullptr, fieldLength(data.value));
+			else
+				query.bind(1, data.value.value(), fieldLength(data.value));
+			assertTrue(pipeline.add(query));
+		}
+		auto query{client.prepare(R"(DELETE FROM "tmplORM" WHERE "EntryID" > $1;)", 1)};
+		assertTrue(query.valid());
+		query.bind(0, testData[1].entryID.value(), fieldLength(testData[1].entryID));
+		assertTrue(pipeline.add(query));
+		assertEqual(pipeline.count(), 3);
+
+		const auto executed{pipeline.execute()};
+		if (!executed)
+			printError(client, "Pipeline");
+		assertTrue(executed);
+		assertEqual(pipeline.count(), 0);
+		for (const auto i : {0, 1, 2})
+			assertTrue(pipeline.succeeded(i));
+		assertFalse(pipeline.succeeded(3));
+		assertTrue(pipeline[0].hasData());
+		assertEqual(pipeline[0].numRows(), 1);
+		assertEqual(int32_t{pipeline[0][0]}, 3);
+		assertTrue(pipeline[1].hasData());
+		assertEqual(int32_t{pipeline[1][0]}, 4);
+		assertFalse(pipeline[2].hasData());
+
+		// The first failure in a pipeline must cause everything after it to be skipped
+		query = client.prepare(R"(INSERT INTO "tmplORM" ("EntryID", "Name") VALUES ($1, 'fail');)", 1);
+		query.bind(0, testData[0].entryID.value(), fieldLength(testData[0].entryID));
+		assertTrue(pipeline.add(query));
+		query = client.prepare(R"(DELETE FROM "tmplORM" WHERE "EntryID" >= $1;)", 1);
+		query.bind(0, testData[0].entryID.value(), fieldLength(testData[0].entryID));
+		assertTrue(pipeline.add(query));
+		assertFalse(pipeline.execute());
+		assertFalse(pipeline.succeeded(0));
+		assertFalse(pipeline.succeeded(1));
+		assertEqual(pipeline[1].errorNum(), static_cast<uint32_t>(PGRES_PIPELINE_ABORTED));
+
+		const auto result{client.query(R"(SELECT "EntryID" FROM "tmplORM";)")};
+		assertTrue(result.valid());
+		assertTrue(result.successful());
+		assertEqual(result.numRows(), 2);
+	}
+	catch (const pgSQLValueError_t &error)
+	{
+		puts(error.error());
+		fail("Exception thrown while converting value");
+	}
+
+	void testCopyIn()
+	{
+		assertTrue(client.valid());
+		constexpr static const char *const copyStmt
+			{R"(COPY "tmplORM" ("Name", "Value") FROM STDIN (FORMAT binary);)"};
+		// PGCOPY signature, flags and header extension length
+		constexpr static std::array<char, 19> header
+			{{'P', 'G', 'C', 'O', 'P', 'Y', '\n', '\xFF', '\r', '\n', '\0', 0, 0, 0, 0, 0, 0, 0, 0}};
+		constexpr static std::array<char, 5> name{{'c', 'o', 'p', 'y', '\0'}};
+
+		const auto writeRow{[&](pgSQLCopyIn_t &copy, const int32_t value)
+		{
+			auto *const buffer{static_cast<uint8_t *>(copy.reserve(2 + 4 + 4 + 4 + 4))};
+			assertNotNull(buffer);
+			substrate::buffer_utils::writeBE(int16_t{2}, buffer);
+			substrate::buffer_utils::writeBE(int32_t{4}, buffer + 2);
+			std::memcpy(buffer + 6, name.data(), 4);
+			substrate::buffer_utils::writeBE(int32_t{4}, buffer + 10);
+			substrate::buffer_utils::writeBE(value, buffer + 14);
+		}};
+
+		// A COPY that is abandoned must not leave any rows behind
+		{
+			auto copy{client.copyIn(copyStmt)};
+			assertTrue(copy.valid());
+			assertTrue(copy.write(header.data(), header.size()));
+			writeRow(copy, 0);
+		}
+
+		auto copy{client.copyIn(copyStmt)};
+		assertTrue(copy.valid());
+		assertTrue(copy.write(header.data(), header.size()));
+		// Write enough rows to need more than one chunk sending
+		constexpr int32_t rows{100000};
+		for (int32_t i{0}; i < rows; ++i)
+			writeRow(copy, i);
+		auto *const trailer{copy.reserve(2)};
+		assertNotNull(trailer);
+		substrate::buffer_utils::writeBE(int16_t{-1}, trailer);
+		const auto copied{copy.end()};
+		if (!copied)
+			printError(client, "COPY");
+		assertTrue(copied);
+		assertFalse(copy.valid());
+
+		auto result{client.query(R"(SELECT COUNT(*), SUM("Value") FROM "tmplORM" WHERE "Name" = 'copy';)")};
+		assertTrue(result.valid());
+		if (!result.successful())
+			printError(result);
+		assertTrue(result.hasData());
+		assertEqual(result.numRows(), 1);
+		assertEqual(result[0].asInt64(), rows);
+		assertEqual(result[1].asInt64(), (int64_t{rows} * (rows - 1)) / 2);
+		assertFalse(result.next());
+	}
+
+	void testCopyOut() try
+	{
+		assertTrue(client.valid());
+		constexpr static std::array<pgSQLType_t, 2> types{{pgSQLType_t::unicode, pgSQLType_t::int4}};
+		constexpr static const char *const copyStmt{R"(
+			COPY (SELECT "Name", "Value" FROM "tmplORM" WHERE "Name" = 'copy' OR "Value" IS NULL ORDER BY "Value")
+			TO STDOUT (FORMAT binary);
+		)"};
+
+		auto copy{client.copyOut(copyStmt, types.data(), types.size())};
+		assertTrue(copy.valid());
+		assertEqual(copy.numFields(), 2);
+		int32_t rows{0};
+		while (copy.next())
+		{
+			// Postgres sorts NULLs last
+			if (rows == 100000)
+			{
+				assertEqual(copy[0].asString(), testData[1].name);
+				assertTrue(copy[1].isNull());
+			}
+			else
+			{
+				assertEqual(copy[0].asString(), "copy");
+				assertEqual(copy[1].asInt32(), rows);
+			}
+			++rows;
+		}
+		assertTrue(copy.successful());
+		assertFalse(copy.valid());
+		assertEqual(rows, 100001);
+
+		// Strings from retained tuples must stay intact
+		copy = client.copyOut(copyStmt, types.data(), types.size());
+		assertTrue(copy.next());
+		const char *const first{copy[0].asString()};
+		assertTrue(copy.next(true));
+		assertEqual(first, "copy");
+		assertEqual(copy[0].asString(), "copy");
+
+		// Giving up part way through must leave the connection usable
+		copy = {};
+		assertFalse(copy.successful());
+		const auto result{client.query(R"(SELECT 1;)")};
+		assertTrue(result.valid());
+		assertTrue(result.successful());
+	}
+	catch (const pgSQLValueError_t &error)
+	{
+		puts(error.error());
+		fail("Exception thrown while converting value");
+	}
+
+	void testStream() try
+	{
+		assertTrue(client.valid());
+		auto stream{client.stream(R"(SELECT "Value" FROM "tmplORM" WHERE "Name" = 'copy' ORDER BY "Value";)")};
+		assertTrue(stream.valid());
+		assertEqual(stream.numFields(), 1);
+		int32_t rows{0};
+		for (const auto &row : stream)
+		{
+			assertEqual(row[0].asInt32(), rows);
+			++rows;
+		}
+		assertTrue(stream.successful());
+		assertFalse(stream.valid());
+		assertEqual(rows, 100000);
+
+		auto query{client.prepareNamed(R"(SELECT "Value" FROM "tmplORM" WHERE "Value" >= $1 ORDER BY "Value";)", 1)};
+		query.bind(0, int32_t{99990}, fieldLength(testData[0].value));
+		stream = query.stream();
+		rows = 99990;
+		while (stream.valid())
+		{
+			assertEqual(stream[0].asInt32(), rows);
+			++rows;
+			stream.next();
+		}
+		assertTrue(stream.successful());
+		assertEqual(rows, 100000);
+
+		stream = client.stream(R"(SELECT "Nonexistent" FROM "tmplORM";)");
+		assertFalse(stream.valid());
+		assertFalse(stream.successful());
+		assertNotNull(stream.error());
+
+		// Giving up part way through must leave the connection usable
+		stream = client.stream(R"(SELECT "Value" FROM "tmplORM" WHERE "Name" = 'copy';)");
+		assertTrue(stream.valid());
+		assertTrue(stream.next());
+		stream = {};
+		assertFalse(stream.successful());
+		const auto result{client.query(R"(SELECT 1;)")};
+		assertTrue(result.valid());
+		assertTrue(result.successful());
+	}
+	catch (const pgSQLValueError_t &error)
+	{
+		puts(error.error());
+		fail("Exception thrown while converting value");
+	}
+
+	void testAsync() try
+	{
+		assertTrue(client.valid());
+		assertNotEqual(client.socket(), -1);
+		pgSQLClient_t otherClient{};
+		assertTrue(otherClient.connect(host, port, username, password, "tmplORM"));
+		pgSQLEventLoop_t loop{};
+		std::array<pgSQLResult_t, 2> results{};
+
+		auto query{client.queryAsync(R"(SELECT pg_sleep(0.1), 1::int4;)")};
+		assertTrue(query.valid());
+		assertEqual(query.socket(), client.socket());
+		// Only one query can be in flight on a connection at a time
+		assertFalse(client.queryAsync(R"(SELECT 1;)").valid());
+		assertTrue(loop.add(std::move(query), substrate::make_unique_nothrow<resultCompletion_t>(results[0])));
+		auto prepared{otherClient.prepare(R"(SELECT "Value" FROM "tmplORM" WHERE "Value" = $1;)", 1)};
+		prepared.bind(0, int32_t{1234}, fieldLength(testData[0].value));
+		assertTrue(loop.add(prepared.executeAsync(), substrate::make_unique_nothrow<resultCompletion_t>(results[1])));
+		assertEqual(loop.pending(), 2);
+		assertTrue(loop.run());
+		assertEqual(loop.pending(), 0);
+		for (const auto &result : results)
+		{
+			assertTrue(result.valid());
+			assertTrue(result.hasData());
+			assertEqual(result.numRows(), 1);
+		}
+		assertEqual(results[0][1].asInt32(), 1);
+		assertEqual(results[1][0].asInt32(), 1234);
+
+		// Errors come back through the result, just as they do for blocking queries
+		query = client.queryAsync(R"(SELECT "Nonexistent" FROM "tmplORM";)");
+		assertTrue(loop.add(std::move(query), substrate::make_unique_nothrow<resultCompletion_t>(results[0])));
+		assertTrue(loop.run());
+		assertTrue(results[0].valid());
+		assertFalse(results[0].successful());
+		assertNotNull(results[0].error());
+
+		// Giving up on a query in flight must leave the connection usable
+		query = client.queryAsync(R"(SELECT pg_sleep(10);)");
+		assertTrue(query.valid());
+		query = {};
+		const auto result{client.query(R"(SELECT 1;)")};
+		assertTrue(result.valid());
+		assertTrue(result.successful());
+	}
+	catch (const pgSQLValueError_t &error)
+	{
+		puts(error.error());
+		fail("Exception thrown while converting value");
+	}
+
+	void checkMapperEntry(const mapperEntry_t &entry)
+	{
+		const auto &name{std::get<1>(entry.fields())};
+		const auto &notes{std::get<2>(entry.fields())};
+		assertNotNull(name.value());
+		if (strcmp(name.value(), "kevin") == 0)
+		{
+			assertFalse(notes.isNull());
+			assertEqual(notes.value(), "Has some notes");
+		}
+		else
+		{
+			assertEqual(name.value(), "dave");
+			assertTrue(notes.isNull());
+		}
+	}
+
+	void checkMapperEntries(const fixedVector_t<mapperEntry_t> &entries)
+	{
+		assertTrue(entries.valid());
+		assertEqual(entries.count(), 2);
+		for (size_t i{0}; i < entries.count(); ++i)
+			checkMapperEntry(entries.data()[i]);
+	}
+
+	void testMapperSelect()
+	{
+		tmplORM::pgsql_t session{};
+		assertTrue(session.connect(host, port, username, password, "tmplORM"));
+		mapperEntry_t entry{};
+		assertTrue(session.createTable(entry));
+		std::get<1>(entry.fields()) = "kevin";
+		std::get<2>(entry.fields()) = "Has some notes";
+		assertTrue(session.add(entry));
+		std::get<1>(entry.fields()) = "dave";
+		std::get<2>(entry.fields()) = nullptr;
+		assertTrue(session.add(entry));
+
+		// The string fields must outlive the results they were decoded from
+		checkMapperEntries(session.select<mapperEntry_t>(entry));
+
+		pgSQLEventLoop_t loop{};
+		bool selected{false};
+		assertTrue(session.selectAsync<mapperEntry_t>(loop, [&](fixedVector_t<mapperEntry_t> &&entries)
+		{
+			checkMapperEntries(entries);
+			selected = true;
+		}));
+		assertTrue(loop.run());
+		assertTrue(selected);
+
+		size_t count{0};
+		auto cursor{session.cursor<mapperEntry_t>(1)};
+		assertTrue(cursor.valid());
+		for (const auto &chunk : cursor)
+		{
+			assertEqual(chunk.count(), 1);
+			checkMapperEntry(chunk.data()[0]);
+			++count;
+		}
+		assertTrue(cursor.successful());
+		assertEqual(count, 2);
+		assertTrue(session.deleteTable(entry));
+	}
+
 	void testDestroyDB()
 	{
 		assertTrue(client.valid());
@@ -496,9 +1076,17 @@ public:
 		CXX_TEST(testSwitchDB)
 		CXX_TEST(testCreateTable)
 		CXX_TEST(testPrepared)
+		CXX_TEST(testPreparedNamed)
 		CXX_TEST(testResult)
 		CXX_TEST(testTransact)
 		CXX_TEST(testBind)
+		CXX_TEST(testArray)
+		CXX_TEST(testPipeline)
+		CXX_TEST(testCopyIn)
+		CXX_TEST(testCopyOut)
+		CXX_TEST(testStream)
+		CXX_TEST(testAsync)
+		CXX_TEST(testMapperSelect)
 		CXX_TEST(testDestroyDB)
 		CXX_TEST(testDisconnect)
 	}
@@ -509,6 +1097,8 @@ class testPgSQLValue_t final : public testsuite
 private:
 	constexpr static int32_t jan1st2000{0};
 	constexpr static int32_t feb1st2022{8067};
+	constexpr static int32_t dec31st1999{-1};
+	constexpr static int32_t feb29th1600{-146038};
 
 	template<typename T> void checkValue(const T &var, const T &expected)
 		{ assertEqual(var, expected); }
@@ -713,6 +1303,10 @@ private:
 		tryOk<ormDate_t>({dateBuffer.data(), DATEOID}, {2000, 1, 1});
 		substrate::buffer_utils::writeBE(feb1st2022, dateBuffer.data());
 		tryOk<ormDate_t>({dateBuffer.data(), DATEOID}, {2022, 2, 1});
+		substrate::buffer_utils::writeBE(dec31st1999, dateBuffer.data());
+		tryOk<ormDate_t>({dateBuffer.data(), DATEOID}, {1999, 12, 31});
+		substrate::buffer_utils::writeBE(feb29th1600, dateBuffer.data());
+		tryOk<ormDate_t>({dateBuffer.data(), DATEOID}, {1600, 2, 29});
 	}
 
 	void testDateTime()
@@ -723,6 +1317,37 @@ private:
 		tryIsNull<ormDateTime_t>({nullptr});
 		substrate::buffer_utils::writeBE(jan1st2000Midday, dateTimeBuffer.data());
 		tryOk<ormDateTime_t>({dateTimeBuffer.data(), TIMESTAMPOID}, {2000, 1, 1, 12, 0, 0, 0});
+		// Times before the epoch must still come out on the right day
+		substrate::buffer_utils::writeBE(int64_t{-1}, dateTimeBuffer.data());
+		tryOk<ormDateTime_t>({dateTimeBuffer.data(), TIMESTAMPOID}, {1999, 12, 31, 23, 59, 59, 999999000});
+	}
+
+	void testDecodeDates()
+	{
+		// Enough values that the batch decoders have to go round more than once
+		std::array<int32_t, 300> rawDates{};
+		std::array<int64_t, 300> rawDateTimes{};
+		for (size_t i{0}; i < rawDates.size(); ++i)
+		{
+			const auto date{feb1st2022 + static_cast<int32_t>(i)};
+			substrate::buffer_utils::writeBE(date, rawDates.data() + i);
+			substrate::buffer_utils::writeBE(int64_t{date} * usPerDay + (12 * usPerHour), rawDateTimes.data() + i);
+		}
+
+		std::array<ormDate_t, 300> dates{};
+		std::array<ormDateTime_t, 300> dateTimes{};
+		decodeDates(rawDates.data(), dates.data(), dates.size());
+		decodeDateTimes(rawDateTimes.data(), dateTimes.data(), dateTimes.size());
+		for (size_t i{0}; i < dates.size(); ++i)
+		{
+			const pgSQLValue_t date{reinterpret_cast<const char *>(rawDates.data() + i), DATEOID};
+			checkValue(dates[i], date.asDate());
+			const pgSQLValue_t dateTime{reinterpret_cast<const char *>(rawDateTimes.data() + i), TIMESTAMPOID};
+			checkValue(dateTimes[i], dateTime.asDateTime());
+		}
+		checkValue(dates[0], {2022, 2, 1});
+		checkValue(dates[299], {2022, 11, 27});
+		checkValue(dateTimes[299], {2022, 11, 27, 12, 0, 0, 0});
 	}
 
 public:
@@ -736,6 +1361,7 @@ public:
 		CXX_TEST(testInt16)
 		CXX_TEST(testDate)
 		CXX_TEST(testDateTime)
+		CXX_TEST(testDecodeDates)
 	}
 };
 
@@ -157,12 +157,18 @@ inline namespace common
 	template<typename fieldName> fieldLength_t fieldLength(const unicodeText_t<fieldName> &field) noexcept
 		{ return {field.length(), 0}; }
 
+	// Gives the value to bind for a field, by the field's unwrapped type - engines specialise this for fields they store differently
+	template<typename field_t> struct bindValue_t
+		{ template<typename T> static const T &value(const T &value) noexcept { return value; } };
+	template<typename field_t, typename T> auto bindValue(const T &value) noexcept ->
+		decltype(bindValue_t<unwrapField<field_t>>::value(value)) { return bindValue_t<unwrapField<field_t>>::value(value); }
+
 	template<size_t bindIndex, typename field_t, bool = field_t::nullable> struct bindField_t;
 
 	template<size_t bindIndex, typename field_t> struct bindField_t<bindIndex, field_t, false>
 	{
 		template<typename query_t> static void bind(const field_t &field, query_t &query) noexcept
-			{ query.bind(bindIndex, field.value(), fieldLength(field)); }
+			{ query.bind(bindIndex, bindValue<field_t>(field.value()), fieldLength(field)); }
 	};
 
 	template<size_t bindIndex, typename field_t> struct bindField_t<bindIndex, field_t, true>
@@ -173,7 +179,7 @@ inline namespace common
 			if (field.isNull())
 				query.template bind<value_t>(bindIndex, nullptr, fieldLength(field_t{}));
 			else
-				query.bind(bindIndex, field.value(), fieldLength(field));
+				query.bind(bindIndex, bindValue<field_t>(field.value()), fieldLength(field));
 		}
 	};
 
@@ -45,6 +45,24 @@ namespace tmplORM
 		// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
 		template<char... C> const char toString<typestring<C...>>::value[sizeof...(C) + 1] = {C..., '\0'};
 
+		template<bool...> struct boolPack_t { };
+		// True if every one of the bools given is true, without recursing once per bool as a constexpr function would
+		template<bool... values> using allOf = std::is_same<boolPack_t<true, values...>, boolPack_t<values..., true>>;
+
+		// As toString, but for the UTF-16 form of the string that APIs such as ODBC's wide-character functions take.
+		// This also accepts a toString<> so the query aliases built on it can be reused as they are.
+		template<typename> struct toString16 { };
+		template<char... C> struct toString16<typestring<C...>>
+		{
+			// Every ASCII character is a single UTF-16 code unit of the same value, so this is a straight widening
+			static_assert(allOf<(uint8_t(C) < 0x80U)...>::value, "toString16<> only supports ASCII strings");
+			// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+			static const char16_t value[sizeof...(C) + 1];
+		};
+		// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+		template<char... C> const char16_t toString16<typestring<C...>>::value[sizeof...(C) + 1] = {char16_t(C)..., u'\0'};
+		template<char... C> struct toString16<toString<typestring<C...>>> : toString16<typestring<C...>> { };
+
 	}
 	using common::fieldIndex;
 	using common::fieldType;
@@ -558,6 +576,32 @@ namespace tmplORM
 				{ _value ? value(ormUUID_t{_value}) : value(ormUUID_t{}); }
 		};
 
+		// Encodes as the raw 16 big-endian bytes of the UUID on engines without a native UUID type (BINARY(16) for MySQL)
+		template<typename _fieldName> struct binaryUUID_t : public uuid_t<_fieldName>
+		{
+		private:
+			using parentType_t = uuid_t<_fieldName>;
+
+		public:
+			using type = typename parentType_t::type;
+			using parentType_t::operator =;
+			using parentType_t::value;
+			using parentType_t::operator type;
+			using parentType_t::operator ==;
+			using parentType_t::operator !=;
+
+			constexpr binaryUUID_t() noexcept : parentType_t{} { }
+			binaryUUID_t(const ormUUID_t _value) noexcept : parentType_t{_value} { }
+		};
+
+		// Strips the tag types off a field to get at the field type that decides how it is stored
+		template<typename T> struct unwrapField_t { using type = T; };
+		template<typename T> struct unwrapField_t<autoInc_t<T>> : unwrapField_t<T> { };
+		template<typename T> struct unwrapField_t<primary_t<T>> : unwrapField_t<T> { };
+		template<typename name, typename T> struct unwrapField_t<alias_t<name, T>> : unwrapField_t<T> { };
+		template<typename T> struct unwrapField_t<nullable_t<T>> : unwrapField_t<T> { };
+		template<typename T> using unwrapField = typename unwrapField_t<T>::type;
+
 		template<typename _fieldName, size_t _length> struct bitset_t : public type_t<_fieldName, std::bitset<_length>>
 		{
 		private:
@@ -29,6 +29,8 @@ namespace tmplORM
 		using tmplORM::types::type_t;
 		using tmplORM::types::unicode_t;
 		using tmplORM::types::unicodeText_t;
+		using tmplORM::types::binaryUUID_t;
+		using tmplORM::types::unwrapField;
 
 		using tmplORM::types::primary_t;
 		using tmplORM::types::autoInc_t;
@@ -93,23 +95,19 @@ namespace tmplORM
 
 			template<bool> struct bindValue_t
 			{
-				template<typename T> void *operator ()(const T &value, managedPtr_t<void> &paramStorage) const noexcept
-				{
-					paramStorage = substrate::make_managed_nothrow<T>(value);
-					return paramStorage.get();
-				}
+				// Converts values into the forms ODBC takes them in, where those differ from how we store them
+				template<typename T> static const T &convert(const T &value) noexcept { return value; }
 
-				void *operator ()(const ormDate_t &value, managedPtr_t<void> &paramStorage) const noexcept
+				static SQL_DATE_STRUCT convert(const ormDate_t &value) noexcept
 				{
 					SQL_DATE_STRUCT date;
 					date.year = value.year();
 					date.month = value.month();
 					date.day = value.day();
-					paramStorage = substrate::make_managed_nothrow<SQL_DATE_STRUCT>(date);
-					return paramStorage.get();
+					return date;
 				}
 
-				void *operator ()(const ormDateTime_t &value, managedPtr_t<void> &paramStorage) const noexcept
+				static SQL_TIMESTAMP_STRUCT convert(const ormDateTime_t &value) noexcept
 				{
 					SQL_TIMESTAMP_STRUCT dateTime;
 					dateTime.year = value.year();
@@ -121,27 +119,43 @@ namespace tmplORM
 					// The documentation tells us that this field is in ns, so..
 					dateTime.fraction = value.nanoSecond() / 100;
 					dateTime.fraction *= 100; // This is here to fix the accuracy for the server
-
-					paramStorage = substrate::make_managed_nothrow<SQL_TIMESTAMP_STRUCT>(dateTime);
-					return paramStorage.get();
+					return dateTime;
 				}
 
-				void *operator ()(const ormUUID_t &value, managedPtr_t<void> &paramStorage) const noexcept
+				static SQLGUID convert(const ormUUID_t &value) noexcept
 				{
 					SQLGUID guid{};
 					memcpy(&guid, value.asPointer(), sizeof(guid_t));
 					swapBytes(guid.Data1);
 					swapBytes(guid.Data2);
 					swapBytes(guid.Data3);
-					paramStorage = substrate::make_managed_nothrow<SQLGUID>(guid);
+					return guid;
+				}
+
+				template<typename T> void *operator ()(const T &value, managedPtr_t<void> &paramStorage) const noexcept
+				{
+					using odbcType_t = typename std::decay<decltype(convert(value))>::type;
+					paramStorage = substrate::make_managed_nothrow<odbcType_t>(convert(value));
 					return paramStorage.get();
 				}
+
+				template<typename T> static size_t length(const T &value, const size_t) noexcept
+					{ return sizeof(convert(value)); }
+				template<typename T> static void copy(const T &value, const size_t length, void *const buffer) noexcept
+				{
+					const auto &odbcValue{convert(value)};
+					memcpy(buffer, &odbcValue, length);
+				}
 			};
 
 			template<> struct bindValue_t<true>
 			{
 				template<typename T> void *operator ()(const T *const val, managedPtr_t<void> &) const noexcept
 					{ return const_cast<T *>(val); } // NOLINT(cppcoreguidelines-pro-type-const-cast)
+
+				template<typename T> static size_t length(const T *const, const size_t length) noexcept { return length; }
+				template<typename T> static void copy(const T *const value, const size_t length, void *const buffer) noexcept
+					{ memcpy(buffer, value, length); }
 			};
 
 			template<typename T> using bindValue = bindValue_t<std::is_pointer<T>::value>;
@@ -164,11 +178,13 @@ namespace tmplORM
 			template<typename T> void tSQLQuery_t::bind(const size_t index, const T &value,
 				const fieldLength_t length) noexcept
 			{
+				if (paramColumns.valid())
+					return bindSet(index, value, length);
 				const int16_t dataType = bind_t<T>::typeC;
 				const int16_t odbcDataType = bind_t<T>::typeODBC;
 				const uint32_t dataLen = length.first ? length.first : bindLength_t<T>::length;
 
-				long *lenPtr = dataType == SQL_C_BINARY ? &dataLengths[index] : nullptr;
+				sql_len_t *lenPtr = dataType == SQL_C_BINARY ? &dataLengths[index] : nullptr;
 				if (dataType == SQL_C_BINARY)
 					dataLengths[index] = dataLen;
 
@@ -182,10 +198,30 @@ namespace tmplORM
 			{
 				const int16_t dataType = bind_t<T>::typeC;
 				const int16_t odbcDataType = bind_t<T>::typeODBC;
+				if (paramColumns.valid())
+				{
+					auto *const column{paramSetColumn(index, dataType, odbcDataType, length.second, 0, 1)};
+					if (column)
+						column->lengths.data()[currentSet] = SQL_NULL_DATA;
+					return;
+				}
 				dataLengths[index] = SQL_NULL_DATA;
 				error(SQLBindParameter(queryHandle, index + 1, SQL_PARAM_INPUT, dataType, odbcDataType, length.second,
 					0, nullptr, 0, &dataLengths[index]));
 			}
+
+			// Copies a value into the current parameter set's slot in the parameter's column-wise storage
+			template<typename T> void tSQLQuery_t::bindSet(const size_t index, const T &value,
+				const fieldLength_t length) noexcept
+			{
+				const auto dataLength{bindValue<T>::length(value, length.first)};
+				auto *const column{paramSetColumn(index, bind_t<T>::typeC, bind_t<T>::typeODBC,
+					bindDigits<T>(length.second), bindScale<T>(), dataLength)};
+				if (!column)
+					return;
+				column->lengths.data()[currentSet] = static_cast<sql_len_t>(dataLength);
+				bindValue<T>::copy(value, dataLength, column->data.data() + (currentSet * column->width));
+			}
 		} // namespace driver
 
 		/*! @brief Adds brackets around a field or table name */
@@ -256,6 +292,10 @@ namespace tmplORM
 		template<typename tableName, typename... fields> using add_ = toString<
 			tycat<ts("INSERT INTO "), bracket<tableName>, ts(" ("), insertList<fields...>, ts(")"), outputInsert<fields...>, ts(" VALUES ("), placeholder<countInsert_t<fields...>::count>, ts(");")>
 		>;
+		// As add_, but without the OUTPUT clause, for inserting many rows in one go with parameter sets
+		template<typename tableName, typename... fields> using addMany_ = toString<
+			tycat<ts("INSERT INTO "), bracket<tableName>, ts(" ("), insertList<fields...>, ts(") VALUES ("), placeholder<countInsert_t<fields...>::count>, ts(");")>
+		>;
 		template<typename tableName, typename... fields> using addAll_ = toString<
 			tycat<ts("INSERT INTO "), bracket<tableName>, ts(" ("), insertAllList<fields...>, ts(") VALUES ("), placeholder<sizeof...(fields)>, ts(");")>
 		>;
@@ -274,6 +314,48 @@ namespace tmplORM
 		private:
 			driver::tSQLClient_t database;
 
+			// Binds each model in the range as one parameter set of the query, and runs them all in one SQLExecute()
+			template<typename bind_t, typename range_t> bool executeSets(const char16_t *const statement,
+				const size_t paramsCount, const range_t &models) noexcept
+			{
+				const auto count{static_cast<size_t>(std::distance(std::begin(models), std::end(models)))};
+				if (!count)
+					return true;
+				auto query{database.prepareCached(statement, paramsCount)};
+				if (!query.valid() || !query.paramSets(count))
+					return false;
+				size_t set{0};
+				for (const auto &model : models)
+				{
+					query.paramSet(set++);
+					bind_t::bind(model.fields(), query);
+				}
+				if (!query.execute().valid())
+					return false;
+				for (set = 0; set < count; ++set)
+				{
+					if (!query.paramSetSucceeded(set))
+						return false;
+				}
+				return true;
+			}
+
+			template<typename range_t, typename tableName, typename... fields_t>
+				bool addModels(const range_t &models, const model_t<tableName, fields_t...> *) noexcept
+			{
+				using insert = addMany_<tableName, fields_t...>;
+				return executeSets<bindInsert<fields_t...>>(toString16<insert>::value, countInsert_t<fields_t...>::count, models);
+			}
+
+			template<typename range_t, typename tableName, typename... fields_t>
+				bool updateModels(const range_t &models, const model_t<tableName, fields_t...> *) noexcept
+			{
+				using update = update_<tableName, fields_t...>;
+				if (std::is_same<update, toString<typestring<>>>::value)
+					return false;
+				return executeSets<bindUpdate<fields_t...>>(toString16<update>::value, sizeof...(fields_t), models);
+			}
+
 		public:
 			session_t() noexcept = default;
 			~session_t() noexcept = default;
@@ -283,14 +365,14 @@ namespace tmplORM
 			template<typename tableName, typename... fields> bool createTable(const model_t<tableName, fields...> &)
 			{
 				using create = createTable_<tableName, fields...>;
-				return database.query(create::value).valid();
+				return database.query(toString16<create>::value).valid();
 			}
 
 			template<typename T, typename tableName, typename... fields_t> fixedVector_t<T>
 				select(const model_t<tableName, fields_t...> &) noexcept
 			{
 				using select = select_<tableName, fields_t...>;
-				auto result{database.query(select::value)};
+				auto result{database.query(toString16<select>::value)};
 				fixedVector_t<T> data{result.numRows()};
 				if (!data.valid())
 					return {};
@@ -328,7 +410,7 @@ namespace tmplORM
 			template<typename tableName, typename... fields_t> bool add(model_t<tableName, fields_t...> &model) noexcept
 			{
 				using insert = add_<tableName, fields_t...>;
-				auto query{database.prepare(insert::value, countInsert_t<fields_t...>::count)};
+				auto query{database.prepareCached(toString16<insert>::value, countInsert_t<fields_t...>::count)};
 				bindInsert<fields_t...>::bind(model.fields(), query);
 				auto result(query.execute());
 				if (result.valid())
@@ -342,7 +424,7 @@ namespace tmplORM
 			template<typename tableName, typename... fields_t> bool add(const model_t<tableName, fields_t...> &model) noexcept
 			{
 				using insert = addAll_<tableName, fields_t...>;
-				auto query{database.prepare(insert::value, sizeof...(fields_t))};
+				auto query{database.prepareCached(toString16<insert>::value, sizeof...(fields_t))};
 				// This binds the fields in order so we insert a value for every column.
 				bindInsertAll<fields_t...>::bind(model.fields(), query);
 				// This either works or doesn't.. thankfully.. so, we can just execute-and-quit.
@@ -354,17 +436,32 @@ namespace tmplORM
 				using update = update_<tableName, fields_t...>;
 				if (std::is_same<update, toString<typestring<>>>::value)
 					return false;
-				auto query{database.prepare(update::value, sizeof...(fields_t))};
+				auto query{database.prepareCached(toString16<update>::value, sizeof...(fields_t))};
 				// This binds the fields, primary key last so it tags to the WHERE clause for this query.
 				bindUpdate<fields_t...>::bind(model.fields(), query);
 				// This either works or doesn't.. thankfully.. so, we can just execute-and-quit.
 				return query.execute().valid();
 			}
 
+			// Inserts every model in a range with a single execution of the INSERT, binding each model as one
+			// parameter set. Unlike add(), this does not read back auto-increment fields
+			template<typename range_t> bool addAll(const range_t &models) noexcept
+			{
+				using modelPtr_t = decltype(&*std::begin(models));
+				return addModels(models, static_cast<modelPtr_t>(nullptr));
+			}
+
+			// Updates every model in a range with a single execution of the UPDATE, as addAll() does for inserts
+			template<typename range_t> bool updateAll(const range_t &models) noexcept
+			{
+				using modelPtr_t = decltype(&*std::begin(models));
+				return updateModels(models, static_cast<modelPtr_t>(nullptr));
+			}
+
 			template<typename tableName, typename... fields_t> bool del(const model_t<tableName, fields_t...> &model) noexcept
 			{
 				using del = del_<tableName, fields_t...>;
-				auto query{database.prepare(del::value, countPrimary<fields_t...>::count)};
+				auto query{database.prepareCached(toString16<del>::value, countPrimary<fields_t...>::count)};
 				// This binds the primary key fields only, in the order they're given in the WHERE clause for this query.
 				bindDelete<fields_t...>::bind(model.fields(), query);
 				// This either works or doesn't.. thankfully.. so, we can just execute-and-quit.
@@ -375,7 +472,7 @@ namespace tmplORM
 			{
 				// tycat<> builds up the query for dropping (deleting) the table
 				using drop = deleteTable_<tableName>;
-				return database.query(drop::value).valid();
+				return database.query(toString16<drop>::value).valid();
 			}
 
 			bool connect(const char *const driver, const char *const host, const uint32_t port, const char *const user, const char *const passwd) const noexcept
@@ -2,6 +2,7 @@
 #define tmplORM_MYSQL_HXX
 
 #include "tmplORM.hxx"
+#include <cinttypes>
 #include <type_traits>
 #include <memory>
 #include "mysql.hxx"
@@ -19,6 +20,8 @@ namespace tmplORM
 		using tmplORM::types::type_t;
 		using tmplORM::types::unicode_t;
 		using tmplORM::types::unicodeText_t;
+		using tmplORM::types::binaryUUID_t;
+		using tmplORM::types::unwrapField;
 
 		using tmplORM::types::primary_t;
 		using tmplORM::types::autoInc_t;
@@ -44,6 +47,9 @@ namespace tmplORM
 		template<> struct stringType_t<ormUUID_t> { using value = ts("CHAR(32)"); };
 		template<typename T> using stringType = typename stringType_t<T>::value;
 
+		// A UUID to be bound as the 16 raw big-endian bytes a BINARY(16) field holds rather than as hex digits
+		struct rawUUID_t final { ormUUID_t uuid; };
+
 		template<typename> struct bind_t { };
 		template<> struct bind_t<int8_t> { constexpr static const mySQLFieldType_t value = MYSQL_TYPE_TINY; };
 		template<> struct bind_t<int16_t> { constexpr static const mySQLFieldType_t value = MYSQL_TYPE_SHORT; };
@@ -59,6 +65,7 @@ namespace tmplORM
 		template<> struct bind_t<ormDate_t> { constexpr static const mySQLFieldType_t value = MYSQL_TYPE_DATE; };
 		template<> struct bind_t<ormDateTime_t> { constexpr static const mySQLFieldType_t value = MYSQL_TYPE_DATETIME; };
 		template<> struct bind_t<ormUUID_t> { constexpr static const mySQLFieldType_t value = MYSQL_TYPE_STRING; };
+		template<> struct bind_t<rawUUID_t> { constexpr static const mySQLFieldType_t value = MYSQL_TYPE_BLOB; };
 		template<> struct bind_t<nullptr_t> { constexpr static const mySQLFieldType_t value = MYSQL_TYPE_NULL; };
 		template<typename T, bool = isNumeric<T>::value> struct bindType_t : public bind_t<T> { };
 		template<typename T> struct bindType_t<T, true> : public bind_t<typename std::make_signed<T>::type> { };
@@ -73,33 +80,52 @@ namespace tmplORM
 			template<typename T> typename std::enable_if<isNumeric<T>::value>::type
 				bindT(MYSQL_BIND &param) noexcept { param.is_unsigned = std::is_unsigned<T>::value; }
 
+			/*! @brief Converts a UUID into the 32 hex digit form we store UUIDs as */
+			inline std::array<char, 32> uuidToHex(const ormUUID_t &uuid) noexcept
+			{
+				std::array<uint8_t, sizeof(guid_t)> value{};
+				memcpy(value.data(), uuid.asPointer(), value.size());
+				std::array<char, 32> result{};
+				for (uint8_t i = 0; i < result.size(); ++i)
+				{
+					// Computes a shift of 4 for the first nibble, and 0 for the second
+					const uint8_t shift = 4U >> ((i & 1U) << 2U);
+					// This then extracts the correct nibble of the current byte to convert. It acomplishes
+					// this by performing a shift to get the correct nibble into the bottom nibble of the byte
+					// and then masking off that nibble
+					char hex = uint8_t(value[i >> 1U] >> shift) & 0x0FU;
+					if (hex > 9)
+						hex += 0x07;
+					result[i] = hex + 0x30;
+				}
+				return result;
+			}
+
 			template<bool> struct bindValueIn_t
 			{
 				using nanoseconds_t = std::chrono::nanoseconds;
 
-				template<typename T> bool operator ()(MYSQL_BIND &param, const T &value, managedPtr_t<void> &) noexcept
+				template<typename T> bool operator ()(MYSQL_BIND &param, const T &value, mySQLParamStorage_t &) noexcept
 					{ param.buffer = const_cast<T *>(&value); return true; }
 
-				bool operator ()(MYSQL_BIND &param, const ormDate_t &value, managedPtr_t<void> &paramStorage) noexcept
+				bool operator ()(MYSQL_BIND &param, const ormDate_t &value, mySQLParamStorage_t &paramStorage) noexcept
 				{
-					MYSQL_TIME date{};
+					MYSQL_TIME &date = paramStorage.dateTime;
+					date = {};
 					date.year = value.year();
 					date.month = value.month();
 					date.day = value.day();
 					date.time_type = MYSQL_TIMESTAMP_DATE;
 
-					paramStorage = substrate::make_managed_nothrow<MYSQL_TIME>(date);
-					if (paramStorage.valid())
-					{
-						param.buffer = paramStorage;
-						param.buffer_length = sizeof(date);
-					}
-					return paramStorage.valid();
+					param.buffer = &date;
+					param.buffer_length = sizeof(date);
+					return true;
 				}
 
-				bool operator ()(MYSQL_BIND &param, const ormDateTime_t &value, managedPtr_t<void> &paramStorage) noexcept
+				bool operator ()(MYSQL_BIND &param, const ormDateTime_t &value, mySQLParamStorage_t &paramStorage) noexcept
 				{
-					MYSQL_TIME dateTime{};
+					MYSQL_TIME &dateTime = paramStorage.dateTime;
+					dateTime = {};
 					dateTime.year = value.year();
 					dateTime.month = value.month();
 					dateTime.day = value.day();
@@ -109,47 +135,31 @@ namespace tmplORM
 					dateTime.second_part = value.nanoSecond() / std::chrono::duration_cast<nanoseconds_t>(1_us).count();
 					dateTime.time_type = MYSQL_TIMESTAMP_DATETIME;
 
-					paramStorage = substrate::make_managed_nothrow<MYSQL_TIME>(dateTime);
-					if (paramStorage.valid())
-					{
-						param.buffer = paramStorage;
-						param.buffer_length = sizeof(dateTime);
-					}
-					return paramStorage.valid();
+					param.buffer = &dateTime;
+					param.buffer_length = sizeof(dateTime);
+					return true;
 				}
 
-				bool operator ()(MYSQL_BIND &param, const ormUUID_t &_value, managedPtr_t<void> &paramStorage) noexcept
+				bool operator ()(MYSQL_BIND &param, const ormUUID_t &value, mySQLParamStorage_t &paramStorage) noexcept
 				{
-					std::array<uint8_t, sizeof(guid_t)> value{};
-					memcpy(value.data(), _value.asPointer(), value.size());
-					std::array<char, 32> uuid{};
-					for (uint8_t i = 0; i < uuid.size(); ++i)
-					{
-						// Computes a shift of 4 for the first nibble, and 0 for the second
-						const uint8_t shift = 4U >> ((i & 1U) << 2U);
-						// This then extracts the correct nibble of the current byte to convert. It acomplishes
-						// this by performing a shift to get the correct nibble into the bottom nibble of the byte
-						// and then masking off that nibble
-						char hex = uint8_t(value[i >> 1U] >> shift) & 0x0FU;
-						if (hex > 9)
-							hex += 0x07;
-						uuid[i] = hex + 0x30;
-					}
-
-					auto storage = substrate::make_managed_nothrow<decltype(uuid)>(uuid);
-					if (storage.valid())
-					{
-						param.buffer = storage->data();
-						param.buffer_length = uuid.size();
-						paramStorage = std::move(storage);
-					}
-					return storage.valid();
+					paramStorage.uuid = uuidToHex(value);
+					param.buffer = paramStorage.uuid.data();
+					param.buffer_length = paramStorage.uuid.size();
+					return true;
+				}
+
+				bool operator ()(MYSQL_BIND &param, const rawUUID_t &value, mySQLParamStorage_t &paramStorage) noexcept
+				{
+					memcpy(paramStorage.uuid.data(), value.uuid.asPointer(), sizeof(guid_t));
+					param.buffer = paramStorage.uuid.data();
+					param.buffer_length = sizeof(guid_t);
+					return true;
 				}
 			};
 
 			template<> struct bindValueIn_t<true>
 			{
-				template<typename T> bool operator ()(MYSQL_BIND &param, const T *const value, managedPtr_t<void> &) noexcept
+				template<typename T> bool operator ()(MYSQL_BIND &param, const T *const value, mySQLParamStorage_t &) noexcept
 					{ param.buffer = const_cast<T *>(value); return true; }
 			};
 
@@ -179,38 +189,24 @@ namespace tmplORM
 			}
 
 			template<typename value_t> struct bindOutStorage_t
-			{
-				constexpr uint32_t length() const noexcept { return sizeof(value_t); }
-				managedPtr_t<void> operator ()() const noexcept { return substrate::make_managed_nothrow<value_t>(); }
-			};
-
+				{ constexpr uint32_t length() const noexcept { return sizeof(value_t); } };
 			template<> struct bindOutStorage_t<ormDate_t>
-			{
-				constexpr uint32_t length() const noexcept { return sizeof(MYSQL_TIME); }
-				managedPtr_t<void> operator ()() const noexcept { return substrate::make_managed_nothrow<MYSQL_TIME>(); }
-			};
-
+				{ constexpr uint32_t length() const noexcept { return sizeof(MYSQL_TIME); } };
 			template<> struct bindOutStorage_t<ormDateTime_t>
-			{
-				constexpr uint32_t length() const noexcept { return sizeof(MYSQL_TIME); }
-				managedPtr_t<void> operator ()() const noexcept { return substrate::make_managed_nothrow<MYSQL_TIME>(); }
-			};
-
+				{ constexpr uint32_t length() const noexcept { return sizeof(MYSQL_TIME); } };
 			/*template<> struct bindOutStorage_t<ormUUID_t>
-			{
-				constexpr uint32_t length() const noexcept { return 32; }
-				managedPtr_t<void> operator ()() const noexcept { return substrate::make_managed_nothrow<char []>(32); }
-			};*/
+				{ constexpr uint32_t length() const noexcept { return 32; } };*/
 
 			template<typename T> struct bindValueOut_t
 			{
-				bool operator ()(MYSQL_BIND &param, managedPtr_t<void> &paramStorage) noexcept
+				static_assert(bindOutStorage_t<T>{}.length() <= sizeof(mySQLParamStorage_t),
+					"Result value type too large for the inline parameter storage");
+
+				bool operator ()(MYSQL_BIND &param, mySQLParamStorage_t &paramStorage) noexcept
 				{
-					const bindOutStorage_t<T> makeStorage{};
-					paramStorage = makeStorage();
-					if (paramStorage.valid())
-						param.buffer_length = makeStorage.length();
-					return paramStorage.valid();
+					param.buffer = &paramStorage;
+					param.buffer_length = bindOutStorage_t<T>{}.length();
+					return true;
 				}
 			};
 
@@ -226,6 +222,56 @@ namespace tmplORM
 				param.length = &param.buffer_length;
 				param.is_null = notNullParam;
 			}
+
+			// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+			using literal_t = std::unique_ptr<const char []>;
+
+			// Renders values as the SQL literals that batch statements substitute in for their placeholders
+			struct bindLiteral_t
+			{
+				template<typename T> typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, literal_t>::type
+					operator ()(const T value) const noexcept { return formatString("%" PRId64, int64_t{value}); }
+				template<typename T> typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value &&
+					!std::is_same<T, bool>::value, literal_t>::type
+					operator ()(const T value) const noexcept { return formatString("%" PRIu64, uint64_t{value}); }
+				literal_t operator ()(const bool value) const noexcept { return strNewDup(value ? "1" : "0"); }
+				literal_t operator ()(const float value) const noexcept { return floatLiteral(double{value}, 9); }
+				literal_t operator ()(const double value) const noexcept { return floatLiteral(value, 17); }
+
+				literal_t operator ()(const ormDate_t &value) const noexcept
+				{
+					return formatString("'%04d-%02u-%02u'", int{value.year()}, unsigned{value.month()},
+						unsigned{value.day()});
+				}
+
+				literal_t operator ()(const ormDateTime_t &value) const noexcept
+				{
+					using nanoseconds_t = std::chrono::nanoseconds;
+					const uint32_t microSecond = value.nanoSecond() / std::chrono::duration_cast<nanoseconds_t>(1_us).count();
+					return formatString("'%04d-%02u-%02u %02u:%02u:%02u.%06u'", int{value.year()}, unsigned{value.month()},
+						unsigned{value.day()}, unsigned{value.hour()}, unsigned{value.minute()}, unsigned{value.second()},
+						microSecond);
+				}
+
+				literal_t operator ()(const ormUUID_t &value) const noexcept
+				{
+					const std::array<char, 32> uuid = uuidToHex(value);
+					return formatString("'%.*s'", int(uuid.size()), uuid.data());
+				}
+			};
+
+			template<typename T> void mySQLBatchStatement_t::bind(const size_t index, const T &value, const fieldLength_t) noexcept
+				{ literal(index, bindLiteral_t{}(value)); }
+			template<> inline void mySQLBatchStatement_t::bind(const size_t index, const char *const &value,
+				const fieldLength_t) noexcept { quote(index, value, value ? strlen(value) : 0); }
+			template<> inline void mySQLBatchStatement_t::bind(const size_t index, const rawUUID_t &value,
+				const fieldLength_t) noexcept
+			{
+				const std::array<char, 32> uuid = uuidToHex(value.uuid);
+				literal(index, formatString("X'%.*s'", int(uuid.size()), uuid.data()));
+			}
+			template<typename T> void mySQLBatchStatement_t::bind(const size_t index, const nullptr_t, const fieldLength_t) noexcept
+				{ literal(index, strNewDup("NULL")); }
 		} // namespace driver
 
 		/*! @brief Adds backticks around a field or table name */
@@ -238,11 +284,17 @@ namespace tmplORM
 
 #include "tmplORM.common.hxx"
 
+		// BINARY(16) UUID fields, however they are tagged, get bound as their raw bytes
+		template<typename fieldName> struct bindValue_t<binaryUUID_t<fieldName>>
+			{ static rawUUID_t value(const ormUUID_t &value) noexcept { return {value}; } };
+
 		template<typename> struct createName_t { };
 		template<typename fieldName, typename T> struct createName_t<type_t<fieldName, T>>
 			{ using value = tycat<backtick<fieldName>, ts(" "), stringType<T>>; };
 		template<typename fieldName, size_t length> struct createName_t<unicode_t<fieldName, length>>
 			{ using value = tycat<backtick<fieldName>, ts(" VARCHAR("), toTypestring<length>, ts(")")>; };
+		template<typename fieldName> struct createName_t<binaryUUID_t<fieldName>>
+			{ using value = tycat<backtick<fieldName>, ts(" BINARY(16)")>; };
 
 		template<size_t N, typename field> struct createField_t
 		{
@@ -250,6 +302,8 @@ namespace tmplORM
 				typename createName_t<type_t<fieldName, T>>::value;
 			template<typename fieldName, size_t length> static auto _name(const unicode_t<fieldName, length> &) ->
 				typename createName_t<unicode_t<fieldName, length>>::value;
+			template<typename fieldName> static auto _name(const binaryUUID_t<fieldName> &) ->
+				typename createName_t<binaryUUID_t<fieldName>>::value;
 			template<typename T> static auto _name(const autoInc_t<T> &) ->
 				tycat<decltype(_name(T{})), ts(" AUTO_INCREMENT")>;
 			template<typename T> static auto _name(const primary_t<T> &) ->
@@ -294,6 +348,62 @@ namespace tmplORM
 			tycat<ts("DROP TABLE IF EXISTS "), backtick<tableName>, ts(";")>
 		>;
 
+		struct batch_t final
+		{
+		private:
+			mySQLBatch_t batch;
+
+			batch_t(mySQLBatch_t &&_batch) noexcept : batch{std::move(_batch)} { }
+			friend struct session_t;
+
+		public:
+			batch_t() noexcept = default;
+			~batch_t() noexcept = default;
+			batch_t(batch_t &&_batch) noexcept : batch{std::move(_batch.batch)} { }
+			void operator =(batch_t &&_batch) noexcept { batch = std::move(_batch.batch); }
+			bool valid() const noexcept { return batch.valid(); }
+
+			// Auto-increment fields are left for the database to generate as there is no way to get the row IDs back out of a batch
+			template<typename tableName, typename... fields_t> bool add(const model_t<tableName, fields_t...> &model)
+			{
+				using add = add_<tableName, fields_t...>;
+				mySQLBatchStatement_t statement{batch.prepare(add::value, countInsert_t<fields_t...>::count)};
+				bindInsert<fields_t...>::bind(model.fields(), statement);
+				return batch.add(statement);
+			}
+
+			template<typename tableName, typename... fields_t> bool update(const model_t<tableName, fields_t...> &model)
+			{
+				using update = update_<tableName, fields_t...>;
+				if (std::is_same<update, toString<typestring<>>>::value)
+					return false;
+				mySQLBatchStatement_t statement{batch.prepare(update::value, sizeof...(fields_t))};
+				// This binds the fields, primary key last so it tags to the WHERE clause for the statement.
+				bindUpdate<fields_t...>::bind(model.fields(), statement);
+				return batch.add(statement);
+			}
+
+			template<typename tableName, typename... fields_t> bool del(const model_t<tableName, fields_t...> &model)
+			{
+				using del = del_<tableName, fields_t...>;
+				mySQLBatchStatement_t statement{batch.prepare(del::value, countPrimary<fields_t...>::count)};
+				// This binds just the primary keys of the model so it tags in-order to the WHERE clause for this statement.
+				bindDelete<fields_t...>::bind(model.fields(), statement);
+				return batch.add(statement);
+			}
+
+			// Runs everything added so far in a single round trip to the server
+			bool execute() noexcept { return batch.execute(); }
+			void clear() noexcept { batch.clear(); }
+			size_t count() const noexcept { return batch.count(); }
+			bool succeeded(const size_t index) const noexcept { return batch.succeeded(index); }
+			const char *error() const noexcept { return batch.error(); }
+			uint32_t errorNum() const noexcept { return batch.errorNum(); }
+
+			batch_t(const batch_t &) = delete;
+			batch_t &operator =(const batch_t &) = delete;
+		};
+
 		struct session_t final
 		{
 		private:
@@ -373,7 +483,8 @@ namespace tmplORM
 			template<typename tableName, typename... fields_t> bool add(model_t<tableName, fields_t...> &model)
 			{
 				using add = add_<tableName, fields_t...>;
-				mySQLPreparedQuery_t query{database.prepare(add::value, countInsert_t<fields_t...>::count)};
+				mySQLBindSlab_t<countInsert_t<fields_t...>::count> slab{};
+				mySQLPreparedQuery_t query{database.prepare(add::value, slab.binds())};
 				bindInsert<fields_t...>::bind(model.fields(), query);
 				if (query.execute())
 				{
@@ -386,7 +497,8 @@ namespace tmplORM
 			template<typename tableName, typename... fields_t> bool add(const model_t<tableName, fields_t...> &model)
 			{
 				using add = addAll_<tableName, fields_t...>;
-				mySQLPreparedQuery_t query(database.prepare(add::value, sizeof...(fields_t)));
+				mySQLBindSlab_t<sizeof...(fields_t)> slab{};
+				mySQLPreparedQuery_t query(database.prepare(add::value, slab.binds()));
 				// This binds the fields in order so we insert a value for every column.
 				bindInsertAll<fields_t...>::bind(model.fields(), query);
 				// This either works or doesn't.. thankfully.. so, we can just execute-and-quit.
@@ -398,7 +510,8 @@ namespace tmplORM
 				using update = update_<tableName, fields_t...>;
 				if (std::is_same<update, toString<typestring<>>>::value)
 					return false;
-				mySQLPreparedQuery_t query(database.prepare(update::value, sizeof...(fields_t)));
+				mySQLBindSlab_t<sizeof...(fields_t)> slab{};
+				mySQLPreparedQuery_t query(database.prepare(update::value, slab.binds()));
 				// This binds the fields, primary key last so it tags to the WHERE clause for the query.
 				bindUpdate<fields_t...>::bind(model.fields(), query);
 				// This either works or doesn't.. thankfully.. so, we can just execute-and-quit.
@@ -408,7 +521,8 @@ namespace tmplORM
 			template<typename tableName, typename... fields_t> bool del(const model_t<tableName, fields_t...> &model)
 			{
 				using del = del_<tableName, fields_t...>;
-				mySQLPreparedQuery_t query(database.prepare(del::value, countPrimary<fields_t...>::count));
+				mySQLBindSlab_t<countPrimary<fields_t...>::count> slab{};
+				mySQLPreparedQuery_t query(database.prepare(del::value, slab.binds()));
 				// This binds just the primary keys of the model so it tags in-order to the WHERE clause for this query.
 				bindDelete<fields_t...>::bind(model.fields(), query);
 				// This either works or doesn't.. thankfully.. so, we can just execute-and-quit.
@@ -427,6 +541,9 @@ namespace tmplORM
 			bool connect(const char *const unixSocket, const char *const user, const char *const passwd) const noexcept
 				{ return database.connect(unixSocket, user, passwd); }
 			void disconnect() noexcept { database.disconnect(); }
+			// Clears per-checkout session state, for when a pooled session is handed back
+			bool reset() const noexcept { return database.reset(); }
+			batch_t batch() const noexcept { return {database.batch()}; }
 			bool selectDB(const char *const db) const noexcept { return database.selectDB(db); }
 			const char *error() const noexcept { return database.error(); }
 			uint32_t errorNum() const noexcept { return database.errorNum(); }
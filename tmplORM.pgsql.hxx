@@ -1,9 +1,13 @@
 #ifndef tmplORM_PGSQL_HXX
 #define tmplORM_PGSQL_HXX
 
+#include <array>
+#include <iterator>
 #include <substrate/buffer_utils>
+#include <substrate/utility>
 #include "tmplORM.hxx"
 #include "pgsql.hxx"
+#include "string.hxx"
 
 namespace tmplORM
 {
@@ -56,6 +60,7 @@ namespace tmplORM
 			template<> struct bind_t<ormUUID_t> { constexpr static auto value = pgSQLType_t::uuid; };
 
 			template<typename T> struct bindLength_t { constexpr static int32_t length = sizeof(T); };
+			template<> struct bindLength_t<int8_t> { constexpr static int32_t length = sizeof(int16_t); };
 			template<> struct bindLength_t<ormDate_t> { constexpr static int32_t length = sizeof(int32_t); };
 			template<> struct bindLength_t<ormDateTime_t> { constexpr static int32_t length = sizeof(int64_t); };
 
@@ -79,44 +84,38 @@ namespace tmplORM
 				static inline int32_t dateToPgDate(const ormDate_t &date)
 					{ return dateToJulianDate(date) - postgresDateEpoch; }
 
-				template<typename T> static const char *bind(const T &value, managedPtr_t<void> &paramStorage) noexcept
-				{
-					paramStorage = substrate::make_managed_nothrow<T>();
-					substrate::buffer_utils::writeBE(value, paramStorage.get());
-					return static_cast<const char *>(paramStorage.get());
-				}
+				// These encode a value into Postgres's binary wire format in the given buffer, which must
+				// be at least bindLength_t<T>::length bytes long
+				template<typename T> static void encode(const T &value, void *const buffer) noexcept
+					{ substrate::buffer_utils::writeBE(value, buffer); }
 
-				static const char *bind(const bool &value, managedPtr_t<void> &paramStorage) noexcept
-				{
-					paramStorage = substrate::make_managed_nothrow<uint8_t>(uint8_t(value ? 1U : 0U));
-					return static_cast<const char *>(paramStorage.get());
-				}
+				// Postgres has no single byte integer type, so these go over the wire as INT2's
+				static void encode(const int8_t &value, void *const buffer) noexcept
+					{ substrate::buffer_utils::writeBE(int16_t{value}, buffer); }
+
+				static void encode(const bool &value, void *const buffer) noexcept
+					{ *static_cast<uint8_t *>(buffer) = value ? 1U : 0U; }
 
-				static const char *bind(const float &value, managedPtr_t<void> &paramStorage) noexcept
+				static void encode(const float &value, void *const buffer) noexcept
 				{
 					uint32_t rawValue{};
 					static_assert(sizeof(uint32_t) == sizeof(float), "float and uint32_t aren't the same width");
 					std::memcpy(&rawValue, &value, sizeof(uint32_t));
-					return bind(rawValue, paramStorage);
+					encode(rawValue, buffer);
 				}
 
-				static const char *bind(const double &value, managedPtr_t<void> &paramStorage) noexcept
+				static void encode(const double &value, void *const buffer) noexcept
 				{
 					uint64_t rawValue{};
 					static_assert(sizeof(uint64_t) == sizeof(double), "double and uint64_t aren't the same width");
 					std::memcpy(&rawValue, &value, sizeof(uint64_t));
-					return bind(rawValue, paramStorage);
+					encode(rawValue, buffer);
 				}
 
-				static const char *bind(const ormDate_t &value, managedPtr_t<void> &paramStorage) noexcept
-				{
-					const auto date{dateToPgDate(value)};
-					paramStorage = substrate::make_managed_nothrow<int32_t>();
-					substrate::buffer_utils::writeBE(date, paramStorage.get());
-					return static_cast<const char *>(paramStorage.get());
-				}
+				static void encode(const ormDate_t &value, void *const buffer) noexcept
+					{ encode(dateToPgDate(value), buffer); }
 
-				static const char *bind(const ormDateTime_t &value, managedPtr_t<void> &paramStorage) noexcept
+				static void encode(const ormDateTime_t &value, void *const buffer) noexcept
 				{
 					const int64_t dateTime
 					{
@@ -134,24 +133,31 @@ namespace tmplORM
 							return timestamp;
 						}()
 					};
-					paramStorage = substrate::make_managed_nothrow<int64_t>();
-					substrate::buffer_utils::writeBE(dateTime, paramStorage.get());
-					return static_cast<const char *>(paramStorage.get());
+					encode(dateTime, buffer);
 				}
 
-				static const char *bind(const ormUUID_t &value, managedPtr_t<void> &paramStorage) noexcept
+				// This works because internally ormUUID_t keeps things big endian anyway.
+				static void encode(const ormUUID_t &value, void *const buffer) noexcept
+					{ std::memcpy(buffer, value.asPointer(), sizeof(guid_t)); }
+
+				// Encodes the value in place in the query's parameter storage, failing the query if there's no room
+				template<typename T> static const char *bind(const T &value, pgSQLQuery_t &query,
+					const size_t index) noexcept
 				{
-					// This works because internally ormUUID_t keeps things big endian anyway.
-					const auto *const uuid{value.asPointer()};
-					paramStorage = substrate::make_managed_nothrow<guid_t>();
-					std::memcpy(paramStorage.get(), uuid, sizeof(guid_t));
-					return static_cast<const char *>(paramStorage.get());
+					auto *const storage{query.valueStorage(index, bindLength_t<T>::length)};
+					if (!storage)
+					{
+						query.bindFailed = true;
+						return nullptr;
+					}
+					encode(value, storage);
+					return storage;
 				}
 			};
 
 			template<> struct bindValue_t<true>
 			{
-				static const char *bind(const void *const value, managedPtr_t<void> &) noexcept
+				static const char *bind(const void *const value, pgSQLQuery_t &, const size_t) noexcept
 					{ return static_cast<const char *>(value); }
 			};
 
@@ -160,18 +166,32 @@ namespace tmplORM
 			template<typename T> void pgSQLQuery_t::bind(const size_t index, const T &value,
 				const fieldLength_t length) noexcept
 			{
+				if (index >= numParams || !params)
+					return;
 				paramTypes[index] = typeToOID(bind_t<T>::value);
-				params[index] = bindValue<T>::bind(value, paramStorage[index]);
+				params[index] = bindValue<T>::bind(value, *this, index);
 				dataLengths[index] = length.first ? length.first : bindLength_t<T>::length;
 			}
 
 			template<typename T> void pgSQLQuery_t::bind(const size_t index, const nullptr_t,
 				const fieldLength_t length) noexcept
 			{
+				if (index >= numParams || !params)
+					return;
 				paramTypes[index] = typeToOID(bind_t<T>::value);
 				params[index] = nullptr;
 				dataLengths[index] = 0;
 			}
+
+			// The space needed to hold the binary forms of every field's value that is not already a pointer
+			template<typename... fields> struct valuesLength_t;
+			template<> struct valuesLength_t<> { constexpr static size_t value{0}; };
+			template<typename field, typename... fields> struct valuesLength_t<field, fields...>
+			{
+				using type = typename field::type;
+				constexpr static size_t value{(std::is_pointer<type>::value ? 0U :
+					static_cast<size_t>(bindLength_t<type>::length)) + valuesLength_t<fields...>::value};
+			};
 		} // namespace driver
 
 		template<typename name> using doubleQuote = tycat<ts("\""), name, ts("\"")>;
@@ -327,6 +347,66 @@ namespace tmplORM
 		template<typename... fields> using updateWhere =
 			typename updateWhere_t<hasPrimaryKey<fields...>(), fields...>::value;
 
+		// Generates `"field" = source."field"` for a non-key field, as a bulk UPDATE or upsert's SET list needs
+		template<bool, typename source, size_t N> struct assignField_t
+		{
+			template<typename fieldName, typename T> static auto value(const type_t<fieldName, T> &) ->
+				tycat<doubleQuote<fieldName>, ts(" = "), source, ts("."), doubleQuote<fieldName>, comma<N>>;
+		};
+		template<typename source, size_t N> struct assignField_t<true, source, N>
+			{ template<typename T> static auto value(const T &) -> typestring<>; };
+		template<typename source, size_t N, typename field> using assignField =
+			decltype(assignField_t<isPrimaryKey(field{}), source, N>::value(field{}));
+
+		template<typename, size_t, typename...> struct assignFields_t;
+		template<typename source, size_t N, typename... fields> using assignFields_ =
+			typename assignFields_t<source, N, fields...>::value;
+		template<typename source, size_t N, typename field, typename... fields>
+			struct assignFields_t<source, N, field, fields...>
+		{
+			using value = tycat<
+				assignField<source, N, field>,
+				assignFields_<source, N - (isPrimaryKey(field{}) ? 0 : 1), fields...>
+			>;
+		};
+		template<typename source> struct assignFields_t<source, 0> { using value = typestring<>; };
+		template<typename source, typename... fields> using assignFields =
+			assignFields_<source, sizeof...(fields) - countPrimary<fields...>::count, fields...>;
+
+		// Generates `"table"."key" = "u"."key"` for a key field, to match a table's rows to the unnest()ed ones
+		template<bool, typename tableName, size_t N> struct matchUnnestKey_t
+		{
+			template<typename fieldName, typename T> static auto value(const type_t<fieldName, T> &) ->
+				tycat<doubleQuote<tableName>, ts("."), doubleQuote<fieldName>, ts(" = \"u\"."), doubleQuote<fieldName>,
+					and_<N>>;
+		};
+		template<typename tableName, size_t N> struct matchUnnestKey_t<false, tableName, N>
+			{ template<typename T> static auto value(const T &) -> typestring<>; };
+		template<typename tableName, size_t N, typename field> using matchUnnestKey =
+			decltype(matchUnnestKey_t<isPrimaryKey(field{}), tableName, N>::value(field{}));
+
+		template<typename, size_t, typename...> struct matchUnnestKeys_t;
+		template<typename tableName, size_t N, typename... fields> using matchUnnestKeys_ =
+			typename matchUnnestKeys_t<tableName, N, fields...>::value;
+		template<typename tableName, size_t N, typename field, typename... fields>
+			struct matchUnnestKeys_t<tableName, N, field, fields...>
+		{
+			using value = tycat<
+				matchUnnestKey<tableName, N, field>,
+				matchUnnestKeys_<tableName, N - (isPrimaryKey(field{}) ? 1 : 0), fields...>
+			>;
+		};
+		template<typename tableName> struct matchUnnestKeys_t<tableName, 0> { using value = typestring<>; };
+		template<typename tableName, typename... fields> using matchUnnestKeys =
+			matchUnnestKeys_<tableName, countPrimary<fields...>::count, fields...>;
+
+		// An upsert of a model that is nothing but key has nothing to update when the row already exists
+		template<bool, typename... fields> struct onConflict_t
+			{ using value = tycat<ts(" DO UPDATE SET "), assignFields<ts("EXCLUDED"), fields...>>; };
+		template<typename... fields> struct onConflict_t<true, fields...> { using value = ts(" DO NOTHING"); };
+		template<typename... fields> using onConflict =
+			typename onConflict_t<sizeof...(fields) == countPrimary<fields...>::count, fields...>::value;
+
 		template<bool, typename tableName, typename... fields> struct update_t { using value = typestring<>; };
 		template<typename tableName, typename... fields> using update_ = toString<typename update_t<sizeof...(fields) ==
 			countPrimary<fields...>::count, tableName, fields...>::value>;
@@ -336,9 +416,17 @@ namespace tmplORM
 		{
 			constexpr static size_t index = idx - 1;
 
+			// String values point into the result, so the model gets a copy of its own to outlive that
+			template<typename field_t> static void assignValue(field_t &field, const driver::pgSQLValue_t &result,
+				std::true_type) { field = stringDup(result.asString()); }
+			template<typename field_t> static void assignValue(field_t &field, const driver::pgSQLValue_t &result,
+				std::false_type) { field = result; }
+			template<typename field_t> using isString_t = std::is_same<typename field_t::type, const char *>;
+
 			template<typename field_t, bool = field_t::nullable> struct value_t
 			{
-				static void assign(field_t &field, const driver::pgSQLValue_t &result) { field = result; }
+				static void assign(field_t &field, const driver::pgSQLValue_t &result)
+					{ assignValue(field, result, isString_t<field_t>{}); }
 			};
 
 			template<typename field_t> struct value_t<field_t, true>
@@ -348,7 +436,7 @@ namespace tmplORM
 					if (result.isNull())
 						field = nullptr;
 					else
-						field = result;
+						assignValue(field, result, isString_t<field_t>{});
 				}
 			};
 
@@ -365,6 +453,253 @@ namespace tmplORM
 		/*! @brief Helper type for bindSelect_t that makes the binding type easier to use */
 		template<typename... fields> using bindSelect = bindSelect_t<sizeof...(fields), fields...>;
 
+		/*!
+		 * @brief Decodes a SELECT's result into models a column at a time, which lets the numeric and date columns go
+		 * through pgSQLResult_t::decodeColumn() rather than being converted value by value
+		 */
+		template<size_t idx, typename... fields_t> struct selectColumns_t
+		{
+			constexpr static size_t index = idx - 1;
+			using field_t = fieldType_<index, fields_t...>;
+			using type = typename field_t::type;
+			using columnar_t = std::integral_constant<bool, std::is_same<type, bool>::value ||
+				std::is_same<type, int16_t>::value || std::is_same<type, int32_t>::value ||
+				std::is_same<type, int64_t>::value || std::is_same<type, float>::value ||
+				std::is_same<type, double>::value || std::is_same<type, ormDate_t>::value ||
+				std::is_same<type, ormDateTime_t>::value>;
+
+			static bool assignNull(field_t &field, std::true_type) noexcept
+			{
+				field = nullptr;
+				return true;
+			}
+			static bool assignNull(field_t &, std::false_type) noexcept { return false; }
+
+			template<typename T> static bool decode(fixedVector_t<T> &models, const driver::pgSQLResult_t &result,
+				std::true_type)
+			{
+				fixedVector_t<type> values{models.count()};
+				fixedVector_t<bool> nulls{models.count()};
+				if (!values.valid() || !nulls.valid() ||
+					!result.decodeColumn(index, values.data(), values.count(), nulls.data()))
+					return false;
+				for (size_t i = 0; i < models.count(); ++i)
+				{
+					auto &field{std::get<index>(models.data()[i].fields())};
+					if (!nulls.data()[i])
+						field = values.data()[i];
+					else if (!assignNull(field, std::integral_constant<bool, field_t::nullable>{}))
+						return false;
+				}
+				return true;
+			}
+
+			template<typename T> static bool decode(fixedVector_t<T> &models, const driver::pgSQLResult_t &result,
+				std::false_type)
+			{
+				using value_t = typename bindSelect_t<idx, fields_t...>::template value_t<field_t>;
+				for (size_t i = 0; i < models.count(); ++i)
+					value_t::assign(std::get<index>(models.data()[i].fields()), result.value(static_cast<uint32_t>(i), index));
+				return true;
+			}
+
+			template<typename T> static bool decode(fixedVector_t<T> &models, const driver::pgSQLResult_t &result)
+			{
+				return selectColumns_t<index, fields_t...>::decode(models, result) &&
+					decode(models, result, columnar_t{});
+			}
+		};
+
+		/*! @brief End (base) case for selectColumns_t that terminates the recursion */
+		template<typename... fields> struct selectColumns_t<0, fields...>
+		{
+			template<typename T> static bool decode(fixedVector_t<T> &, const driver::pgSQLResult_t &) noexcept
+				{ return true; }
+		};
+		/*! @brief Helper type for selectColumns_t that makes the decoding type easier to use */
+		template<typename... fields> using selectColumns = selectColumns_t<sizeof...(fields), fields...>;
+
+		template<typename T> using isDate_t = std::is_same<T, ormDate_t>;
+		template<typename T> using isDateTime_t = std::is_same<T, ormDateTime_t>;
+
+		/*! @brief Counts how many of the first idx fields have a value type that satisfies the given predicate */
+		template<template<typename> class pred_t, size_t idx, typename... fields_t> struct countFields_t
+		{
+			constexpr static size_t value = countFields_t<pred_t, idx - 1, fields_t...>::value +
+				(pred_t<typename fieldType_<idx - 1, fields_t...>::type>::value ? 1U : 0U);
+		};
+
+		/*! @brief End (base) case for countFields_t that terminates the recursion */
+		template<template<typename> class pred_t, typename... fields_t> struct countFields_t<pred_t, 0, fields_t...>
+			{ constexpr static size_t value = 0; };
+
+		/*!
+		 * @brief Holds the raw values of the date and date-time fields of a chunk of COPY tuples so that they
+		 * can be decoded in bulk by driver::decodeDates() and driver::decodeDateTimes() once the chunk is full
+		 */
+		template<typename... fields_t> struct copyOutDates_t final
+		{
+		private:
+			constexpr static size_t dateCount = countFields_t<isDate_t, sizeof...(fields_t), fields_t...>::value;
+			constexpr static size_t dateTimeCount = countFields_t<isDateTime_t, sizeof...(fields_t), fields_t...>::value;
+
+			size_t chunkLength;
+			// The raw values and NULL flags are held a field at a time, chunkLength entries per field
+			fixedVector_t<int32_t> rawDates;
+			fixedVector_t<bool> dateNulls;
+			fixedVector_t<ormDate_t> dates;
+			fixedVector_t<int64_t> rawDateTimes;
+			fixedVector_t<bool> dateTimeNulls;
+			fixedVector_t<ormDateTime_t> dateTimes;
+
+			template<typename field_t, typename raw_t> static void store(const driver::pgSQLValue_t &value,
+				raw_t &rawValue, bool &isNull, const driver::pgSQLErrorType_t error)
+			{
+				isNull = value.isNull();
+				if (isNull && !field_t::nullable)
+					throw driver::pgSQLValueError_t{error};
+				else if (!isNull)
+					std::memcpy(&rawValue, value.rawData(), sizeof(raw_t));
+			}
+
+			template<size_t index> void store(const driver::pgSQLValue_t &value, const size_t row, const ormDate_t *)
+			{
+				const size_t offset{(countFields_t<isDate_t, index, fields_t...>::value * chunkLength) + row};
+				store<fieldType_<index, fields_t...>>(value, rawDates.data()[offset], dateNulls.data()[offset],
+					driver::pgSQLErrorType_t::dateError);
+			}
+
+			template<size_t index> void store(const driver::pgSQLValue_t &value, const size_t row, const ormDateTime_t *)
+			{
+				const size_t offset{(countFields_t<isDateTime_t, index, fields_t...>::value * chunkLength) + row};
+				store<fieldType_<index, fields_t...>>(value, rawDateTimes.data()[offset], dateTimeNulls.data()[offset],
+					driver::pgSQLErrorType_t::dateTimeError);
+			}
+
+			template<size_t index, typename T, typename value_t> static void assign(fixedVector_t<T> &chunk,
+				const size_t count, const value_t *const values, const bool *const nulls) noexcept
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					auto &field{std::get<index>(chunk.data()[i].fields())};
+					if (nulls[i])
+						field = nullptr;
+					else
+						field = values[i];
+				}
+			}
+
+			template<size_t, typename T, typename value_t> void decodeField(fixedVector_t<T> &, const size_t,
+				const value_t *) noexcept { }
+
+			template<size_t index, typename T> void decodeField(fixedVector_t<T> &chunk, const size_t count,
+				const ormDate_t *) noexcept
+			{
+				const size_t offset{countFields_t<isDate_t, index, fields_t...>::value * chunkLength};
+				driver::decodeDates(rawDates.data() + offset, dates.data(), count);
+				assign<index>(chunk, count, dates.data(), dateNulls.data() + offset);
+			}
+
+			template<size_t index, typename T> void decodeField(fixedVector_t<T> &chunk, const size_t count,
+				const ormDateTime_t *) noexcept
+			{
+				const size_t offset{countFields_t<isDateTime_t, index, fields_t...>::value * chunkLength};
+				driver::decodeDateTimes(rawDateTimes.data() + offset, dateTimes.data(), count);
+				assign<index>(chunk, count, dateTimes.data(), dateTimeNulls.data() + offset);
+			}
+
+			template<typename T> void decode(fixedVector_t<T> &, const size_t, std::integral_constant<size_t, 0>) noexcept { }
+
+			template<typename T, size_t idx> void decode(fixedVector_t<T> &chunk, const size_t count,
+				std::integral_constant<size_t, idx>) noexcept
+			{
+				decode(chunk, count, std::integral_constant<size_t, idx - 1>{});
+				decodeField<idx - 1>(chunk, count,
+					static_cast<const typename fieldType_<idx - 1, fields_t...>::type *>(nullptr));
+			}
+
+		public:
+			copyOutDates_t(const size_t length) : chunkLength{length},
+				rawDates{dateCount * length}, dateNulls{dateCount * length}, dates{dateCount ? length : 0U},
+				rawDateTimes{dateTimeCount * length}, dateTimeNulls{dateTimeCount * length},
+				dateTimes{dateTimeCount ? length : 0U} { }
+
+			bool valid() const noexcept
+			{
+				return (!dateCount || (rawDates.valid() && dateNulls.valid() && dates.valid())) &&
+					(!dateTimeCount || (rawDateTimes.valid() && dateTimeNulls.valid() && dateTimes.valid()));
+			}
+
+			/*! @brief Stashes the raw value of the date or date-time field index of the row'th tuple in the chunk */
+			template<size_t index> void store(const driver::pgSQLValue_t &value, const size_t row)
+				{ store<index>(value, row, static_cast<const typename fieldType_<index, fields_t...>::type *>(nullptr)); }
+
+			/*! @brief Decodes the stashed values of the first count tuples of the chunk into their models */
+			template<typename T> void decode(fixedVector_t<T> &chunk, const size_t count) noexcept
+			{
+				if (dateCount || dateTimeCount)
+					decode(chunk, count, std::integral_constant<size_t, sizeof...(fields_t)>{});
+			}
+		};
+
+		/*!
+		 * @brief Binds a model's fields to a tuple from a binary COPY, with string fields pointing into the COPY's tuple storage
+		 * and date and date-time fields being stashed to decode in bulk at the end of the chunk
+		 */
+		template<size_t idx, typename... fields_t> struct bindCopyOut_t
+		{
+			constexpr static size_t index = idx - 1;
+			using field_t = fieldType_<index, fields_t...>;
+
+			// The value type's conversion to strings is explicit, so these have to be asked for specifically
+			template<typename _field_t, bool = _field_t::nullable> struct string_t
+			{
+				static void assign(_field_t &field, const driver::pgSQLValue_t &result)
+					{ field = result.asString(); }
+			};
+
+			template<typename _field_t> struct string_t<_field_t, true>
+			{
+				static void assign(_field_t &field, const driver::pgSQLValue_t &result)
+				{
+					if (result.isNull())
+						field = nullptr;
+					else
+						field = result.asString();
+				}
+			};
+
+			template<typename _field_t> using value_t = typename std::conditional<
+				std::is_same<typename _field_t::type, const char *>::value,
+				string_t<_field_t>,
+				typename bindSelect_t<idx, fields_t...>::template value_t<_field_t>
+			>::type;
+
+			using deferred_t = std::integral_constant<bool, isDate_t<typename field_t::type>::value ||
+				isDateTime_t<typename field_t::type>::value>;
+
+			static void assign(field_t &, const driver::pgSQLValue_t &value, copyOutDates_t<fields_t...> &dates,
+				const size_t row, std::true_type) { dates.template store<index>(value, row); }
+			static void assign(field_t &field, const driver::pgSQLValue_t &value, copyOutDates_t<fields_t...> &,
+				const size_t, std::false_type) { value_t<field_t>::assign(field, value); }
+
+			static void bind(std::tuple<fields_t...> &fields, const driver::pgSQLCopyOut_t &copy,
+				copyOutDates_t<fields_t...> &dates, const size_t row)
+			{
+				bindCopyOut_t<index, fields_t...>::bind(fields, copy, dates, row);
+				assign(std::get<index>(fields), copy[index], dates, row, deferred_t{});
+			}
+		};
+
+		/*! @brief End (base) case for bindCopyOut_t that terminates the recursion */
+		template<typename... fields> struct bindCopyOut_t<0, fields...>
+		{
+			static void bind(std::tuple<fields...> &, const driver::pgSQLCopyOut_t &, copyOutDates_t<fields...> &,
+				const size_t) noexcept { }
+		};
+		/*! @brief Helper type for bindCopyOut_t that makes the binding type easier to use */
+		template<typename... fields> using bindCopyOut = bindCopyOut_t<sizeof...(fields), fields...>;
+
 		template<typename field_t> constexpr fieldLength_t fieldLength(const field_t &) noexcept { return {0, 0}; }
 		template<typename fieldName, size_t length> fieldLength_t fieldLength(const unicode_t<fieldName, length> &field) noexcept
 			{ return {field.length(), length}; }
@@ -504,6 +839,114 @@ namespace tmplORM
 		/*! @brief Helper type for bindDelete_t that makes the binding type easier to use */
 		template<typename... fields> using bindDelete = bindDelete_t<sizeof...(fields), countPrimary<fields...>::count, fields...>;
 
+		/*!
+		 * @brief Writes a value to a binary COPY or array as its length followed by its encoding, as bindValue_t would
+		 * bind it. The two formats encode their fields and elements identically.
+		 */
+		template<typename sink_t, typename T> bool copyValue(sink_t &copy, const T &value, const fieldLength_t) noexcept
+		{
+			constexpr int32_t length{driver::bindLength_t<T>::length};
+			auto *const buffer{static_cast<uint8_t *>(copy.reserve(sizeof(int32_t) + length))};
+			if (!buffer)
+				return false;
+			substrate::buffer_utils::writeBE(length, buffer);
+			driver::bindValue_t<false>::encode(value, buffer + sizeof(int32_t));
+			return true;
+		}
+
+		template<typename sink_t> bool copyValue(sink_t &copy, const char *const value, const fieldLength_t length) noexcept
+		{
+			auto *const buffer{copy.reserve(sizeof(int32_t))};
+			if (!buffer || length.first > size_t(std::numeric_limits<int32_t>::max()))
+				return false;
+			substrate::buffer_utils::writeBE(static_cast<int32_t>(length.first), buffer);
+			return copy.write(value, length.first);
+		}
+
+		template<typename field_t, bool = field_t::nullable> struct copyField_t
+		{
+			template<typename sink_t> static bool write(sink_t &copy, const field_t &field) noexcept
+				{ return copyValue(copy, field.value(), fieldLength(field)); }
+		};
+
+		template<typename field_t> struct copyField_t<field_t, true>
+		{
+			template<typename sink_t> static bool write(sink_t &copy, const field_t &field) noexcept
+			{
+				if (!field.isNull())
+					return copyValue(copy, field.value(), fieldLength(field));
+				// NULLs are represented by a length of -1 and no data
+				auto *const buffer{copy.reserve(sizeof(int32_t))};
+				if (!buffer)
+					return false;
+				substrate::buffer_utils::writeBE(int32_t{-1}, buffer);
+				return true;
+			}
+		};
+
+		/*!
+		 * @brief Builds one array parameter per field from the values of that field across a range of models,
+		 * for the unnest() of a bulk UPDATE or upsert. The arrays must outlive the query's execution.
+		 */
+		template<size_t idx, typename... fields_t> struct bindUnnest_t
+		{
+			constexpr static size_t index = idx - 1;
+			using field_t = fieldType_<index, fields_t...>;
+
+			template<typename range_t> static bool bind(const range_t &models, const size_t count,
+				fixedVector_t<driver::pgSQLArray_t> &arrays, driver::pgSQLQuery_t &query) noexcept
+			{
+				if (!bindUnnest_t<index, fields_t...>::bind(models, count, arrays, query))
+					return false;
+				auto &array{arrays.data()[index]};
+				array = {driver::bind_t<typename field_t::type>::value, count};
+				if (!array.valid())
+					return false;
+				for (const auto &model : models)
+				{
+					if (!copyField_t<field_t>::write(array, std::get<index>(model.fields())))
+						return false;
+				}
+				query.bind(index, array);
+				return true;
+			}
+		};
+
+		/*! @brief End (base) case for bindUnnest_t that terminates the recursion */
+		template<typename... fields> struct bindUnnest_t<0, fields...>
+		{
+			template<typename range_t> static bool bind(const range_t &, const size_t,
+				fixedVector_t<driver::pgSQLArray_t> &, driver::pgSQLQuery_t &) noexcept { return true; }
+		};
+		/*! @brief Helper type for bindUnnest_t that makes the binding type easier to use */
+		template<typename... fields> using bindUnnest = bindUnnest_t<sizeof...(fields), fields...>;
+
+		/*! @brief Writes a model's fields to a binary COPY as a single tuple, ensuring that auto-increment fields are not written */
+		template<size_t idx, typename... fields_t> struct copyInRow_t
+		{
+			constexpr static size_t index = idx - 1;
+
+			template<typename fieldName, typename T, typename field_t> static bool writeField(const type_t<fieldName, T> &,
+				const field_t &field, const std::tuple<fields_t...> &fields, driver::pgSQLCopyIn_t &copy) noexcept
+				{ return copyInRow_t<index, fields_t...>::write(fields, copy) && copyField_t<field_t>::write(copy, field); }
+
+			template<typename T, typename field_t> static bool writeField(const autoInc_t<T> &, const field_t &,
+					const std::tuple<fields_t...> &fields, driver::pgSQLCopyIn_t &copy) noexcept
+				{ return copyInRow_t<index, fields_t...>::write(fields, copy); }
+
+			static bool write(const std::tuple<fields_t...> &fields, driver::pgSQLCopyIn_t &copy) noexcept
+			{
+				const auto &field = std::get<index>(fields);
+				return writeField(field, field, fields, copy);
+			}
+		};
+
+		/*! @brief End (base) case for copyInRow_t that terminates the recursion */
+		template<typename... fields> struct copyInRow_t<0, fields...>
+			{ static bool write(const std::tuple<fields...> &, driver::pgSQLCopyIn_t &) noexcept { return true; } };
+		/*! @brief Helper type for copyInRow_t that makes the row writing type easier to use */
+		template<typename... fields> using copyInRow = copyInRow_t<sizeof...(fields), fields...>;
+
 		template<typename> struct createName_t { };
 		template<typename fieldName, typename T> struct createName_t<type_t<fieldName, T>>
 			{ using value = tycat<doubleQuote<fieldName>, ts(" "), stringType<T>>; };
@@ -571,18 +1014,452 @@ namespace tmplORM
 				ts(";")
 			>;
 		};
+		// Both of these take one array parameter per field, which unnest() turns back into rows to work on
+		template<typename tableName, typename... fields> using updateUnnest_ = toString<
+			tycat<
+				ts("UPDATE "),
+				doubleQuote<tableName>,
+				ts(" SET "),
+				assignFields<ts("\"u\""), fields...>,
+				ts(" FROM unnest("),
+				placeholder<sizeof...(fields), 1>,
+				ts(") AS \"u\" ("),
+				insertAllList<fields...>,
+				ts(") WHERE "),
+				matchUnnestKeys<tableName, fields...>,
+				ts(";")
+			>
+		>;
+		template<typename tableName, typename... fields> using upsertUnnest_ = toString<
+			tycat<
+				ts("INSERT INTO "),
+				doubleQuote<tableName>,
+				ts(" ("),
+				insertAllList<fields...>,
+				ts(") OVERRIDING SYSTEM VALUE SELECT * FROM unnest("),
+				placeholder<sizeof...(fields), 1>,
+				ts(") ON CONFLICT ("),
+				retrieveIDFields<fields...>,
+				ts(")"),
+				onConflict<fields...>,
+				ts(";")
+			>
+		>;
 		template<typename tableName, typename... fields> using del_ = toString<
 			tycat<ts("DELETE FROM "), doubleQuote<tableName>, updateWhere<fields...>, ts(";")>
 		>;
+		template<typename tableName, typename... fields> using copyIn_ = toString<
+			tycat<
+				ts("COPY "),
+				doubleQuote<tableName>,
+				ts(" ("),
+				insertList<fields...>,
+				ts(") FROM STDIN (FORMAT binary);")
+			>
+		>;
+		template<typename tableName, typename... fields> using copyOut_ = toString<
+			tycat<
+				ts("COPY (SELECT "),
+				selectList<fields...>,
+				ts(" FROM "),
+				doubleQuote<tableName>,
+				ts(") TO STDOUT (FORMAT binary);")
+			>
+		>;
+		template<typename tableName, typename... fields> using declareCursor_ = toString<
+			tycat<
+				ts("DECLARE \"tmplORMCursor\" BINARY NO SCROLL CURSOR FOR SELECT "),
+				selectList<fields...>,
+				ts(" FROM "),
+				doubleQuote<tableName>,
+				ts(";")
+			>
+		>;
 		template<typename tableName> using deleteTable_ = toString<
 			tycat<ts("DROP TABLE IF EXISTS "), doubleQuote<tableName>, ts(";")>
 		>;
 
+		// Decodes every row of a SELECT's result into models, giving back an invalid vector if anything goes wrong
+		template<typename T, typename tableName, typename... fields_t> fixedVector_t<T>
+			selectModels(const driver::pgSQLResult_t &result, const model_t<tableName, fields_t...> *) noexcept try
+		{
+			fixedVector_t<T> data{result.numRows()};
+			if (!data.valid() || !result.hasData() || !selectColumns<fields_t...>::decode(data, result))
+				return {};
+			return data;
+		}
+		catch (const driver::pgSQLValueError_t &)
+			{ return {}; }
+
+		// Hands the models decoded from an asynchronous SELECT to a callback once the query completes
+		template<typename T, typename callback_t> struct selectCompletion_t final : driver::pgSQLCompletion_t
+		{
+		private:
+			callback_t callback;
+
+		public:
+			template<typename function_t> selectCompletion_t(function_t &&_callback) :
+				callback{std::forward<function_t>(_callback)} { }
+			void complete(driver::pgSQLResult_t &result) noexcept final
+				{ callback(selectModels<T>(result, static_cast<const T *>(nullptr))); }
+		};
+
+		/*!
+		 * @brief Pages through every row of a model's table with a server-side cursor, decoding the rows a chunk of
+		 * models at a time so memory use stays bounded no matter how big the table is
+		 * @details The cursor lives in a transaction of its own, which is ended and the cursor closed once the last
+		 * chunk has been read, or the cursor_t is destroyed.
+		 */
+		template<typename T> struct cursor_t final
+		{
+		private:
+			driver::pgSQLClient_t *database{nullptr};
+			std::unique_ptr<const char []> fetchQuery{};
+			size_t chunkLength{0};
+			fixedVector_t<T> models{};
+			bool completed{false};
+
+			cursor_t(driver::pgSQLClient_t &client, const char *const declareQuery, const size_t length) noexcept :
+				fetchQuery{formatString(R"(FETCH FORWARD %zu FROM "tmplORMCursor";)", length)}, chunkLength{length}
+			{
+				if (!fetchQuery || !chunkLength || !client.beginTransact())
+					return;
+				database = &client;
+				const auto result{database->query(declareQuery)};
+				if (!result.valid() || result.errorNum() != PGRES_COMMAND_OK)
+					finish(false);
+				else
+					fetch();
+			}
+			friend struct session_t;
+
+			bool fetch() noexcept
+			{
+				const auto result{database->query(fetchQuery.get())};
+				if (!result.valid() || result.errorNum() != PGRES_TUPLES_OK)
+					finish(false);
+				else if (!result.numRows())
+					finish(true);
+				else
+				{
+					models = selectModels<T>(result, static_cast<const T *>(nullptr));
+					if (models.valid())
+						return true;
+					finish(false);
+				}
+				return false;
+			}
+
+			void finish(const bool success) noexcept
+			{
+				const auto result{database->query(R"(CLOSE "tmplORMCursor";)")};
+				completed = success && result.valid() && result.errorNum() == PGRES_COMMAND_OK;
+				database->endTransact(completed);
+				database = nullptr;
+				models = {};
+			}
+
+		public:
+			struct iterator_t final
+			{
+			private:
+				cursor_t *cursor;
+
+			public:
+				// Chunks are replaced as they are fetched, so this can only ever be walked once
+				using iterator_category = std::input_iterator_tag;
+				using value_type = fixedVector_t<T>;
+				using difference_type = std::ptrdiff_t;
+				using pointer = fixedVector_t<T> *;
+				using reference = fixedVector_t<T> &;
+
+				iterator_t(cursor_t *const _cursor) noexcept :
+					cursor{_cursor && _cursor->valid() ? _cursor : nullptr} { }
+				reference operator *() const noexcept { return cursor->models; }
+				pointer operator ->() const noexcept { return &cursor->models; }
+				iterator_t &operator ++() noexcept
+				{
+					if (!cursor->next())
+						cursor = nullptr;
+					return *this;
+				}
+				bool operator ==(const iterator_t &other) const noexcept { return cursor == other.cursor; }
+				bool operator !=(const iterator_t &other) const noexcept { return cursor != other.cursor; }
+			};
+
+			cursor_t() noexcept = default;
+			cursor_t(cursor_t &&cursor) noexcept : cursor_t{} { swap(cursor); }
+			~cursor_t() noexcept
+			{
+				if (valid())
+					finish(false);
+			}
+			void operator =(cursor_t &&cursor) noexcept { swap(cursor); }
+			// Call to determine if this cursor is valid and positioned on a chunk of models
+			bool valid() const noexcept { return database; }
+			// Call to determine if every row was read once next() has returned false
+			bool successful() const noexcept { return completed; }
+			fixedVector_t<T> &chunk() noexcept { return models; }
+
+			// Moves on to the next chunk of models, returning false once there are no more
+			bool next() noexcept
+			{
+				if (!valid())
+					return false;
+				// A short chunk means the cursor has already run out of rows
+				else if (models.count() < chunkLength)
+				{
+					finish(true);
+					return false;
+				}
+				return fetch();
+			}
+
+			iterator_t begin() noexcept { return {this}; }
+			iterator_t end() noexcept { return {nullptr}; }
+
+			void swap(cursor_t &cursor) noexcept
+			{
+				std::swap(database, cursor.database);
+				fetchQuery.swap(cursor.fetchQuery);
+				std::swap(chunkLength, cursor.chunkLength);
+				models.swap(cursor.models);
+				std::swap(completed, cursor.completed);
+			}
+
+			cursor_t(const cursor_t &) = delete;
+			cursor_t &operator =(const cursor_t &) = delete;
+		};
+
+		struct batch_t final
+		{
+		private:
+			// Tracks a model whose auto-increment field gets filled in from its statement's RETURNING result
+			struct autoIncModel_t final
+			{
+				size_t index;
+				void *model;
+				void (*assign)(void *model, const driver::pgSQLResult_t &result);
+			};
+
+			driver::pgSQLClient_t *database{nullptr};
+			driver::pgSQLPipeline_t pipeline{};
+			std::vector<autoIncModel_t> models{};
+
+			batch_t(driver::pgSQLClient_t &client) noexcept : database{&client}, pipeline{client.pipeline()} { }
+			friend struct session_t;
+
+			template<typename tableName, typename... fields_t> static void setAutoInc(void *const model,
+				const driver::pgSQLResult_t &result)
+			{
+				auto &value{*static_cast<model_t<tableName, fields_t...> *>(model)};
+				setAutoInc_t<hasAutoInc<fields_t...>()>::set(value, result[0]);
+			}
+
+		public:
+			batch_t() noexcept = default;
+			~batch_t() noexcept = default;
+			batch_t(batch_t &&_batch) noexcept : batch_t{} { swap(_batch); }
+			void operator =(batch_t &&_batch) noexcept { swap(_batch); }
+			bool valid() const noexcept { return pipeline.valid(); }
+
+			void swap(batch_t &_batch) noexcept
+			{
+				std::swap(database, _batch.database);
+				pipeline.swap(_batch.pipeline);
+				models.swap(_batch.models);
+			}
+
+			// The model must outlive the call to execute() as that's when its auto-increment field gets filled in
+			template<typename tableName, typename... fields_t> bool add(model_t<tableName, fields_t...> &model)
+			{
+				using insert = add_<tableName, fields_t...>;
+				if (!valid())
+					return false;
+				auto query{database->prepareNamed(insert::value, countInsert_t<fields_t...>::count,
+					driver::valuesLength_t<fields_t...>::value)};
+				bindInsert<fields_t...>::bind(model.fields(), query);
+				if (hasAutoInc<fields_t...>())
+					models.reserve(models.size() + 1U);
+				if (!pipeline.add(query))
+					return false;
+				if (hasAutoInc<fields_t...>())
+					models.push_back({pipeline.count() - 1U, &model, setAutoInc<tableName, fields_t...>});
+				return true;
+			}
+
+			template<typename tableName, typename... fields_t> bool add(const model_t<tableName, fields_t...> &model)
+			{
+				using insert = addAll_<tableName, fields_t...>;
+				if (!valid())
+					return false;
+				auto query{database->prepareNamed(insert::value, sizeof...(fields_t),
+					driver::valuesLength_t<fields_t...>::value)};
+				bindInsertAll<fields_t...>::bind(model.fields(), query);
+				return pipeline.add(query);
+			}
+
+			template<typename tableName, typename... fields_t> bool update(const model_t<tableName, fields_t...> &model)
+			{
+				using update = update_<tableName, fields_t...>;
+				if (std::is_same<update, toString<typestring<>>>::value || !valid())
+					return false;
+				auto query{database->prepareNamed(update::value, sizeof...(fields_t),
+					driver::valuesLength_t<fields_t...>::value)};
+				// This binds the fields, primary key last so it tags to the WHERE clause for the statement.
+				bindUpdate<fields_t...>::bind(model.fields(), query);
+				return pipeline.add(query);
+			}
+
+			template<typename tableName, typename... fields_t> bool del(const model_t<tableName, fields_t...> &model)
+			{
+				using del = del_<tableName, fields_t...>;
+				if (!valid())
+					return false;
+				auto query{database->prepareNamed(del::value, countPrimary<fields_t...>::count,
+					driver::valuesLength_t<fields_t...>::value)};
+				// This binds just the primary keys of the model so it tags in-order to the WHERE clause for this statement.
+				bindDelete<fields_t...>::bind(model.fields(), query);
+				return pipeline.add(query);
+			}
+
+			// Sends everything added so far in one go and waits on all the results together
+			bool execute()
+			{
+				const auto result{pipeline.execute()};
+				for (const auto &model : models)
+				{
+					if (pipeline.succeeded(model.index))
+						model.assign(model.model, pipeline[model.index]);
+				}
+				models.clear();
+				return result;
+			}
+
+			size_t count() const noexcept { return pipeline.count(); }
+			bool succeeded(const size_t index) const noexcept { return pipeline.succeeded(index); }
+
+			batch_t(const batch_t &) = delete;
+			batch_t &operator =(const batch_t &) = delete;
+		};
+
 		struct session_t final
 		{
 		private:
 			driver::pgSQLClient_t database;
 
+			template<typename range_t, typename tableName, typename... fields_t>
+				bool copyInModels(const range_t &models, const model_t<tableName, fields_t...> *) noexcept
+			{
+				using copyIn = copyIn_<tableName, fields_t...>;
+				auto copy{database.copyIn(copyIn::value)};
+				if (!copy.valid())
+					return false;
+				// The PGCOPY signature, followed by the flags field and header extension length, both 0
+				constexpr static std::array<char, 19> header
+					{{'P', 'G', 'C', 'O', 'P', 'Y', '\n', '\xFF', '\r', '\n', '\0', 0, 0, 0, 0, 0, 0, 0, 0}};
+				if (!copy.write(header.data(), header.size()))
+					return false;
+				for (const auto &model : models)
+				{
+					auto *const fieldCount{copy.reserve(sizeof(int16_t))};
+					if (!fieldCount)
+						return false;
+					substrate::buffer_utils::writeBE(int16_t{countInsert_t<fields_t...>::count}, fieldCount);
+					if (!copyInRow<fields_t...>::write(model.fields(), copy))
+						return false;
+				}
+				// The trailer is a tuple with a field count of -1
+				auto *const trailer{copy.reserve(sizeof(int16_t))};
+				if (!trailer)
+					return false;
+				substrate::buffer_utils::writeBE(int16_t{-1}, trailer);
+				return copy.end();
+			}
+
+			template<typename range_t, typename... fields_t> bool unnestModels(const char *const statement,
+				const range_t &models) noexcept
+			{
+				const auto count{static_cast<size_t>(std::distance(std::begin(models), std::end(models)))};
+				if (!count)
+					return true;
+				fixedVector_t<driver::pgSQLArray_t> arrays{sizeof...(fields_t)};
+				// The parameters are all arrays, which bring their own storage, so no value space is needed
+				auto query{database.prepareNamed(statement, sizeof...(fields_t), 0)};
+				if (!arrays.valid() || !query.valid() || !bindUnnest<fields_t...>::bind(models, count, arrays, query))
+					return false;
+				const auto result{query.execute()};
+				return result.valid() && result.successful();
+			}
+
+			template<typename range_t, typename tableName, typename... fields_t>
+				bool updateAllModels(const range_t &models, const model_t<tableName, fields_t...> *) noexcept
+			{
+				using update = updateUnnest_<tableName, fields_t...>;
+				static_assert(hasPrimaryKey<fields_t...>(), "Bulk updates need a primary key to match rows by");
+				if (sizeof...(fields_t) == countPrimary<fields_t...>::count)
+					return false;
+				return unnestModels<range_t, fields_t...>(update::value, models);
+			}
+
+			template<typename range_t, typename tableName, typename... fields_t>
+				bool upsertAllModels(const range_t &models, const model_t<tableName, fields_t...> *) noexcept
+			{
+				using upsert = upsertUnnest_<tableName, fields_t...>;
+				static_assert(hasPrimaryKey<fields_t...>(), "Upserts need a primary key to detect conflicts on");
+				return unnestModels<range_t, fields_t...>(upsert::value, models);
+			}
+
+			template<typename T, typename sink_t, typename tableName, typename... fields_t>
+				bool copyOutModels(sink_t &sink, const size_t chunkLength, const model_t<tableName, fields_t...> *)
+			{
+				using copyOut = copyOut_<tableName, fields_t...>;
+				const std::array<driver::pgSQLType_t, sizeof...(fields_t)> types
+					{{driver::bind_t<typename fields_t::type>::value...}};
+				auto copy{database.copyOut(copyOut::value, types.data(), types.size())};
+				fixedVector_t<T> chunk{chunkLength};
+				copyOutDates_t<fields_t...> dates{chunkLength};
+				if (!copy.valid() || !chunk.valid() || !dates.valid())
+					return false;
+				size_t count{0};
+				// Each chunk's tuples are retained so the strings of every model in it stay valid until the sink is done
+				while (copy.next(count != 0))
+				{
+					bindCopyOut<fields_t...>::bind(chunk.data()[count].fields(), copy, dates, count);
+					if (++count == chunk.count())
+					{
+						dates.decode(chunk, count);
+						sink(chunk, count);
+						count = 0;
+					}
+				}
+				if (count)
+				{
+					dates.decode(chunk, count);
+					sink(chunk, count);
+				}
+				return copy.successful();
+			}
+
+			template<typename T, typename callback_t, typename tableName, typename... fields_t>
+				bool selectAsyncModels(driver::pgSQLEventLoop_t &loop, callback_t &&callback,
+				const model_t<tableName, fields_t...> *) noexcept
+			{
+				using select = select_<tableName, fields_t...>;
+				using completion_t = selectCompletion_t<T, typename std::decay<callback_t>::type>;
+				std::unique_ptr<driver::pgSQLCompletion_t> completion
+					{substrate::make_unique_nothrow<completion_t>(std::forward<callback_t>(callback))};
+				auto query{database.queryAsync(select::value)};
+				return completion && loop.add(std::move(query), std::move(completion));
+			}
+
+			template<typename T, typename tableName, typename... fields_t>
+				cursor_t<T> cursorModels(const size_t chunkLength, const model_t<tableName, fields_t...> *) noexcept
+			{
+				using declareCursor = declareCursor_<tableName, fields_t...>;
+				return {database, declareCursor::value, chunkLength};
+			}
+
 		public:
 			session_t() noexcept = default;
 			~session_t() noexcept = default;
@@ -601,26 +1478,24 @@ namespace tmplORM
 			{
 				using select = select_<tableName, fields_t...>;
 				auto result{database.query(select::value)};
-				fixedVector_t<T> data{result.numRows()};
-				if (!data.valid() || !result.hasData())
-					return {};
-				for (size_t i = 0; i < result.numRows(); ++i, result.next())
-				{
-					T value{};
-					if (!result.valid())
-						return {};
-					bindSelect<fields_t...>::bind(value.fields(), result);
-					data[i] = std::move(value);
-				}
-				if (result.valid())
-					return {};
-				return data;
+				return selectModels<T>(result, static_cast<const model_t<tableName, fields_t...> *>(nullptr));
+			}
+
+			// Starts a SELECT of every row of a model's table without waiting on it, calling callback(models) with the
+			// decoded models once the event loop sees it complete. Only one query can be in flight per session, so
+			// use a session per query to run many at once on the same loop.
+			template<typename T, typename callback_t> bool selectAsync(driver::pgSQLEventLoop_t &loop,
+				callback_t &&callback) noexcept
+			{
+				return selectAsyncModels<T>(loop, std::forward<callback_t>(callback),
+					static_cast<const T *>(nullptr));
 			}
 
 			template<typename tableName, typename... fields_t> bool add(model_t<tableName, fields_t...> &model) noexcept
 			{
 				using insert = add_<tableName, fields_t...>;
-				auto query{database.prepare(insert::value, countInsert_t<fields_t...>::count)};
+				auto query{database.prepareNamed(insert::value, countInsert_t<fields_t...>::count,
+					driver::valuesLength_t<fields_t...>::value)};
 				bindInsert<fields_t...>::bind(model.fields(), query);
 				auto result(query.execute());
 				if (result.valid())
@@ -634,7 +1509,8 @@ namespace tmplORM
 			template<typename tableName, typename... fields_t> bool add(const model_t<tableName, fields_t...> &model) noexcept
 			{
 				using insert = addAll_<tableName, fields_t...>;
-				auto query{database.prepare(insert::value, sizeof...(fields_t))};
+				auto query{database.prepareNamed(insert::value, sizeof...(fields_t),
+					driver::valuesLength_t<fields_t...>::value)};
 				// This binds the fields in order so we insert a value for every column.
 				bindInsertAll<fields_t...>::bind(model.fields(), query);
 				// This either works or doesn't.. thankfully.. so, we can just execute-and-quit.
@@ -646,7 +1522,8 @@ namespace tmplORM
 				using update = update_<tableName, fields_t...>;
 				if (std::is_same<update, toString<typestring<>>>::value)
 					return false;
-				auto query{database.prepare(update::value, sizeof...(fields_t))};
+				auto query{database.prepareNamed(update::value, sizeof...(fields_t),
+					driver::valuesLength_t<fields_t...>::value)};
 				// This binds the fields, primary key last so it tags to the WHERE clause for this query.
 				bindUpdate<fields_t...>::bind(model.fields(), query);
 				// This either works or doesn't.. thankfully.. so, we can just execute-and-quit.
@@ -656,7 +1533,8 @@ namespace tmplORM
 			template<typename tableName, typename... fields_t> bool del(const model_t<tableName, fields_t...> &model) noexcept
 			{
 				using del = del_<tableName, fields_t...>;
-				auto query{database.prepare(del::value, countPrimary<fields_t...>::count)};
+				auto query{database.prepareNamed(del::value, countPrimary<fields_t...>::count,
+					driver::valuesLength_t<fields_t...>::value)};
 				// This binds the primary key fields only, in the order they're given in the WHERE clause for this query.
 				bindDelete<fields_t...>::bind(model.fields(), query);
 				// This either works or doesn't.. thankfully.. so, we can just execute-and-quit.
@@ -671,8 +1549,44 @@ namespace tmplORM
 				return result.valid() && result.successful() && result.numRows() == 0;
 			}
 
+			// Bulk loads a range of models in a single binary COPY, leaving auto-increment fields for the database to generate.
+			// If anything goes wrong, the COPY is aborted and none of the models are loaded.
+			template<typename range_t> bool copyIn(const range_t &models) noexcept
+			{
+				using modelPtr_t = decltype(&*std::begin(models));
+				return copyInModels(models, static_cast<modelPtr_t>(nullptr));
+			}
+
+			// Updates every model in a range by primary key in a single statement, sending the values of each field
+			// as one array parameter which the statement unnest()s back into rows to update from
+			template<typename range_t> bool updateAll(const range_t &models) noexcept
+			{
+				using modelPtr_t = decltype(&*std::begin(models));
+				return updateAllModels(models, static_cast<modelPtr_t>(nullptr));
+			}
+
+			// Inserts every model in a range in a single statement as updateAll() does, updating the existing row
+			// instead for any model whose primary key is already in the table
+			template<typename range_t> bool upsertAll(const range_t &models) noexcept
+			{
+				using modelPtr_t = decltype(&*std::begin(models));
+				return upsertAllModels(models, static_cast<modelPtr_t>(nullptr));
+			}
+
+			// Streams every row of a model's table out in a binary COPY, calling sink(chunk, count) with each chunkLength
+			// models decoded. The chunk is reused between calls, so memory use stays flat no matter how big the table is.
+			// String fields point into the COPY's own storage, so are only valid until the sink returns.
+			template<typename T, typename sink_t> bool copyOut(sink_t &&sink, const size_t chunkLength = 1024)
+				{ return copyOutModels<T>(sink, chunkLength, static_cast<const T *>(nullptr)); }
+
+			// Opens a cursor over every row of a model's table that fetches and decodes chunkLength models at a time.
+			// The cursor runs in its own transaction, so this fails if the session is already in one.
+			template<typename T> cursor_t<T> cursor(const size_t chunkLength = 1024) noexcept
+				{ return cursorModels<T>(chunkLength, static_cast<const T *>(nullptr)); }
+
 			bool connect(const char *host, const char *port, const char *user, const char *passwd, const char *db) noexcept
 				{ return database.connect(host, port, user, passwd, db); }
+			batch_t batch() noexcept { return {database}; }
 
 			session_t(const session_t &) = delete;
 			session_t &operator =(const session_t &) = delete;
@@ -66,6 +66,8 @@ namespace tmplORM
 				}
 			};
 		}
+
+		template<typename T> struct unwrapField_t<rSON::jsonNullable_t<T>> : unwrapField_t<T> { };
 	}
 }
 